@@ -28,6 +28,7 @@ class DetectorInfo;
 class IDetector;
 class Instrument;
 class ParameterMap;
+class SolidAngleParams;
 } // namespace Geometry
 namespace API {
 class ExperimentInfo;
@@ -89,6 +90,8 @@ public:
   Kernel::V3D samplePosition() const;
   double l1() const;
 
+  std::vector<double> solidAngles(const Geometry::SolidAngleParams &params) const;
+
   void getDetectorValues(const Kernel::Unit &inputUnit, const Kernel::Unit &outputUnit,
                          const Kernel::DeltaEMode::Type emode, const bool signedTheta, int64_t wsIndex,
                          Kernel::UnitParametersMap &pmap) const;
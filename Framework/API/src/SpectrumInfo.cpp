@@ -9,8 +9,10 @@
 #include "MantidAPI/SpectrumInfoIterator.h"
 #include "MantidBeamline/SpectrumInfo.h"
 #include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/DetectorGroup.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/SolidAngleParams.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MultiThreaded.h"
@@ -326,6 +328,36 @@ Kernel::V3D SpectrumInfo::samplePosition() const { return m_detectorInfo.sampleP
 /// Returns L1 (distance from source to sample).
 double SpectrumInfo::l1() const { return m_detectorInfo.l1(); }
 
+/** Returns the solid angle of each spectrum as seen from an observer, the sum
+ * of the solid angles of its unmasked detectors. Monitors and spectra without
+ * detectors have a solid angle of zero.
+ *
+ * The detectors sharing a shape, e.g. the pixels of a bank, are calculated
+ * together by ComponentInfo::solidAngles, which is much faster than asking
+ * each detector for its solid angle.
+ */
+std::vector<double> SpectrumInfo::solidAngles(const Geometry::SolidAngleParams &params) const {
+  std::vector<size_t> detectorIndices;
+  detectorIndices.reserve(detectorCount());
+  for (size_t i = 0; i < size(); ++i) {
+    for (const auto &detIndex : spectrumDefinition(i)) {
+      if (!m_detectorInfo.isMasked(detIndex) && !m_detectorInfo.isMonitor(detIndex))
+        detectorIndices.emplace_back(detIndex.first);
+    }
+  }
+  const auto detectorSolidAngles = m_experimentInfo.componentInfo().solidAngles(detectorIndices, params);
+
+  std::vector<double> result(size(), 0.0);
+  auto detectorSolidAngle = detectorSolidAngles.cbegin();
+  for (size_t i = 0; i < size(); ++i) {
+    for (const auto &detIndex : spectrumDefinition(i)) {
+      if (!m_detectorInfo.isMasked(detIndex) && !m_detectorInfo.isMonitor(detIndex))
+        result[i] += *detectorSolidAngle++;
+    }
+  }
+  return result;
+}
+
 const Geometry::IDetector &SpectrumInfo::getDetector(const size_t index) const {
   auto thread = static_cast<size_t>(PARALLEL_THREAD_NUMBER);
   if (m_lastIndex[thread] == index)
@@ -14,6 +14,7 @@
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/Detector.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/SolidAngleParams.h"
 #include "MantidKernel/MultiThreaded.h"
 
 #include "MantidFrameworkTestHelpers/FakeObjects.h"
@@ -396,6 +397,37 @@ public:
     spectrumInfo.setMasked(GroupOfDets1And4, true);
   }
 
+  void test_solidAngles() {
+    const auto &spectrumInfo = m_workspace.spectrumInfo();
+    const auto &detectorInfo = m_workspace.detectorInfo();
+    const SolidAngleParams params(spectrumInfo.samplePosition());
+    const auto solidAngles = spectrumInfo.solidAngles(params);
+    TS_ASSERT_EQUALS(solidAngles.size(), 5);
+    // masked
+    TS_ASSERT_EQUALS(solidAngles[0], 0.0);
+    TS_ASSERT_LESS_THAN(0.0, solidAngles[1]);
+    TS_ASSERT_DELTA(solidAngles[1], detectorInfo.detector(1).solidAngle(params), 1e-12);
+    TS_ASSERT_DELTA(solidAngles[2], detectorInfo.detector(2).solidAngle(params), 1e-12);
+    // monitors
+    TS_ASSERT_EQUALS(solidAngles[3], 0.0);
+    TS_ASSERT_EQUALS(solidAngles[4], 0.0);
+  }
+
+  void test_grouped_solidAngles() {
+    const auto &spectrumInfo = m_grouped.spectrumInfo();
+    const auto &detectorInfo = m_grouped.detectorInfo();
+    const SolidAngleParams params(spectrumInfo.samplePosition());
+    const auto solidAngles = spectrumInfo.solidAngles(params);
+    const double solidAngle2 = detectorInfo.detector(1).solidAngle(params);
+    const double solidAngle3 = detectorInfo.detector(2).solidAngle(params);
+    TS_ASSERT_DELTA(solidAngles[GroupOfDets2And3], solidAngle2 + solidAngle3, 1e-12);
+    // Masked detectors and monitors do not count
+    TS_ASSERT_DELTA(solidAngles[GroupOfDets1And2], solidAngle2, 1e-12);
+    TS_ASSERT_EQUALS(solidAngles[GroupOfDets1And4], 0.0);
+    TS_ASSERT_EQUALS(solidAngles[GroupOfDets4And5], 0.0);
+    TS_ASSERT_DELTA(solidAngles[GroupOfAllDets], solidAngle2 + solidAngle3, 1e-12);
+  }
+
   void test_detector() {
     const auto &spectrumInfo = m_workspace.spectrumInfo();
     TS_ASSERT_THROWS_NOTHING(spectrumInfo.detector(0));
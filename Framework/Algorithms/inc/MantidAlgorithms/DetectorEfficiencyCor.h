@@ -10,6 +10,7 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidGeometry/IDetector.h"
+#include "MantidGeometry/Instrument/Parameter.h"
 #include "MantidGeometry/Objects/IObject.h"
 #include "MantidKernel/V3D.h"
 
@@ -113,6 +114,9 @@ private:
   API::MatrixWorkspace_sptr m_outputWS;
   /// points the map that stores additional properties for detectors in that map
   const Geometry::ParameterMap *m_paraMap;
+  /// the gas pressure and wall thickness parameters, by detector index
+  std::vector<Geometry::Parameter_sptr> m_pressures;
+  std::vector<Geometry::Parameter_sptr> m_thicknesses;
 
   /// stores the user selected value for incidient energy of the neutrons
   double m_Ei;
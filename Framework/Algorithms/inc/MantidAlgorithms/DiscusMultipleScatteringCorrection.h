@@ -122,6 +122,8 @@ protected:
   API::MatrixWorkspace_sptr integrateWS(const API::MatrixWorkspace_sptr &ws);
   void getXMinMax(const Mantid::API::MatrixWorkspace &ws, double &xmin, double &xmax) const;
   void prepareSampleBeamGeometry(const API::MatrixWorkspace_sptr &inputWS);
+  ComponentWorkspaceMappings prepareComponentWorkspacesForK(double k,
+                                                            const ComponentWorkspaceMappings &componentWorkspaces);
   const std::shared_ptr<Geometry::CSGObject>
   createCollimatorHexahedronShape(const Kernel::V3D &samplePos, const Mantid::Geometry::DetectorInfo &detectorInfo,
                                   const size_t &histogramIndex);
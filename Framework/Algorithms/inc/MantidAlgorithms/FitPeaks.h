@@ -147,8 +147,12 @@ private:
   /// suites of method to fit peaks
   std::vector<std::shared_ptr<FitPeaksAlgorithm::PeakFitResult>> fitPeaks();
 
+  /// create the Fit algorithm for peak + background fits
+  API::IAlgorithm_sptr createPeakFitter();
+
   /// fit peaks in a same spectrum
   void fitSpectrumPeaks(size_t wi, const std::vector<double> &expected_peak_centers,
+                        const API::IAlgorithm_sptr &peak_fitter,
                         const std::shared_ptr<FitPeaksAlgorithm::PeakFitResult> &fit_result,
                         std::vector<std::vector<double>> &lastGoodPeakParameters,
                         const std::shared_ptr<FitPeaksAlgorithm::PeakFitPreCheckResult> &pre_check_result);
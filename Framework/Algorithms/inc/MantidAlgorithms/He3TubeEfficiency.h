@@ -10,6 +10,7 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAlgorithms/DllConfig.h"
 #include "MantidGeometry/IDTypes.h"
+#include "MantidGeometry/Instrument/Parameter.h"
 #include "MantidKernel/V3D.h"
 
 namespace Mantid {
@@ -82,12 +83,13 @@ private:
   /// Log any errors with spectra that occurred
   void logErrors() const;
   /// Retrieve the detector parameters from workspace or detector properties
-  double getParameter(const std::string &wsPropName, std::size_t currentIndex, const std::string &detPropName,
-                      const Geometry::IDetector &idet);
+  double getParameter(const std::string &wsPropName, std::size_t currentIndex,
+                      const std::vector<Geometry::Parameter_sptr> &detParams, const API::SpectrumInfo &spectrumInfo);
   /// Helper for event handling
   template <class T> void eventHelper(std::vector<T> &events, double expval);
   /// Function to calculate exponential contribution
-  double calculateExponential(std::size_t spectraIndex, const Geometry::IDetector &idet);
+  double calculateExponential(std::size_t spectraIndex, const Geometry::IDetector &idet,
+                              const API::SpectrumInfo &spectrumInfo);
 
   /// The user selected (input) workspace
   API::MatrixWorkspace_const_sptr m_inputWS;
@@ -95,6 +97,10 @@ private:
   API::MatrixWorkspace_sptr m_outputWS;
   /// Map that stores additional properties for detectors
   const Geometry::ParameterMap *m_paraMap;
+  /// The tube parameters of each detector, indexed by detector index
+  std::vector<Geometry::Parameter_sptr> m_pressures;
+  std::vector<Geometry::Parameter_sptr> m_thicknesses;
+  std::vector<Geometry::Parameter_sptr> m_temperatures;
   /// A lookup of previously seen shape objects used to save calculation time as
   /// most detectors have the same shape
   std::map<const Geometry::IObject *, std::pair<double, Kernel::V3D>> m_shapeCache;
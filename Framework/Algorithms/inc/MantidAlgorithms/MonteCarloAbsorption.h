@@ -78,6 +78,14 @@ private:
   API::MatrixWorkspace_uptr createOutputWorkspace(const API::MatrixWorkspace &inputWS) const;
   void interpolateFromSparse(API::MatrixWorkspace &targetWS, const SparseWorkspace &sparseWS,
                              const Mantid::Algorithms::InterpolationOption &interpOpt);
+  bool findCellsToRefine(const API::MatrixWorkspace &inputWS, const SparseWorkspace &sparseWS, const double tolerance,
+                         std::vector<bool> &splitRows, std::vector<bool> &splitColumns) const;
+  SparseWorkspace_sptr refineSparseWorkspace(const API::MatrixWorkspace &inputWS, const SparseWorkspace &sparseWS,
+                                             const size_t wavelengthPoints, const std::vector<bool> &splitRows,
+                                             const std::vector<bool> &splitColumns,
+                                             std::vector<bool> &simulated) const;
+  void reportSimulationsPerRegion(const DetectorGridDefinition &initialGrid,
+                                  const DetectorGridDefinition &finalGrid) const;
 };
 } // namespace Algorithms
 } // namespace Mantid
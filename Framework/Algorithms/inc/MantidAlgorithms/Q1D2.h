@@ -45,6 +45,8 @@ private:
   /// the experimental workspace with counts across the detector
   API::MatrixWorkspace_const_sptr m_dataWS;
   bool m_doSolidAngle;
+  /// the solid angle of each spectrum of m_dataWS, if m_doSolidAngle
+  std::vector<double> m_solidAngles;
 
   /// Initialisation code
   void init() override;
@@ -0,0 +1,51 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidAlgorithms/DllConfig.h"
+
+#include <string>
+
+namespace Mantid {
+namespace API {
+class Algorithm;
+}
+namespace Algorithms {
+
+/**
+  Keeps the attenuation factors calculated by the absorption correction
+  algorithms in memory so that repeating a calculation, as for each run of a
+  temperature series, returns the stored factors.
+
+  The results are identified by their content: the key combines the name and
+  the property values of the algorithm with a hash of everything of the input
+  workspace a correction depends on - the wavelengths, the detector
+  positions, the instrument parameters, the sample and environment shapes and
+  their materials. Changing any of these, e.g. through the Sample or the
+  ParameterMap, gives a new key so stale factors are never returned. Only the
+  last few results are kept.
+*/
+class MANTID_ALGORITHMS_DLL AbsorptionCorrectionCache {
+public:
+  /// Create the key identifying the correction an algorithm calculates
+  static std::string createKey(const API::Algorithm &alg, const API::MatrixWorkspace &inputWS);
+  /// Copy the stored attenuation factors into the output workspace
+  static bool restore(const std::string &key, API::MatrixWorkspace &outputWS);
+  /// Store the attenuation factors of an output workspace
+  static void store(const std::string &key, const API::MatrixWorkspace &outputWS);
+  /// Remove all stored results
+  static void clear();
+  /// Number of stored results
+  static size_t size();
+
+  /// The largest number of results kept
+  static constexpr size_t MAX_ENTRIES = 4;
+};
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -10,17 +10,21 @@
 
 #include <array>
 #include <cstddef>
+#include <utility>
+#include <vector>
 
 namespace Mantid {
 namespace Algorithms {
 
 /** DetectorGridDefinition is a helper class for building the sparse
-  instrument in MonteCarloAbsorption.
+  instrument in MonteCarloAbsorption. The rows and columns of the grid are
+  evenly spaced unless the grid has been refined.
 */
 class MANTID_ALGORITHMS_DLL DetectorGridDefinition {
 public:
   DetectorGridDefinition(const double minLatitude, const double maxLatitude, const size_t latitudePoints,
                          const double minLongitude, const double maxLongitude, const size_t longitudeStep);
+  DetectorGridDefinition(std::vector<double> latitudes, std::vector<double> longitudes);
 
   double latitudeAt(const size_t row) const;
   double longitudeAt(const size_t column) const;
@@ -28,17 +32,14 @@ public:
   std::pair<size_t, size_t> getNearestVertex(const double latitude, const double longitude) const;
   size_t numberColumns() const;
   size_t numberRows() const;
-  size_t getDetectorIndex(size_t row, size_t col);
+  size_t getDetectorIndex(size_t row, size_t col) const;
+  DetectorGridDefinition refined(const std::vector<bool> &splitRows, const std::vector<bool> &splitColumns) const;
 
 private:
-  double m_minLatitude;
-  double m_maxLatitude;
-  size_t m_latitudePoints;
-  double m_latitudeStep;
-  double m_minLongitude;
-  double m_maxLongitude;
-  size_t m_longitudePoints;
-  double m_longitudeStep;
+  /// Latitudes of the rows in ascending order
+  std::vector<double> m_latitudes;
+  /// Longitudes of the columns in ascending order
+  std::vector<double> m_longitudes;
 };
 
 } // namespace Algorithms
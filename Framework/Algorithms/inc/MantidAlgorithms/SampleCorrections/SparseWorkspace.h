@@ -37,8 +37,13 @@ class MANTID_ALGORITHMS_DLL SparseWorkspace : public DataObjects::Workspace2D {
 public:
   SparseWorkspace(const API::MatrixWorkspace &modelWS, const size_t wavelengthPoints, const size_t rows,
                   const size_t columns);
+  SparseWorkspace(const API::MatrixWorkspace &modelWS, const size_t wavelengthPoints,
+                  const DetectorGridDefinition &grid);
   virtual HistogramData::Histogram interpolateFromDetectorGrid(const double lat, const double lon) const;
   virtual HistogramData::Histogram bilinearInterpolateFromDetectorGrid(const double lat, const double lon) const;
+  std::pair<double, double> interpolationErrorEstimate(const size_t row, const size_t column) const;
+  /// The grid of the detectors
+  const DetectorGridDefinition &gridDefinition() const { return *m_gridDef; }
 
 protected:
   SparseWorkspace(const SparseWorkspace &other);
@@ -49,7 +54,13 @@ protected:
   static HistogramData::Histogram modelHistogram(const API::MatrixWorkspace &modelWS, const size_t wavelengthPoints);
   static std::tuple<double, double> extremeWavelengths(const API::MatrixWorkspace &ws);
   static std::tuple<double, double, double, double> extremeAngles(const API::MatrixWorkspace &ws);
+  static DetectorGridDefinition createDetectorGridDefinition(const API::MatrixWorkspace &modelWS, const size_t rows,
+                                                             const size_t columns);
   HistogramData::HistogramY secondDerivative(const std::array<size_t, 3> indices, const double distanceStep) const;
+  HistogramData::HistogramY secondDerivative(const std::array<size_t, 3> indices, const double firstStep,
+                                             const double secondStep) const;
+  double curvatureError(const std::array<size_t, 3> &indices, const std::array<double, 3> &coordinates,
+                        const double intervalSize) const;
   HistogramData::HistogramE esq(const HistogramData::HistogramE &e) const;
   HistogramData::HistogramE esqrt(HistogramData::HistogramE e) const;
 
@@ -10,6 +10,7 @@
 #include "MantidAPI/Sample.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceUnitValidator.h"
+#include "MantidAlgorithms/SampleCorrections/AbsorptionCorrectionCache.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
@@ -112,6 +113,9 @@ void AbsorptionCorrection::init() {
   declareProperty("EFixed", 0.0, mustBePositive,
                   "The value of the initial or final energy, as appropriate, in meV.\n"
                   "Will be taken from the instrument definition file, if available.");
+  declareProperty("UseCorrectionCache", false,
+                  "Reuse the attenuation factors of an earlier calculation with the same inputs, "
+                  "e.g. for the other runs of a temperature series, and keep these for later calculations.");
 
   // Call the virtual method for concrete algorithm to define any other
   // properties
@@ -172,6 +176,14 @@ void AbsorptionCorrection::exec() {
 
   constructSample(correctionFactors->mutableSample());
 
+  const bool useCache = getProperty("UseCorrectionCache");
+  const std::string cacheKey = useCache ? AbsorptionCorrectionCache::createKey(*this, *m_inputWS) : "";
+  if (AbsorptionCorrectionCache::restore(cacheKey, *correctionFactors)) {
+    g_log.information("Using the attenuation factors of an earlier calculation with the same inputs.");
+    setProperty("OutputWorkspace", correctionFactors);
+    return;
+  }
+
   const auto numHists = static_cast<int64_t>(m_inputWS->getNumberHistograms());
   const auto specSize = static_cast<int64_t>(m_inputWS->blocksize());
 
@@ -271,6 +283,7 @@ void AbsorptionCorrection::exec() {
   PARALLEL_CHECK_INTERRUPT_REGION
 
   g_log.information() << "Total number of elements in the integration was " << m_L1s.size() << '\n';
+  AbsorptionCorrectionCache::store(cacheKey, *correctionFactors);
   setProperty("OutputWorkspace", correctionFactors);
 
   // Now do some cleaning-up since destructor may not be called immediately
@@ -8,6 +8,7 @@
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/AnalysisDataService.h"
 #include "MantidAPI/InstrumentDataService.h"
+#include "MantidAlgorithms/SampleCorrections/AbsorptionCorrectionCache.h"
 #include "MantidKernel/UsageService.h"
 #include <Poco/File.h>
 #include <Poco/Glob.h>
@@ -48,6 +49,8 @@ void ClearCache::init() {
   declareProperty("GeometryFileCache", false, "Clears the file cache of the triangulated detector geometries.");
   declareProperty("WorkspaceCache", false, "Clears the memory cache of any workspaces.");
   declareProperty("UsageServiceCache", false, "Clears the memory cache of usage data.");
+  declareProperty("AbsorptionCorrectionCache", false,
+                  "Clears the memory cache of the attenuation factors kept by the absorption corrections.");
   declareProperty("FilesRemoved", 0, "The number of files removed. Memory clearance do not add to this.",
                   Direction::Output);
 }
@@ -63,9 +66,10 @@ void ClearCache::exec() {
   bool clearGeometryFileCache = getProperty("GeometryFileCache");
   bool clearUsageService = getProperty("UsageServiceCache");
   bool clearAnalysisService = getProperty("WorkspaceCache");
+  bool clearAbsorptionCache = getProperty("AbsorptionCorrectionCache");
 
   bool isAnythingSelected = clearAlgCache || clearInstService || clearInstFileCache || clearGeometryFileCache ||
-                            clearUsageService || clearAnalysisService;
+                            clearUsageService || clearAnalysisService || clearAbsorptionCache;
   if (!isAnythingSelected) {
     g_log.warning("Nothing caches to clear.  Nothing done.");
     return;
@@ -109,6 +113,10 @@ void ClearCache::exec() {
     g_log.debug("Emptying the Usage data service (UsageServiceCache).");
     UsageService::Instance().clear();
   }
+  if (clearAbsorptionCache) {
+    g_log.debug("Emptying the absorption correction cache (AbsorptionCorrectionCache).");
+    AbsorptionCorrectionCache::clear();
+  }
   setProperty("FilesRemoved", filesRemoved);
 }
 
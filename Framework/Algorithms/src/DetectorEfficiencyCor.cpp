@@ -119,6 +119,11 @@ void DetectorEfficiencyCor::exec() {
 
   // Store some information about the instrument setup that will not change
   m_samplePos = m_inputWS->getInstrument()->getSample()->getPos();
+  // Look up the parameters of all the detectors together rather than walking
+  // up the component tree for each one inside the loop
+  const auto &componentInfo = m_inputWS->componentInfo();
+  m_pressures = m_paraMap->getRecursiveForAllComponents(componentInfo, PRESSURE_PARAM);
+  m_thicknesses = m_paraMap->getRecursiveForAllComponents(componentInfo, THICKNESS_PARAM);
 
   int64_t numHists = m_inputWS->getNumberHistograms();
   auto numHists_d = static_cast<double>(numHists);
@@ -215,12 +220,12 @@ void DetectorEfficiencyCor::correctForEfficiency(int64_t spectraIn, const Spectr
   for (const auto &index : spectrumDefinition) {
     const auto detIndex = index.first;
     const auto &det_member = detectorInfo.detector(detIndex);
-    Parameter_sptr par = m_paraMap->getRecursive(det_member.getComponentID(), PRESSURE_PARAM);
+    Parameter_sptr par = m_pressures[detIndex];
     if (!par) {
       throw Exception::NotFoundError(PRESSURE_PARAM, spectraIn);
     }
     const double atms = par->value<double>();
-    par = m_paraMap->getRecursive(det_member.getComponentID(), THICKNESS_PARAM);
+    par = m_thicknesses[detIndex];
     if (!par) {
       throw Exception::NotFoundError(THICKNESS_PARAM, spectraIn);
     }
@@ -587,7 +587,9 @@ void DiscusMultipleScatteringCorrection::exec() {
   const auto &spectrumInfo = instrumentWS.spectrumInfo();
   const auto &detectorInfo = instrumentWS.detectorInfo();
 
-  PARALLEL_FOR_IF(enableParallelFor)
+  // The cost of a spectrum varies a lot (masked detectors and monitors are skipped) so hand out the spectra one at a
+  // time. Each spectrum has its own random number sequence so the results don't depend on the number of threads
+  PRAGMA_OMP(parallel for schedule(dynamic, 1) if (enableParallelFor))
   for (int64_t i = 0; i < static_cast<int64_t>(nhists); ++i) { // signed int for openMP loop
     PARALLEL_START_INTERRUPT_REGION
 
@@ -964,6 +966,24 @@ void DiscusMultipleScatteringCorrection::prepareCumulativeProbForQ(
   }
 }
 
+/**
+ * Create a copy of the component workspaces with the cumulative probability distributions for importance sampling
+ * prepared for a new wavenumber. The InvPOfQ workspaces are copied before they are updated because the originals are
+ * shared by all the paths and threads
+ * @param k The wavenumber to prepare the distributions for
+ * @param componentWorkspaces List of workspaces for each material
+ * @return A copy of componentWorkspaces with its own InvPOfQ workspaces prepared for k
+ */
+DiscusMultipleScatteringCorrection::ComponentWorkspaceMappings
+DiscusMultipleScatteringCorrection::prepareComponentWorkspacesForK(
+    double k, const ComponentWorkspaceMappings &componentWorkspaces) {
+  auto newComponentWorkspaces = componentWorkspaces;
+  for (auto &SQWSMapping : newComponentWorkspaces)
+    SQWSMapping.InvPOfQ = SQWSMapping.InvPOfQ->createCopy();
+  prepareCumulativeProbForQ(k, newComponentWorkspaces);
+  return newComponentWorkspaces;
+}
+
 void DiscusMultipleScatteringCorrection::convertToLogWorkspace(const std::shared_ptr<DiscusData2D> &SOfQ) {
   // generate log of the structure factor to support gaussian interpolation
 
@@ -1432,20 +1452,20 @@ std::tuple<bool, std::vector<double>> DiscusMultipleScatteringCorrection::scatte
   std::tie(std::ignore, scatteringXSection) =
       new_vector(shapeObjectWithScatter->material(), kinc, specialSingleScatterCalc);
 
-  auto currentComponentWorkspaces = componentWorkspaces;
+  // the workspaces are only copied when the sampling has to be prepared for a new k. Copying the shared pointers for
+  // every path is slow when the threads all share the same ones
+  const ComponentWorkspaceMappings *currentComponentWorkspaces = &componentWorkspaces;
+  ComponentWorkspaceMappings updatedComponentWorkspaces;
   double k = kinc;
   for (int iScat = 0; iScat < nScatters - 1; iScat++) {
     if ((k != kinc)) {
       if (m_importanceSampling) {
-        auto newComponentWorkspaces = componentWorkspaces;
-        for (auto &SQWSMapping : currentComponentWorkspaces)
-          SQWSMapping.InvPOfQ = SQWSMapping.InvPOfQ->createCopy();
-        prepareCumulativeProbForQ(k, newComponentWorkspaces);
-        currentComponentWorkspaces = std::move(newComponentWorkspaces);
+        updatedComponentWorkspaces = prepareComponentWorkspacesForK(k, componentWorkspaces);
+        currentComponentWorkspaces = &updatedComponentWorkspaces;
       }
     }
     auto trackStillAlive =
-        q_dir(track, shapeObjectWithScatter, currentComponentWorkspaces, k, scatteringXSection, rng, weight);
+        q_dir(track, shapeObjectWithScatter, *currentComponentWorkspaces, k, scatteringXSection, rng, weight);
     if (!trackStillAlive)
       return {true, std::vector<double>(wValues.size(), 0.)};
     int nlinks = m_sampleShape->interceptSurface(track);
@@ -1463,8 +1483,7 @@ std::tuple<bool, std::vector<double>> DiscusMultipleScatteringCorrection::scatte
         new_vector(shapeObjectWithScatter->material(), k, specialSingleScatterCalc);
   }
 
-  bool considerCollimator = getProperty("RadialCollimator");
-  if (considerCollimator) {
+  if (m_collimatorInfo) {
     const auto &samplePos = detectorInfo.samplePosition();
     auto hexahedron = createCollimatorHexahedronShape(samplePos, detectorInfo, histogramIndex);
     // zero the paths if the final scatter point is not inside the collimatorCorridor shape or the collimator shape is
@@ -1492,6 +1511,7 @@ std::tuple<bool, std::vector<double>> DiscusMultipleScatteringCorrection::scatte
   }
   std::vector<double> weights;
   auto scatteringXSectionFull = shapeObjectWithScatter->material().totalScatterXSection();
+  const auto &componentWSMapping = *findMatchingComponent(componentWorkspaces, shapeObjectWithScatter);
   // Step through required overall energy transfer (w) values and work out what
   // w that means for the final scatter. There will be a single w value for elastic
   // Slightly different approach to original DISCUS code. It stepped through the w values
@@ -1506,8 +1526,6 @@ std::tuple<bool, std::vector<double>> DiscusMultipleScatteringCorrection::scatte
       const auto qVector = directionToDetector * kout - prevDirection * k;
       const double q = qVector.norm();
       const double finalW = fromWaveVector(k) - finalE;
-      auto componentWSIt = findMatchingComponent(componentWorkspaces, shapeObjectWithScatter);
-      auto &componentWSMapping = *componentWSIt; // to help debugging
       double SQ = Interpolate2D(componentWSMapping, q, finalW);
       scatteringXSection = m_NormalizeSQ ? scatteringXSection / interpolateFlat(*(componentWSMapping.QSQScaleFactor), k)
                                          : scatteringXSectionFull;
@@ -1673,6 +1691,7 @@ void DiscusMultipleScatteringCorrection::writeToCollimatorCorridorCache(
 
 void DiscusMultipleScatteringCorrection::loadCollimatorInfo() {
   m_collimatorCorridorCache.clear(); // Clear the cache for collimator corridor shapes
+  m_collimatorInfo.reset();
   const bool radialCollimator = getProperty("RadialCollimator");
   if (radialCollimator) {
     m_collimatorInfo = std::make_unique<CollimatorInfo>();
@@ -1777,12 +1796,13 @@ DiscusMultipleScatteringCorrection::sampleQWUniform(const std::vector<double> &w
     iW = 0;
     wRange = 1;
   } else {
-    std::vector<double> wBinEdges;
-    wBinEdges.reserve(wValues.size() + 1);
-    VectorHelper::convertToBinBoundary(wValues, wBinEdges);
+    // outer bin edges as given by VectorHelper::convertToBinBoundary, without building all of them for every scatter
+    const auto n = wValues.size();
+    const double firstEdge = wValues[0] - (0.5 * (wValues[0] + wValues[1]) - wValues[0]);
+    const double lastEdge = wValues[n - 1] + (wValues[n - 1] - 0.5 * (wValues[n - 2] + wValues[n - 1]));
     // w bins not necessarily equal so don't just sample w index
-    wRange = /*std::min(wMax, wBinEdges[iWMax + 1])*/ wBinEdges.back() - wBinEdges.front();
-    double w = wBinEdges.front() + rng.nextValue() * wRange;
+    wRange = /*std::min(wMax, wBinEdges[iWMax + 1])*/ lastEdge - firstEdge;
+    double w = firstEdge + rng.nextValue() * wRange;
     iW = static_cast<int>(Kernel::VectorHelper::indexOfValueFromCentersNoThrow(wValues, w));
   }
   double maxkf = toWaveVector(fromWaveVector(kinc) - wValues.front());
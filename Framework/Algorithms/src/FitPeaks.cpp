@@ -997,6 +997,9 @@ std::vector<std::shared_ptr<FitPeaksAlgorithm::PeakFitResult>> FitPeaks::fitPeak
     std::vector<std::vector<double>> lastGoodPeakParameters(m_numPeaksToFit,
                                                             std::vector<double>(m_peakFunction->nParams(), 0.0));
 
+    // one Fit algorithm serves every spectrum of this thread's chunk
+    IAlgorithm_sptr peak_fitter = createPeakFitter();
+
     for (auto wi = iws_begin; wi < iws_end; ++wi) {
       // peaks to fit
       std::vector<double> expected_peak_centers = m_getExpectedPeakPositions(static_cast<size_t>(wi));
@@ -1009,8 +1012,8 @@ std::vector<std::shared_ptr<FitPeaksAlgorithm::PeakFitResult>> FitPeaks::fitPeak
       std::shared_ptr<FitPeaksAlgorithm::PeakFitPreCheckResult> spectrum_pre_check_result =
           std::make_shared<FitPeaksAlgorithm::PeakFitPreCheckResult>();
 
-      fitSpectrumPeaks(static_cast<size_t>(wi), expected_peak_centers, fit_result, lastGoodPeakParameters,
-                       spectrum_pre_check_result);
+      fitSpectrumPeaks(static_cast<size_t>(wi), expected_peak_centers, peak_fitter, fit_result,
+                       lastGoodPeakParameters, spectrum_pre_check_result);
 
       PARALLEL_CRITICAL(FindPeaks_WriteOutput) {
         writeFitResult(static_cast<size_t>(wi), expected_peak_centers, fit_result);
@@ -1132,10 +1135,36 @@ private:
 };
 } // namespace
 
+//----------------------------------------------------------------------------------------------
+/** Create the Fit algorithm used for peak + background fits. Every call to
+ * fitFunctionSD sets the function, data and range, so the same instance can be
+ * reused for all the spectra fitted by one thread instead of creating and
+ * initializing a new one per spectrum.
+ * @return :: the configured Fit child algorithm
+ */
+API::IAlgorithm_sptr FitPeaks::createPeakFitter() {
+  IAlgorithm_sptr peak_fitter; // both peak and background (combo)
+  try {
+    peak_fitter = createChildAlgorithm("Fit", -1, -1, false);
+  } catch (Exception::NotFoundError &) {
+    std::stringstream errss;
+    errss << "The FitPeak algorithm requires the CurveFitting library";
+    g_log.error(errss.str());
+    throw std::runtime_error(errss.str());
+  }
+
+  // set up properties of algorithm (reference) 'Fit'
+  peak_fitter->setProperty("Minimizer", m_minimizer);
+  peak_fitter->setProperty("CostFunction", m_costFunction);
+  peak_fitter->setProperty("CalcErrors", true);
+  return peak_fitter;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Fit peaks across one single spectrum
  */
 void FitPeaks::fitSpectrumPeaks(size_t wi, const std::vector<double> &expected_peak_centers,
+                                const API::IAlgorithm_sptr &peak_fitter,
                                 const std::shared_ptr<FitPeaksAlgorithm::PeakFitResult> &fit_result,
                                 std::vector<std::vector<double>> &lastGoodPeakParameters,
                                 const std::shared_ptr<FitPeaksAlgorithm::PeakFitPreCheckResult> &pre_check_result) {
@@ -1149,25 +1178,9 @@ void FitPeaks::fitSpectrumPeaks(size_t wi, const std::vector<double> &expected_p
     return;
   }
 
-  // Set up sub algorithm Fit for peak and background
-  IAlgorithm_sptr peak_fitter; // both peak and background (combo)
-  try {
-    peak_fitter = createChildAlgorithm("Fit", -1, -1, false);
-  } catch (Exception::NotFoundError &) {
-    std::stringstream errss;
-    errss << "The FitPeak algorithm requires the CurveFitting library";
-    g_log.error(errss.str());
-    throw std::runtime_error(errss.str());
-  }
-
   // Clone background function
   IBackgroundFunction_sptr bkgdfunction = std::dynamic_pointer_cast<API::IBackgroundFunction>(m_bkgdFunction->clone());
 
-  // set up properties of algorithm (reference) 'Fit'
-  peak_fitter->setProperty("Minimizer", m_minimizer);
-  peak_fitter->setProperty("CostFunction", m_costFunction);
-  peak_fitter->setProperty("CalcErrors", true);
-
   const double x0 = m_inputMatrixWS->histogram(wi).x().front();
   const double xf = m_inputMatrixWS->histogram(wi).x().back();
 
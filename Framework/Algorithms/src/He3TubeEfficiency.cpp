@@ -20,6 +20,7 @@
 #include "MantidKernel/ArrayBoundedValidator.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/CompositeValidator.h"
+#include "MantidTypes/SpectrumDefinition.h"
 
 #include <cmath>
 #include <stdexcept>
@@ -96,6 +97,12 @@ void He3TubeEfficiency::exec() {
 
   // Get the detector parameters
   m_paraMap = &(m_inputWS->constInstrumentParameters());
+  // Look up the parameters of all the detectors together rather than walking
+  // up the component tree for each one inside the loop
+  const auto &componentInfo = m_inputWS->componentInfo();
+  m_pressures = m_paraMap->getRecursiveForAllComponents(componentInfo, "tube_pressure");
+  m_thicknesses = m_paraMap->getRecursiveForAllComponents(componentInfo, "tube_thickness");
+  m_temperatures = m_paraMap->getRecursiveForAllComponents(componentInfo, "tube_temperature");
 
   // Store some information about the instrument setup that will not change
   m_samplePos = m_inputWS->getInstrument()->getSample()->getPos();
@@ -158,7 +165,7 @@ void He3TubeEfficiency::correctForEfficiency(std::size_t spectraIndex, const API
   }
 
   const auto &det = spectrumInfo.detector(spectraIndex);
-  const double exp_constant = this->calculateExponential(spectraIndex, det);
+  const double exp_constant = this->calculateExponential(spectraIndex, det, spectrumInfo);
   const double scale = this->getProperty("ScaleFactor");
 
   const auto &yValues = m_inputWS->y(spectraIndex);
@@ -187,14 +194,16 @@ void He3TubeEfficiency::correctForEfficiency(std::size_t spectraIndex, const API
  * efficiency.
  * @param spectraIndex :: the current index to calculate
  * @param idet :: the current detector pointer
+ * @param spectrumInfo :: the SpectrumInfo object for the workspace
  * @throw out_of_range if twice tube thickness is greater than tube diameter
  * @return the exponential contribution for the given detector
  */
-double He3TubeEfficiency::calculateExponential(std::size_t spectraIndex, const Geometry::IDetector &idet) {
+double He3TubeEfficiency::calculateExponential(std::size_t spectraIndex, const Geometry::IDetector &idet,
+                                               const API::SpectrumInfo &spectrumInfo) {
   // Get the parameters for the current associated tube
-  double pressure = this->getParameter("TubePressure", spectraIndex, "tube_pressure", idet);
-  double tubethickness = this->getParameter("TubeThickness", spectraIndex, "tube_thickness", idet);
-  double temperature = this->getParameter("TubeTemperature", spectraIndex, "tube_temperature", idet);
+  double pressure = this->getParameter("TubePressure", spectraIndex, m_pressures, spectrumInfo);
+  double tubethickness = this->getParameter("TubeThickness", spectraIndex, m_thicknesses, spectrumInfo);
+  double temperature = this->getParameter("TubeTemperature", spectraIndex, m_temperatures, spectrumInfo);
 
   double detRadius(0.0);
   Kernel::V3D detAxis;
@@ -337,16 +346,24 @@ void He3TubeEfficiency::logErrors() const {
  * the associated detector property.
  * @param wsPropName :: the workspace property name for the detector parameter
  * @param currentIndex :: the currently requested spectra index
- * @param detPropName :: the detector property name for the detector parameter
- * @param idet :: the current detector
+ * @param detParams :: the detector parameter of each detector
+ * @param spectrumInfo :: the SpectrumInfo object for the workspace
+ * @throw out_of_range if the spectrum is not a single detector with the
+ * parameter set
  * @return the value of the detector property
  */
 double He3TubeEfficiency::getParameter(const std::string &wsPropName, std::size_t currentIndex,
-                                       const std::string &detPropName, const Geometry::IDetector &idet) {
+                                       const std::vector<Geometry::Parameter_sptr> &detParams,
+                                       const API::SpectrumInfo &spectrumInfo) {
   std::vector<double> wsProp = this->getProperty(wsPropName);
 
   if (wsProp.empty()) {
-    return idet.getNumberParameter(detPropName).at(0);
+    // Grouped detectors have no tube parameters of their own
+    const auto &spectrumDefinition = spectrumInfo.spectrumDefinition(currentIndex);
+    if (spectrumDefinition.size() != 1 || !detParams[spectrumDefinition[0].first]) {
+      throw std::out_of_range("No " + wsPropName + " for spectrum " + std::to_string(currentIndex));
+    }
+    return detParams[spectrumDefinition[0].first]->value<double>();
   } else {
     if (wsProp.size() == 1) {
       return wsProp.at(0);
@@ -387,7 +404,7 @@ void He3TubeEfficiency::execEvent() {
 
     double exp_constant = 0.0;
     try {
-      exp_constant = this->calculateExponential(i, det);
+      exp_constant = this->calculateExponential(i, det, spectrumInfo);
     } catch (std::out_of_range &) {
       // Parameters are bad so skip correction
       PARALLEL_CRITICAL(deteff_invalid) {
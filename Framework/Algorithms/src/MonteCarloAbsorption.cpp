@@ -11,6 +11,7 @@
 #include "MantidAPI/WorkspaceUnitValidator.h"
 #include "MantidAlgorithms/BeamProfileFactory.h"
 #include "MantidAlgorithms/InterpolationOption.h"
+#include "MantidAlgorithms/SampleCorrections/AbsorptionCorrectionCache.h"
 #include "MantidAlgorithms/SampleCorrections/DetectorGridDefinition.h"
 #include "MantidAlgorithms/SampleCorrections/MCInteractionStatistics.h"
 #include "MantidDataObjects/Workspace2D.h"
@@ -27,6 +28,10 @@
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
 using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::Kernel;
@@ -40,6 +45,8 @@ constexpr int DEFAULT_NEVENTS = 1000;
 constexpr int DEFAULT_SEED = 123456789;
 constexpr int DEFAULT_LATITUDINAL_DETS = 5;
 constexpr int DEFAULT_LONGITUDINAL_DETS = 10;
+constexpr double DEFAULT_INTERPOLATION_TOLERANCE = 1e-3;
+constexpr int DEFAULT_MAX_REFINEMENTS = 4;
 
 /// Energy (meV) to wavelength (angstroms)
 inline double toWavelength(double energy) {
@@ -122,6 +129,25 @@ void MonteCarloAbsorption::init() {
                   "of the sparse instrument.");
   setPropertySettings("NumberOfDetectorColumns",
                       std::make_unique<EnabledWhenProperty>("SparseInstrument", ePropertyCriterion::IS_NOT_DEFAULT));
+  declareProperty("AdaptiveSparseInstrument", false,
+                  "Refine the detector grid of the sparse instrument where the estimated "
+                  "interpolation error exceeds InterpolationTolerance, starting from "
+                  "NumberOfDetectorRows x NumberOfDetectorColumns detectors.");
+  setPropertySettings("AdaptiveSparseInstrument",
+                      std::make_unique<EnabledWhenProperty>("SparseInstrument", ePropertyCriterion::IS_NOT_DEFAULT));
+  auto positiveDouble = std::make_shared<Kernel::BoundedValidator<double>>();
+  positiveDouble->setLower(0.0);
+  positiveDouble->setLowerExclusive(true);
+  declareProperty("InterpolationTolerance", DEFAULT_INTERPOLATION_TOLERANCE, positiveDouble,
+                  "The largest acceptable error of the attenuation factors interpolated from "
+                  "the adaptive sparse instrument.");
+  setPropertySettings("InterpolationTolerance", std::make_unique<EnabledWhenProperty>(
+                                                    "AdaptiveSparseInstrument", ePropertyCriterion::IS_NOT_DEFAULT));
+  declareProperty("MaxNumberOfRefinements", DEFAULT_MAX_REFINEMENTS, positiveInt,
+                  "The largest number of times the detector grid of the adaptive sparse "
+                  "instrument is refined.");
+  setPropertySettings("MaxNumberOfRefinements", std::make_unique<EnabledWhenProperty>(
+                                                    "AdaptiveSparseInstrument", ePropertyCriterion::IS_NOT_DEFAULT));
 
   // Control the number of attempts made to generate a random point in the
   // object
@@ -145,6 +171,9 @@ void MonteCarloAbsorption::init() {
                   "Simulate the scattering point in the vicinity of the sample or its "
                   "environment or both (default).",
                   scatteringOptionValidator);
+  declareProperty("UseCorrectionCache", false,
+                  "Reuse the attenuation factors of an earlier calculation with the same inputs, "
+                  "e.g. for the other runs of a temperature series, and keep these for later calculations.");
 }
 
 /**
@@ -152,6 +181,16 @@ void MonteCarloAbsorption::init() {
  */
 void MonteCarloAbsorption::exec() {
   const MatrixWorkspace_sptr inputWS = getProperty("InputWorkspace");
+  const bool useCache = getProperty("UseCorrectionCache");
+  const std::string cacheKey = useCache ? AbsorptionCorrectionCache::createKey(*this, *inputWS) : "";
+  if (!cacheKey.empty()) {
+    MatrixWorkspace_sptr outputWS = createOutputWorkspace(*inputWS);
+    if (AbsorptionCorrectionCache::restore(cacheKey, *outputWS)) {
+      g_log.information("Using the attenuation factors of an earlier calculation with the same inputs.");
+      setProperty("OutputWorkspace", outputWS);
+      return;
+    }
+  }
   const int nevents = getProperty("EventsPerPoint");
   const bool resimulateTracks = getProperty("ResimulateTracksForDifferentWavelengths");
   const int seed = getProperty("SeedValue");
@@ -168,6 +207,7 @@ void MonteCarloAbsorption::exec() {
   }
   auto outputWS = doSimulation(*inputWS, static_cast<size_t>(nevents), resimulateTracks, seed, interpolateOpt,
                                useSparseInstrument, static_cast<size_t>(maxScatterPtAttempts), simulatePointsIn);
+  AbsorptionCorrectionCache::store(cacheKey, *outputWS);
   setProperty("OutputWorkspace", std::move(outputWS));
 }
 
@@ -189,6 +229,17 @@ std::map<std::string, std::string> MonteCarloAbsorption::validateInputs() {
       issues["NumberOfWavelengthPoints"] = nlambdaIssue;
     }
   }
+  const bool adaptiveGrid = getProperty("AdaptiveSparseInstrument");
+  if (adaptiveGrid) {
+    const bool useSparseInstrument = getProperty("SparseInstrument");
+    const int longitudinalDets = getProperty("NumberOfDetectorColumns");
+    if (!useSparseInstrument) {
+      issues["AdaptiveSparseInstrument"] = "The adaptive detector grid requires SparseInstrument.";
+    } else if (longitudinalDets < 3) {
+      issues["NumberOfDetectorColumns"] = "The adaptive detector grid needs at least 3 columns to estimate the "
+                                          "interpolation errors.";
+    }
+  }
   return issues;
 }
 
@@ -295,102 +346,154 @@ MatrixWorkspace_uptr MonteCarloAbsorption::doSimulation(const MatrixWorkspace &i
     nlambda = inputNbins;
   }
   SparseWorkspace_sptr sparseWS;
+  bool adaptiveGrid(false);
+  std::unique_ptr<DetectorGridDefinition> initialGrid;
   if (useSparseInstrument) {
     const int latitudinalDets = getProperty("NumberOfDetectorRows");
     const int longitudinalDets = getProperty("NumberOfDetectorColumns");
     sparseWS = createSparseWorkspace(inputWS, nlambda, latitudinalDets, longitudinalDets);
+    adaptiveGrid = getProperty("AdaptiveSparseInstrument");
+    if (adaptiveGrid) {
+      initialGrid = std::make_unique<DetectorGridDefinition>(sparseWS->gridDefinition());
+    }
   }
-  MatrixWorkspace &simulationWS = useSparseInstrument ? *sparseWS : *outputWS;
-  const MatrixWorkspace &instrumentWS = useSparseInstrument ? simulationWS : inputWS;
-  // Cache information about the workspace that will be used repeatedly
-  auto instrument = instrumentWS.getInstrument();
-  const auto nhists = static_cast<int64_t>(instrumentWS.getNumberHistograms());
+  const double interpolationTolerance = getProperty("InterpolationTolerance");
+  const int maxRefinements = getProperty("MaxNumberOfRefinements");
 
-  EFixedProvider efixed(instrumentWS);
-  auto beamProfile = BeamProfileFactory::createBeamProfile(*instrument, inputWS.sample());
+  // Configure strategy
+  auto interactionVolume = createInteractionVolume(inputWS.sample(), maxScatterPtAttempts, pointsIn);
 
-  // Configure progress
-  Progress prog(this, 0.0, 1.0, nhists);
+  // Configure progress. Each pass of an adaptive grid adds the detectors of
+  // its refined grid.
+  const int numberOfPasses = adaptiveGrid ? maxRefinements + 1 : 1;
+  const auto firstPassHists = static_cast<int64_t>((useSparseInstrument ? *sparseWS : *outputWS).getNumberHistograms());
+  Progress prog(this, 0.0, 1.0, firstPassHists * numberOfPasses);
   prog.setNotifyStep(0.01);
   const std::string reportMsg = "Computing corrections";
+  int64_t stepsDone(0);
+
+  // Flags the detectors of a refined sparse instrument simulated in an earlier pass
+  std::vector<bool> simulated;
+  // Seeds of a pass start after the seeds of all earlier passes so that no
+  // two simulated detectors share a random sequence
+  int seedOffset(0);
+  for (int refinement = 0;; ++refinement) {
+    MatrixWorkspace &simulationWS = useSparseInstrument ? *sparseWS : *outputWS;
+    const MatrixWorkspace &instrumentWS = useSparseInstrument ? simulationWS : inputWS;
+    // Cache information about the workspace that will be used repeatedly
+    auto instrument = instrumentWS.getInstrument();
+    const auto nhists = static_cast<int64_t>(instrumentWS.getNumberHistograms());
+
+    EFixedProvider efixed(instrumentWS);
+    auto beamProfile = BeamProfileFactory::createBeamProfile(*instrument, inputWS.sample());
+
+    if (refinement > 0) {
+      prog.setNumSteps(stepsDone + nhists * (numberOfPasses - refinement));
+    }
 
-  // Configure strategy
-  auto interactionVolume = createInteractionVolume(inputWS.sample(), maxScatterPtAttempts, pointsIn);
-  auto strategy = createStrategy(*interactionVolume, *beamProfile, efixed.emode(), nevents, maxScatterPtAttempts,
-                                 resimulateTracksForDiffWavelengths);
+    auto strategy = createStrategy(*interactionVolume, *beamProfile, efixed.emode(), nevents, maxScatterPtAttempts,
+                                   resimulateTracksForDiffWavelengths);
 
-  const auto &spectrumInfo = simulationWS.spectrumInfo();
+    const auto &spectrumInfo = simulationWS.spectrumInfo();
 
-  PARALLEL_FOR_IF(Kernel::threadSafe(simulationWS))
-  for (int64_t i = 0; i < nhists; ++i) {
-    PARALLEL_START_INTERRUPT_REGION
+    PARALLEL_FOR_IF(Kernel::threadSafe(simulationWS))
+    for (int64_t i = 0; i < nhists; ++i) {
+      PARALLEL_START_INTERRUPT_REGION
 
-    auto &outE = simulationWS.mutableE(i);
-    // The input was cloned so clear the errors out
-    outE = 0.0;
+      if (!simulated.empty() && simulated[static_cast<size_t>(i)]) {
+        prog.report(reportMsg);
+        continue;
+      }
 
-    if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMasked(i)) {
-      continue;
-    }
-    // Per spectrum values
-    const auto &detPos = spectrumInfo.position(i);
-    const double lambdaFixed = toWavelength(efixed.value(spectrumInfo.detector(i).getID()));
-    MersenneTwister rng(seed + int(i));
-
-    const auto lambdas = simulationWS.points(i).rawData();
-
-    const auto nbins = lambdas.size();
-    const size_t lambdaStepSize = nbins / nlambda;
-
-    std::vector<double> packedLambdas;
-    std::vector<double> packedAttFactors;
-    std::vector<double> packedAttFactorErrors;
-
-    for (size_t j = 0; j < nbins; j += lambdaStepSize) {
-      packedLambdas.push_back(lambdas[j]);
-      packedAttFactors.push_back(0);
-      packedAttFactorErrors.push_back(0);
-      // Ensure we have the last point for the interpolation
-      if (lambdaStepSize > 1 && j + lambdaStepSize >= nbins && j + 1 != nbins) {
-        j = nbins - lambdaStepSize - 1;
+      auto &outE = simulationWS.mutableE(i);
+      // The input was cloned so clear the errors out
+      outE = 0.0;
+
+      if (!spectrumInfo.hasDetectors(i) || spectrumInfo.isMasked(i)) {
+        continue;
       }
-    }
-    MCInteractionStatistics detStatistics(spectrumInfo.detector(i).getID(), inputWS.sample());
+      // Per spectrum values
+      const auto &detPos = spectrumInfo.position(i);
+      const double lambdaFixed = toWavelength(efixed.value(spectrumInfo.detector(i).getID()));
+      // For a sparse instrument i is the index col * rows + row of the
+      // detector in the current grid
+      MersenneTwister rng(seed + seedOffset + int(i));
+
+      const auto lambdas = simulationWS.points(i).rawData();
+
+      const auto nbins = lambdas.size();
+      const size_t lambdaStepSize = nbins / nlambda;
+
+      std::vector<double> packedLambdas;
+      std::vector<double> packedAttFactors;
+      std::vector<double> packedAttFactorErrors;
+
+      for (size_t j = 0; j < nbins; j += lambdaStepSize) {
+        packedLambdas.push_back(lambdas[j]);
+        packedAttFactors.push_back(0);
+        packedAttFactorErrors.push_back(0);
+        // Ensure we have the last point for the interpolation
+        if (lambdaStepSize > 1 && j + lambdaStepSize >= nbins && j + 1 != nbins) {
+          j = nbins - lambdaStepSize - 1;
+        }
+      }
+      MCInteractionStatistics detStatistics(spectrumInfo.detector(i).getID(), inputWS.sample());
 
-    strategy->calculate(rng, detPos, packedLambdas, lambdaFixed, packedAttFactors, packedAttFactorErrors,
-                        detStatistics);
+      strategy->calculate(rng, detPos, packedLambdas, lambdaFixed, packedAttFactors, packedAttFactorErrors,
+                          detStatistics);
 
-    if (g_log.is(Kernel::Logger::Priority::PRIO_DEBUG)) {
-      g_log.debug(detStatistics.generateScatterPointStats());
-    }
+      if (g_log.is(Kernel::Logger::Priority::PRIO_DEBUG)) {
+        g_log.debug(detStatistics.generateScatterPointStats());
+      }
 
-    for (size_t j = 0; j < packedLambdas.size(); j++) {
-      auto idx = simulationWS.yIndexOfX(packedLambdas[j], i);
-      simulationWS.getSpectrum(i).dataY()[idx] = packedAttFactors[j];
-      simulationWS.getSpectrum(i).dataE()[idx] = packedAttFactorErrors[j];
-    }
+      for (size_t j = 0; j < packedLambdas.size(); j++) {
+        auto idx = simulationWS.yIndexOfX(packedLambdas[j], i);
+        simulationWS.getSpectrum(i).dataY()[idx] = packedAttFactors[j];
+        simulationWS.getSpectrum(i).dataE()[idx] = packedAttFactorErrors[j];
+      }
 
-    // Interpolate through points not simulated. Simulation WS only has
-    // reduced X values if using sparse instrument so no interpolation required
+      // Interpolate through points not simulated. Simulation WS only has
+      // reduced X values if using sparse instrument so no interpolation required
 
-    if (!useSparseInstrument && lambdaStepSize > 1) {
-      auto histnew = simulationWS.histogram(i);
+      if (!useSparseInstrument && lambdaStepSize > 1) {
+        auto histnew = simulationWS.histogram(i);
 
-      if (lambdaStepSize < nbins) {
-        interpolateOpt.applyInplace(histnew, lambdaStepSize);
-      } else {
-        std::fill(histnew.mutableY().begin() + 1, histnew.mutableY().end(), histnew.y()[0]);
+        if (lambdaStepSize < nbins) {
+          interpolateOpt.applyInplace(histnew, lambdaStepSize);
+        } else {
+          std::fill(histnew.mutableY().begin() + 1, histnew.mutableY().end(), histnew.y()[0]);
+        }
+        outputWS->setHistogram(i, histnew);
       }
-      outputWS->setHistogram(i, histnew);
-    }
 
-    prog.report(reportMsg);
+      prog.report(reportMsg);
 
-    PARALLEL_END_INTERRUPT_REGION
+      PARALLEL_END_INTERRUPT_REGION
+    }
+    PARALLEL_CHECK_INTERRUPT_REGION
+    stepsDone += nhists;
+    seedOffset += static_cast<int>(nhists);
+
+    if (!adaptiveGrid) {
+      break;
+    }
+    std::vector<bool> splitRows, splitColumns;
+    if (!findCellsToRefine(inputWS, *sparseWS, interpolationTolerance, splitRows, splitColumns)) {
+      break;
+    }
+    if (refinement == maxRefinements) {
+      g_log.warning() << "The interpolation errors of the sparse instrument still exceed InterpolationTolerance after "
+                      << maxRefinements << " refinements of the detector grid.\n";
+      break;
+    }
+    sparseWS =
+        refineSparseWorkspace(inputWS, *sparseWS, static_cast<size_t>(nlambda), splitRows, splitColumns, simulated);
   }
-  PARALLEL_CHECK_INTERRUPT_REGION
 
   if (useSparseInstrument) {
+    if (adaptiveGrid) {
+      reportSimulationsPerRegion(*initialGrid, sparseWS->gridDefinition());
+    }
     interpolateFromSparse(*outputWS, *sparseWS, interpolateOpt);
   }
 
@@ -430,4 +533,141 @@ void MonteCarloAbsorption::interpolateFromSparse(MatrixWorkspace &targetWS, cons
   }
   PARALLEL_CHECK_INTERRUPT_REGION
 }
+
+/**
+ * Find the cells of the detector grid of an adaptive sparse instrument where
+ * the estimated interpolation error exceeds the tolerance. Only the cells
+ * holding detectors of the input workspace are considered.
+ * @param inputWS The workspace the sparse instrument approximates
+ * @param sparseWS The simulated sparse instrument
+ * @param tolerance The largest acceptable interpolation error
+ * @param splitRows Flags the intervals between the rows to refine
+ * @param splitColumns Flags the intervals between the columns to refine
+ * @return true if any cell has to be refined
+ */
+bool MonteCarloAbsorption::findCellsToRefine(const MatrixWorkspace &inputWS, const SparseWorkspace &sparseWS,
+                                             const double tolerance, std::vector<bool> &splitRows,
+                                             std::vector<bool> &splitColumns) const {
+  const auto &grid = sparseWS.gridDefinition();
+  const auto rows = grid.numberRows();
+  const auto columns = grid.numberColumns();
+  std::vector<bool> cellHasDetectors((rows - 1) * (columns - 1), false);
+  const auto &spectrumInfo = inputWS.spectrumInfo();
+  for (size_t i = 0; i < spectrumInfo.size(); ++i) {
+    if (spectrumInfo.hasDetectors(i) && !spectrumInfo.isMasked(i)) {
+      double lat, lon;
+      std::tie(lat, lon) = spectrumInfo.geographicalAngles(i);
+      const auto cell = grid.getNearestVertex(lat, lon);
+      cellHasDetectors[cell.second * (rows - 1) + cell.first] = true;
+    }
+  }
+
+  splitRows.assign(rows - 1, false);
+  splitColumns.assign(columns - 1, false);
+  size_t cellsAboveTolerance(0);
+  for (size_t column = 0; column < columns - 1; ++column) {
+    for (size_t row = 0; row < rows - 1; ++row) {
+      if (!cellHasDetectors[column * (rows - 1) + row]) {
+        continue;
+      }
+      const auto errors = sparseWS.interpolationErrorEstimate(row, column);
+      if (errors.first + errors.second <= tolerance) {
+        continue;
+      }
+      ++cellsAboveTolerance;
+      // Refine along the direction(s) contributing most of the error
+      if (errors.first >= 0.5 * tolerance) {
+        splitRows[row] = true;
+      }
+      if (errors.second >= 0.5 * tolerance) {
+        splitColumns[column] = true;
+      }
+    }
+  }
+  g_log.information() << cellsAboveTolerance << " of the "
+                      << std::count(cellHasDetectors.cbegin(), cellHasDetectors.cend(), true) << " cells of the "
+                      << rows << "x" << columns << " detector grid exceed the interpolation tolerance.\n";
+  return cellsAboveTolerance > 0;
+}
+
+/**
+ * Create a sparse instrument on a refined detector grid. The results of the
+ * detectors on the rows and columns of the previous grid are copied over.
+ * @param inputWS The workspace the sparse instrument approximates
+ * @param sparseWS The simulated sparse instrument
+ * @param wavelengthPoints Number of points in the histograms
+ * @param splitRows Flags the intervals between the rows to refine
+ * @param splitColumns Flags the intervals between the columns to refine
+ * @param simulated Set to flag the detectors of the new instrument which hold
+ * results already
+ * @return The refined sparse instrument
+ */
+SparseWorkspace_sptr MonteCarloAbsorption::refineSparseWorkspace(const MatrixWorkspace &inputWS,
+                                                                 const SparseWorkspace &sparseWS,
+                                                                 const size_t wavelengthPoints,
+                                                                 const std::vector<bool> &splitRows,
+                                                                 const std::vector<bool> &splitColumns,
+                                                                 std::vector<bool> &simulated) const {
+  const auto &grid = sparseWS.gridDefinition();
+  auto refinedWS =
+      std::make_shared<SparseWorkspace>(inputWS, wavelengthPoints, grid.refined(splitRows, splitColumns));
+  const auto &refinedGrid = refinedWS->gridDefinition();
+  // Position of each old row or column in the refined grid
+  const auto refinedIndices = [](const std::vector<bool> &split) {
+    std::vector<size_t> indices(split.size() + 1);
+    size_t index(0);
+    for (size_t i = 0; i < indices.size(); ++i) {
+      indices[i] = index;
+      index += (i < split.size() && split[i]) ? 2 : 1;
+    }
+    return indices;
+  };
+  const auto rowIndices = refinedIndices(splitRows);
+  const auto columnIndices = refinedIndices(splitColumns);
+
+  simulated.assign(refinedWS->getNumberHistograms(), false);
+  for (size_t column = 0; column < columnIndices.size(); ++column) {
+    for (size_t row = 0; row < rowIndices.size(); ++row) {
+      const auto index = grid.getDetectorIndex(row, column);
+      const auto refinedIndex = refinedGrid.getDetectorIndex(rowIndices[row], columnIndices[column]);
+      refinedWS->setSharedY(refinedIndex, sparseWS.sharedY(index));
+      refinedWS->setSharedE(refinedIndex, sparseWS.sharedE(index));
+      simulated[refinedIndex] = true;
+    }
+  }
+  g_log.information() << "Refined the detector grid of the sparse instrument to " << refinedGrid.numberRows() << "x"
+                      << refinedGrid.numberColumns() << " detectors, "
+                      << std::count(simulated.cbegin(), simulated.cend(), false) << " of them to simulate.\n";
+  return refinedWS;
+}
+
+/**
+ * Report the number of detectors simulated for the adaptive sparse instrument
+ * in each cell of the initial detector grid.
+ * @param initialGrid The grid before any refinement
+ * @param finalGrid The grid after the last refinement
+ */
+void MonteCarloAbsorption::reportSimulationsPerRegion(const DetectorGridDefinition &initialGrid,
+                                                      const DetectorGridDefinition &finalGrid) const {
+  // The grids are rectangular so the rows and columns can be counted separately
+  std::vector<size_t> rowsPerRegion(initialGrid.numberRows() - 1, 0);
+  for (size_t row = 0; row < finalGrid.numberRows(); ++row) {
+    ++rowsPerRegion[initialGrid.getNearestVertex(finalGrid.latitudeAt(row), initialGrid.longitudeAt(0)).first];
+  }
+  std::vector<size_t> columnsPerRegion(initialGrid.numberColumns() - 1, 0);
+  for (size_t column = 0; column < finalGrid.numberColumns(); ++column) {
+    ++columnsPerRegion[initialGrid.getNearestVertex(initialGrid.latitudeAt(0), finalGrid.longitudeAt(column)).second];
+  }
+  std::ostringstream report;
+  report << "Simulated " << finalGrid.numberRows() * finalGrid.numberColumns() << " detectors on a "
+         << finalGrid.numberRows() << "x" << finalGrid.numberColumns()
+         << " grid. Detectors in each cell of the initial grid (latitude down, longitude across):\n";
+  for (const auto rowCount : rowsPerRegion) {
+    for (const auto columnCount : columnsPerRegion) {
+      report << std::setw(6) << rowCount * columnCount;
+    }
+    report << '\n';
+  }
+  g_log.notice(report.str());
+}
 } // namespace Mantid::Algorithms
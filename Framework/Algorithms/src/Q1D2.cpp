@@ -22,6 +22,7 @@
 #include "MantidDataObjects/WorkspaceCreation.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/SolidAngleParams.h"
 #include "MantidIndexing/IndexInfo.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/BoundedValidator.h"
@@ -124,6 +125,12 @@ void Q1D2::exec() {
   helper.examineInput(m_dataWS, waveAdj, pixelAdj, qResolution);
   // FIXME: how to examine the wavePixelAdj?
   g_log.debug() << "All input workspaces were found to be valid\n";
+  // the solid angles of all the spectra are calculated together as the
+  // detectors sharing a shape only need it triangulated once
+  if (m_doSolidAngle) {
+    const auto &spectrumInfo = m_dataWS->spectrumInfo();
+    m_solidAngles = spectrumInfo.solidAngles(Geometry::SolidAngleParams(spectrumInfo.samplePosition()));
+  }
   // normalization as a function of wavelength (i.e. centers of x-value bins)
   double const *const binNorms = waveAdj ? &(waveAdj->y(0)[0]) : nullptr;
   // error on the wavelength normalization
@@ -374,17 +381,9 @@ void Q1D2::calculateNormalization(const size_t wavStart, const size_t wsIndex,
  */
 void Q1D2::pixelWeight(const API::MatrixWorkspace_const_sptr &pixelAdj, const size_t wsIndex, double &weight,
                        double &error) const {
-  const auto &detectorInfo = m_dataWS->detectorInfo();
-  const V3D samplePos = detectorInfo.samplePosition();
-
-  if (m_doSolidAngle) {
-    weight = 0.0;
-    for (const auto detID : m_dataWS->getSpectrum(wsIndex).getDetectorIDs()) {
-      const auto index = detectorInfo.indexOf(detID);
-      if (!detectorInfo.isMasked(index))
-        weight += detectorInfo.detector(index).solidAngle(samplePos);
-    }
-  } else
+  if (m_doSolidAngle)
+    weight = m_solidAngles[wsIndex];
+  else
     weight = 1.0;
 
   if (weight < 1e-200) {
@@ -16,6 +16,7 @@
 #include "MantidAlgorithms/Qhelper.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/SolidAngleParams.h"
 #include "MantidHistogramData/LinearGenerator.h"
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/CompositeValidator.h"
@@ -117,11 +118,15 @@ void Qxy::exec() {
   Progress prog(this, 0.05, 1.0, numSpec);
 
   const auto &spectrumInfo = inputWorkspace->spectrumInfo();
-  const auto &detectorInfo = inputWorkspace->detectorInfo();
 
   // the samplePos is often not (0, 0, 0) because the instruments components are
   // moved to account for the beam centre
   const V3D samplePos = spectrumInfo.samplePosition();
+  // the solid angle of the detectors as seen by the sample is used for
+  // normalisation later on
+  std::vector<double> solidAngles;
+  if (doSolidAngle)
+    solidAngles = spectrumInfo.solidAngles(Geometry::SolidAngleParams(samplePos));
 
   for (int64_t i = 0; i < int64_t(numSpec); ++i) {
     if (!spectrumInfo.hasDetectors(i)) {
@@ -158,14 +163,7 @@ void Qxy::exec() {
 
     const auto &axis = outputWorkspace->x(0);
 
-    // the solid angle of the detector as seen by the sample is used for
-    // normalisation later on
-    double angle = 0.0;
-    for (const auto detID : inputWorkspace->getSpectrum(i).getDetectorIDs()) {
-      const auto index = detectorInfo.indexOf(detID);
-      if (!detectorInfo.isMasked(index))
-        angle += detectorInfo.detector(index).solidAngle(samplePos);
-    }
+    const double angle = doSolidAngle ? solidAngles[i] : 0.0;
 
     // some bins are masked completely or partially, the following vector will
     // contain the fractions
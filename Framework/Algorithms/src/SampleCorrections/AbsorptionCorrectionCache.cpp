@@ -0,0 +1,225 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAlgorithms/SampleCorrections/AbsorptionCorrectionCache.h"
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAPI/Sample.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/Container.h"
+#include "MantidGeometry/Instrument/ParameterMap.h"
+#include "MantidGeometry/Instrument/SampleEnvironment.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/MeshObject.h"
+#include "MantidKernel/DeltaEMode.h"
+#include "MantidKernel/Material.h"
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <array>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+using namespace Mantid::API;
+using namespace Mantid::Geometry;
+using namespace Mantid::Kernel;
+
+namespace {
+
+/// Wavelengths (Angstroms) at which the attenuation of the materials is compared
+constexpr std::array<double, 8> HASHED_WAVELENGTHS = {0.1, 0.5, 1.0, 1.798, 3.0, 5.0, 10.0, 20.0};
+
+/// Stored results, the most recently used first
+std::list<std::pair<std::string, MatrixWorkspace_const_sptr>> g_entries;
+std::mutex g_entriesMutex;
+
+void hashV3D(std::size_t &seed, const V3D &vector) {
+  boost::hash_combine(seed, vector.X());
+  boost::hash_combine(seed, vector.Y());
+  boost::hash_combine(seed, vector.Z());
+}
+
+void hashMaterial(std::size_t &seed, const Material &material) {
+  boost::hash_combine(seed, material.name());
+  boost::hash_combine(seed, material.numberDensity());
+  boost::hash_combine(seed, material.packingFraction());
+  boost::hash_combine(seed, material.totalScatterXSection());
+  // includes the absorption and any attenuation profile
+  for (const auto lambda : HASHED_WAVELENGTHS)
+    boost::hash_combine(seed, material.attenuationCoefficient(lambda));
+}
+
+/**
+ * Add a shape and its material to the hash
+ * @return false if the shape is defined but cannot be identified by its
+ * contents
+ */
+bool hashShape(std::size_t &seed, const IObject &object) {
+  const IObject *shape = &object;
+  if (const auto *container = dynamic_cast<const Container *>(shape))
+    shape = &container->getShape();
+  if (!shape->hasValidShape()) {
+    // e.g. a sample defined by the properties of the algorithm
+    boost::hash_combine(seed, std::string("undefined shape"));
+  } else if (const auto *csgShape = dynamic_cast<const CSGObject *>(shape)) {
+    const auto xml = csgShape->getShapeXML();
+    if (xml.empty())
+      return false;
+    boost::hash_combine(seed, xml);
+  } else if (const auto *meshShape = dynamic_cast<const MeshObject *>(shape)) {
+    for (const auto &vertex : meshShape->getV3Ds())
+      hashV3D(seed, vertex);
+    for (const auto index : meshShape->getTriangles())
+      boost::hash_combine(seed, index);
+  } else {
+    return false;
+  }
+  hashMaterial(seed, object.material());
+  return true;
+}
+
+/**
+ * Hash everything of a workspace an absorption correction depends on
+ * @return false if the workspace cannot be identified by its contents
+ */
+bool hashWorkspace(std::size_t &seed, const MatrixWorkspace &ws) {
+  // sample and environment
+  const auto &sample = ws.sample();
+  if (!hashShape(seed, sample.getShape()))
+    return false;
+  if (sample.hasEnvironment()) {
+    const auto &environment = sample.getEnvironment();
+    boost::hash_combine(seed, environment.name());
+    for (size_t i = 0; i < environment.nelements(); ++i) {
+      if (!hashShape(seed, environment.getComponent(i)))
+        return false;
+    }
+  }
+
+  // instrument
+  const auto instrument = ws.getInstrument();
+  boost::hash_combine(seed, instrument->getName());
+  boost::hash_combine(seed, ws.constInstrumentParameters().asString());
+  if (instrument->getSource())
+    hashV3D(seed, instrument->getSource()->getPos());
+  if (instrument->getSample())
+    hashV3D(seed, instrument->getSample()->getPos());
+  const auto emode = ws.getEMode();
+  boost::hash_combine(seed, static_cast<int>(emode));
+  if (emode == DeltaEMode::Direct) {
+    try {
+      boost::hash_combine(seed, ws.getEFixed());
+    } catch (std::exception &) {
+      // the algorithm reports the missing value
+    }
+  }
+
+  // spectra
+  const auto &spectrumInfo = ws.spectrumInfo();
+  boost::hash_combine(seed, ws.getNumberHistograms());
+  boost::hash_combine(seed, ws.isHistogramData());
+  for (size_t i = 0; i < ws.getNumberHistograms(); ++i) {
+    const auto &x = ws.x(i);
+    boost::hash_range(seed, x.cbegin(), x.cend());
+    const bool hasDetectors = spectrumInfo.hasDetectors(i);
+    boost::hash_combine(seed, hasDetectors);
+    if (hasDetectors) {
+      boost::hash_combine(seed, spectrumInfo.isMasked(i));
+      boost::hash_combine(seed, spectrumInfo.detector(i).getID());
+      hashV3D(seed, spectrumInfo.position(i));
+    }
+  }
+  return true;
+}
+} // namespace
+
+namespace Mantid::Algorithms {
+
+/**
+ * Create the key identifying the correction calculated by an algorithm
+ * @param alg :: the algorithm, with all its properties set
+ * @param inputWS :: the workspace the correction is calculated for
+ * @return the key, or an empty string if the inputs cannot be identified by
+ * their contents (e.g. a shape without a definition) so must not be cached
+ */
+std::string AbsorptionCorrectionCache::createKey(const Algorithm &alg, const MatrixWorkspace &inputWS) {
+  std::size_t seed(0);
+  if (!hashWorkspace(seed, inputWS))
+    return "";
+  std::ostringstream key;
+  key << alg.name() << "-v" << alg.version();
+  for (const auto *property : alg.getProperties()) {
+    if (dynamic_cast<const IWorkspaceProperty *>(property))
+      continue;
+    key << ';' << property->name() << '=' << property->value();
+  }
+  key << ";Input=" << std::hex << seed;
+  return key.str();
+}
+
+/**
+ * Copy the stored attenuation factors and their errors into a workspace. The
+ * data are shared with the stored workspace until either is modified.
+ * @param key :: the key of the result
+ * @param outputWS :: a workspace with the same structure as the one stored
+ * @return true if a result was found for the key
+ */
+bool AbsorptionCorrectionCache::restore(const std::string &key, MatrixWorkspace &outputWS) {
+  if (key.empty())
+    return false;
+  MatrixWorkspace_const_sptr stored;
+  {
+    std::lock_guard<std::mutex> lock(g_entriesMutex);
+    const auto entry = std::find_if(g_entries.begin(), g_entries.end(),
+                                    [&key](const auto &storedEntry) { return storedEntry.first == key; });
+    if (entry == g_entries.end())
+      return false;
+    // most recently used first
+    g_entries.splice(g_entries.begin(), g_entries, entry);
+    stored = entry->second;
+  }
+  if (stored->getNumberHistograms() != outputWS.getNumberHistograms())
+    return false;
+  for (size_t i = 0; i < outputWS.getNumberHistograms(); ++i) {
+    outputWS.setSharedY(i, stored->sharedY(i));
+    outputWS.setSharedE(i, stored->sharedE(i));
+  }
+  return true;
+}
+
+/**
+ * Store the attenuation factors of a workspace, dropping the least recently
+ * used result if MAX_ENTRIES are already stored
+ * @param key :: the key of the result
+ * @param outputWS :: the workspace of attenuation factors
+ */
+void AbsorptionCorrectionCache::store(const std::string &key, const MatrixWorkspace &outputWS) {
+  if (key.empty())
+    return;
+  MatrixWorkspace_const_sptr stored = outputWS.clone();
+  std::lock_guard<std::mutex> lock(g_entriesMutex);
+  g_entries.remove_if([&key](const auto &storedEntry) { return storedEntry.first == key; });
+  g_entries.emplace_front(key, std::move(stored));
+  if (g_entries.size() > MAX_ENTRIES)
+    g_entries.pop_back();
+}
+
+void AbsorptionCorrectionCache::clear() {
+  std::lock_guard<std::mutex> lock(g_entriesMutex);
+  g_entries.clear();
+}
+
+size_t AbsorptionCorrectionCache::size() {
+  std::lock_guard<std::mutex> lock(g_entriesMutex);
+  return g_entries.size();
+}
+
+} // namespace Mantid::Algorithms
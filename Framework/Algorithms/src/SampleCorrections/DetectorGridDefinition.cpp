@@ -6,9 +6,50 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidAlgorithms/SampleCorrections/DetectorGridDefinition.h"
 
+#include <algorithm>
 #include <cmath>
+#include <functional>
+#include <iterator>
 #include <stdexcept>
 
+namespace {
+/** Return the index of the interval of a grid axis containing a point.
+ *  Points outside the axis belong to the first or last interval.
+ *  @param points Positions of the grid lines in ascending order.
+ *  @param x A point.
+ *  @return The index of the grid line at the start of the interval.
+ */
+size_t intervalIndex(const std::vector<double> &points, const double x) {
+  const auto upper = std::upper_bound(points.cbegin(), points.cend(), x);
+  if (upper == points.cbegin()) {
+    return 0;
+  }
+  return std::min(static_cast<size_t>(std::distance(points.cbegin(), upper)) - 1, points.size() - 2);
+}
+
+/** Return the positions of grid lines with new lines inserted in the middle
+ *  of the chosen intervals.
+ *  @param points Positions of the grid lines.
+ *  @param split Flags for each interval between the lines.
+ *  @return The refined grid lines.
+ */
+std::vector<double> splitIntervals(const std::vector<double> &points, const std::vector<bool> &split) {
+  if (split.size() != points.size() - 1) {
+    throw std::invalid_argument("DetectorGridDefinition::refined: a flag is needed for each interval of the grid.");
+  }
+  std::vector<double> refinedPoints;
+  refinedPoints.reserve(2 * points.size());
+  for (size_t i = 0; i < split.size(); ++i) {
+    refinedPoints.emplace_back(points[i]);
+    if (split[i]) {
+      refinedPoints.emplace_back(0.5 * (points[i] + points[i + 1]));
+    }
+  }
+  refinedPoints.emplace_back(points.back());
+  return refinedPoints;
+}
+} // namespace
+
 namespace Mantid::Algorithms {
 
 /** Initializes a DetectorGridDefinition object.
@@ -22,44 +63,66 @@ namespace Mantid::Algorithms {
  */
 DetectorGridDefinition::DetectorGridDefinition(const double minLatitude, const double maxLatitude,
                                                const size_t latitudePoints, const double minLongitude,
-                                               const double maxLongitude, const size_t longitudePoints)
-    : m_minLatitude(minLatitude), m_maxLatitude(maxLatitude), m_latitudePoints(latitudePoints),
-      m_minLongitude(minLongitude), m_maxLongitude(maxLongitude), m_longitudePoints(longitudePoints) {
+                                               const double maxLongitude, const size_t longitudePoints) {
   // prevent pointless edge case to simplify interpolation code
   if (latitudePoints < 2 || longitudePoints < 2 || minLatitude > maxLatitude || minLongitude > maxLongitude) {
     throw std::runtime_error("Invalid detector grid definition.");
   }
+  double minLat = minLatitude;
+  double maxLat = maxLatitude;
+  double minLong = minLongitude;
+  double maxLong = maxLongitude;
   // The angular ranges might be zero in some cases preventing
   // the spawning of a real grid. We want to avoid this.
   const double tiny = 1e-5;
   const double smallShift = M_PI / 300.0;
-  if (std::abs(m_minLatitude - m_maxLatitude) < tiny) {
-    m_minLatitude -= smallShift;
-    m_maxLatitude += smallShift;
+  if (std::abs(minLat - maxLat) < tiny) {
+    minLat -= smallShift;
+    maxLat += smallShift;
+  }
+  if (std::abs(minLong - maxLong) < tiny) {
+    minLong -= smallShift;
+    maxLong += smallShift;
   }
-  if (std::abs(m_minLongitude - m_maxLongitude) < tiny) {
-    m_minLongitude -= smallShift;
-    m_maxLongitude += smallShift;
+  const double latitudeStep = (maxLat - minLat) / static_cast<double>(latitudePoints - 1);
+  m_latitudes.resize(latitudePoints);
+  for (size_t row = 0; row < latitudePoints; ++row) {
+    m_latitudes[row] = minLat + static_cast<double>(row) * latitudeStep;
+  }
+  const double longitudeStep = (maxLong - minLong) / static_cast<double>(longitudePoints - 1);
+  m_longitudes.resize(longitudePoints);
+  for (size_t column = 0; column < longitudePoints; ++column) {
+    m_longitudes[column] = minLong + static_cast<double>(column) * longitudeStep;
+  }
+}
+
+/** Initializes a DetectorGridDefinition object with arbitrarily spaced rows
+ *  and columns.
+ *  @param latitudes Latitudes of the rows in ascending order.
+ *  @param longitudes Longitudes of the columns in ascending order.
+ *  @throw std::runtime_error If invalid parameters are given
+ */
+DetectorGridDefinition::DetectorGridDefinition(std::vector<double> latitudes, std::vector<double> longitudes)
+    : m_latitudes(std::move(latitudes)), m_longitudes(std::move(longitudes)) {
+  const auto ascending = [](const std::vector<double> &points) {
+    return std::adjacent_find(points.cbegin(), points.cend(), std::greater_equal<double>()) == points.cend();
+  };
+  if (m_latitudes.size() < 2 || m_longitudes.size() < 2 || !ascending(m_latitudes) || !ascending(m_longitudes)) {
+    throw std::runtime_error("Invalid detector grid definition.");
   }
-  m_latitudeStep = (m_maxLatitude - m_minLatitude) / static_cast<double>(m_latitudePoints - 1);
-  m_longitudeStep = (m_maxLongitude - m_minLongitude) / static_cast<double>(m_longitudePoints - 1);
 }
 
 /** Return the latitude of the given row.
  *  @param row Number of a row.
  *  @return A latitude.
  */
-double DetectorGridDefinition::latitudeAt(const size_t row) const {
-  return m_minLatitude + static_cast<double>(row) * m_latitudeStep;
-}
+double DetectorGridDefinition::latitudeAt(const size_t row) const { return m_latitudes[row]; }
 
 /** Return the longitude of the given column.
  *  @param column Number of a column.
  *  @return A longitude.
  */
-double DetectorGridDefinition::longitudeAt(const size_t column) const {
-  return m_minLongitude + static_cast<double>(column) * m_longitudeStep;
-}
+double DetectorGridDefinition::longitudeAt(const size_t column) const { return m_longitudes[column]; }
 
 /** Return the indices to detector surrounding the given point.
  *  @param latitude Latitude of a point.
@@ -68,19 +131,13 @@ double DetectorGridDefinition::longitudeAt(const size_t column) const {
  */
 std::array<size_t, 4> DetectorGridDefinition::nearestNeighbourIndices(const double latitude,
                                                                       const double longitude) const {
-  auto row = static_cast<size_t>((latitude - m_minLatitude) / m_latitudeStep);
-  // Check for points at the edges or outside the grid.
-  if (row == m_latitudePoints - 1) {
-    --row;
-  }
-  auto col = static_cast<size_t>((longitude - m_minLongitude) / m_longitudeStep);
-  if (col == m_longitudePoints - 1) {
-    --col;
-  }
+  const auto row = intervalIndex(m_latitudes, latitude);
+  const auto col = intervalIndex(m_longitudes, longitude);
+  const auto latitudePoints = m_latitudes.size();
   std::array<size_t, 4> is;
-  std::get<0>(is) = col * m_latitudePoints + row;
+  std::get<0>(is) = col * latitudePoints + row;
   std::get<1>(is) = std::get<0>(is) + 1;
-  std::get<2>(is) = std::get<0>(is) + m_latitudePoints;
+  std::get<2>(is) = std::get<0>(is) + latitudePoints;
   std::get<3>(is) = std::get<2>(is) + 1;
   return is;
 }
@@ -90,12 +147,12 @@ std::array<size_t, 4> DetectorGridDefinition::nearestNeighbourIndices(const doub
  *  @param col Zero-based integer describing a column of detector grid
  *  @return Indices of the detector
  */
-size_t DetectorGridDefinition::getDetectorIndex(size_t row, size_t col) {
-  if ((col >= m_longitudePoints) || (row >= m_latitudePoints)) {
+size_t DetectorGridDefinition::getDetectorIndex(size_t row, size_t col) const {
+  if ((col >= m_longitudes.size()) || (row >= m_latitudes.size())) {
     throw std::runtime_error("DetectorGridDefinition::getDetectorIndex: "
                              "detector requested for out of bounds row or col");
   }
-  return col * m_latitudePoints + row;
+  return col * m_latitudes.size() + row;
 }
 
 /** Return the indices to the detector that is immediate neighbour
@@ -106,26 +163,30 @@ size_t DetectorGridDefinition::getDetectorIndex(size_t row, size_t col) {
  */
 std::pair<size_t, size_t> DetectorGridDefinition::getNearestVertex(const double latitude,
                                                                    const double longitude) const {
-  auto topLeftRow = static_cast<size_t>((latitude - m_minLatitude) / m_latitudeStep);
-  // Check for points at the edges or outside the grid.
-  if (topLeftRow == m_latitudePoints - 1) {
-    --topLeftRow;
-  }
-  auto topLeftCol = static_cast<size_t>((longitude - m_minLongitude) / m_longitudeStep);
-  if (topLeftCol == m_longitudePoints - 1) {
-    --topLeftCol;
-  }
-  return std::pair<size_t, size_t>{topLeftRow, topLeftCol};
+  return std::pair<size_t, size_t>{intervalIndex(m_latitudes, latitude), intervalIndex(m_longitudes, longitude)};
 }
 
 /** Return the number of columns in the grid.
  *  @return Number of columns.
  */
-size_t DetectorGridDefinition::numberColumns() const { return m_longitudePoints; }
+size_t DetectorGridDefinition::numberColumns() const { return m_longitudes.size(); }
 
 /** Return the number of rows in the grid.
  *  @return Number of rows.
  */
-size_t DetectorGridDefinition::numberRows() const { return m_latitudePoints; }
+size_t DetectorGridDefinition::numberRows() const { return m_latitudes.size(); }
+
+/** Return a finer grid with a new row or column in the middle of the chosen
+ *  intervals. The rows and columns of this grid are kept.
+ *  @param splitRows Flags for each of the numberRows() - 1 intervals between
+ *  the rows.
+ *  @param splitColumns Flags for each of the numberColumns() - 1 intervals
+ *  between the columns.
+ *  @return The refined grid.
+ */
+DetectorGridDefinition DetectorGridDefinition::refined(const std::vector<bool> &splitRows,
+                                                       const std::vector<bool> &splitColumns) const {
+  return DetectorGridDefinition(splitIntervals(m_latitudes, splitRows), splitIntervals(m_longitudes, splitColumns));
+}
 
 } // namespace Mantid::Algorithms
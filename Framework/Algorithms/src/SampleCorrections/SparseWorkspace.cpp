@@ -22,6 +22,9 @@
 #include <Poco/DOM/AutoPtr.h>
 #include <Poco/DOM/Document.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace {
 /** Check all detectors have the same EFixed value.
  *  @param eFixed An EFixedProvider object.
@@ -48,10 +51,18 @@ namespace Mantid::Algorithms {
 
 SparseWorkspace::SparseWorkspace(const API::MatrixWorkspace &modelWS, const size_t wavelengthPoints, const size_t rows,
                                  const size_t columns)
-    : Workspace2D() {
-  double minLat, maxLat, minLong, maxLong;
-  std::tie(minLat, maxLat, minLong, maxLong) = extremeAngles(modelWS);
-  m_gridDef = std::make_unique<Algorithms::DetectorGridDefinition>(minLat, maxLat, rows, minLong, maxLong, columns);
+    : SparseWorkspace(modelWS, wavelengthPoints, createDetectorGridDefinition(modelWS, rows, columns)) {}
+
+/** Create a sparse workspace on a given detector grid.
+ *  @param modelWS A workspace the sparse instrument is approximating.
+ *  @param wavelengthPoints Number of points in the histograms.
+ *  @param grid The positions of the detectors.
+ */
+SparseWorkspace::SparseWorkspace(const API::MatrixWorkspace &modelWS, const size_t wavelengthPoints,
+                                 const DetectorGridDefinition &grid)
+    : Workspace2D(), m_gridDef(std::make_unique<Algorithms::DetectorGridDefinition>(grid)) {
+  const size_t rows = m_gridDef->numberRows();
+  const size_t columns = m_gridDef->numberColumns();
   if ((rows < 3) || (columns < 3)) {
     g_log.warning("Can't calculate errors on a sparse workspace with lat or "
                   "long dimension < 3");
@@ -187,6 +198,20 @@ std::tuple<double, double, double, double> SparseWorkspace::extremeAngles(const
   return std::make_tuple(minLat, maxLat, minLong, maxLong);
 }
 
+/** Create an evenly spaced detector grid covering the detectors of a
+ *  workspace.
+ *  @param modelWS A workspace the sparse instrument is approximating.
+ *  @param rows Number of rows in the grid.
+ *  @param columns Number of columns in the grid.
+ *  @return The grid definition.
+ */
+DetectorGridDefinition SparseWorkspace::createDetectorGridDefinition(const API::MatrixWorkspace &modelWS,
+                                                                     const size_t rows, const size_t columns) {
+  double minLat, maxLat, minLong, maxLong;
+  std::tie(minLat, maxLat, minLong, maxLong) = extremeAngles(modelWS);
+  return DetectorGridDefinition(minLat, maxLat, rows, minLong, maxLong, columns);
+}
+
 /** Find the maximum and minimum wavelength points over the entire workpace.
  *  @param ws A workspace to investigate.
  *  @return A tuple containing the wavelength range.
@@ -312,14 +337,98 @@ std::array<double, 4> SparseWorkspace::inverseDistanceWeights(const std::array<d
  */
 HistogramData::HistogramY SparseWorkspace::secondDerivative(const std::array<size_t, 3> indices,
                                                             const double distanceStep) const {
-  HistogramData::HistogramY avgSecondDeriv(blocksize());
+  return secondDerivative(indices, distanceStep, distanceStep);
+}
 
-  HistogramData::HistogramY sumSecondDeriv(blocksize());
-  auto firstDerivB = (y(indices[2]) - y(indices[1])) / distanceStep;
-  auto firstDerivA = (y(indices[1]) - y(indices[0])) / distanceStep;
-  auto secondDerivA = (firstDerivB - firstDerivA) / distanceStep;
+/** Calculate the second derivative of a histogram along a row of unevenly
+ *  spaced indices
+ *  @param indices List of detector indices
+ *  @param firstStep The distance between the first two detectors
+ *  @param secondStep The distance between the last two detectors
+ *  @return The second derivative at the middle detector.
+ */
+HistogramData::HistogramY SparseWorkspace::secondDerivative(const std::array<size_t, 3> indices,
+                                                            const double firstStep, const double secondStep) const {
+  auto firstDerivB = (y(indices[2]) - y(indices[1])) / secondStep;
+  auto firstDerivA = (y(indices[1]) - y(indices[0])) / firstStep;
+  return (firstDerivB - firstDerivA) / (0.5 * (firstStep + secondStep));
+}
 
-  return secondDerivA;
+/** Estimate the error of the bilinear interpolation at the centre of a cell of
+ *  the detector grid from the second derivatives along the latitude and the
+ *  longitude. The part of the estimate explained by the statistical errors of
+ *  the simulated points is discounted.
+ *  @param row Row of the detector at the lower latitude edge of the cell.
+ *  @param column Column of the detector at the lower longitude edge of the
+ *  cell.
+ *  @return The largest error over the wavelength points due to the curvature
+ *  along the latitude and along the longitude.
+ */
+std::pair<double, double> SparseWorkspace::interpolationErrorEstimate(const size_t row, const size_t column) const {
+  const auto rows = m_gridDef->numberRows();
+  const auto columns = m_gridDef->numberColumns();
+  if (rows < 3 || columns < 3 || row + 1 >= rows || column + 1 >= columns) {
+    return {0.0, 0.0};
+  }
+  // Same stencils as in bilinearInterpolateFromDetectorGrid
+  const size_t firstRow = row > 0 ? row - 1 : 0;
+  const size_t firstColumn = column > 0 ? column - 1 : 0;
+  const std::array<double, 3> latitudes{
+      {m_gridDef->latitudeAt(firstRow), m_gridDef->latitudeAt(firstRow + 1), m_gridDef->latitudeAt(firstRow + 2)}};
+  const std::array<double, 3> longitudes{{m_gridDef->longitudeAt(firstColumn),
+                                          m_gridDef->longitudeAt(firstColumn + 1),
+                                          m_gridDef->longitudeAt(firstColumn + 2)}};
+  const double latitudeStep = m_gridDef->latitudeAt(row + 1) - m_gridDef->latitudeAt(row);
+  const double longitudeStep = m_gridDef->longitudeAt(column + 1) - m_gridDef->longitudeAt(column);
+  double latitudeError = 0.0;
+  double longitudeError = 0.0;
+  for (size_t edge = 0; edge < 2; ++edge) {
+    std::array<size_t, 3> indices;
+    for (size_t i = 0; i < 3; ++i) {
+      indices[i] = m_gridDef->getDetectorIndex(firstRow + i, column + edge);
+    }
+    latitudeError = std::max(latitudeError, curvatureError(indices, latitudes, latitudeStep));
+    for (size_t i = 0; i < 3; ++i) {
+      indices[i] = m_gridDef->getDetectorIndex(row + edge, firstColumn + i);
+    }
+    longitudeError = std::max(longitudeError, curvatureError(indices, longitudes, longitudeStep));
+  }
+  return {latitudeError, longitudeError};
+}
+
+/** Estimate the error of a linear interpolation at the middle of an interval
+ *  from the second derivative along three detectors, less twice the
+ *  uncertainty of the estimate.
+ *  @param indices Workspace indices of the three detectors
+ *  @param coordinates Latitudes or longitudes of the detectors
+ *  @param intervalSize The size of the interpolation interval
+ *  @return The largest error over the wavelength points, or zero if it is
+ *  not significant.
+ */
+double SparseWorkspace::curvatureError(const std::array<size_t, 3> &indices, const std::array<double, 3> &coordinates,
+                                       const double intervalSize) const {
+  const double firstStep = coordinates[1] - coordinates[0];
+  const double secondStep = coordinates[2] - coordinates[1];
+  // second derivative as a weighted sum of the three values
+  const double weight0 = 2.0 / (firstStep * (firstStep + secondStep));
+  const double weight2 = 2.0 / (secondStep * (firstStep + secondStep));
+  const double weight1 = -(weight0 + weight2);
+  // 0.5 * (x - x0) * (x1 - x) at the middle of the interval
+  const double factor = intervalSize * intervalSize / 8.0;
+  const auto &y0 = y(indices[0]);
+  const auto &y1 = y(indices[1]);
+  const auto &y2 = y(indices[2]);
+  const auto &e0 = e(indices[0]);
+  const auto &e1 = e(indices[1]);
+  const auto &e2 = e(indices[2]);
+  double largest = 0.0;
+  for (size_t i = 0; i < y0.size(); ++i) {
+    const double error = factor * std::abs(weight0 * y0[i] + weight1 * y1[i] + weight2 * y2[i]);
+    const double uncertainty =
+        factor * std::sqrt(std::pow(weight0 * e0[i], 2) + std::pow(weight1 * e1[i], 2) + std::pow(weight2 * e2[i], 2));
+    largest = std::max(largest, error - 2.0 * uncertainty);
+  }
+  return largest;
 }
 
 /** Spatially interpolate a single histogram from nearby detectors.
@@ -412,17 +521,21 @@ HistogramData::Histogram SparseWorkspace::bilinearInterpolateFromDetectorGrid(co
     auto nearestLonIndexSec = nearestLonIndex > 0 ? nearestLonIndex - 1 : 0;
     std::array<size_t, 3> threeIndices;
 
-    // 2nd derivative in longitude
+    // 2nd derivative in longitude, the grid may be unevenly spaced if refined
     for (int i = 0; i < 3; i++) {
       threeIndices[i] = m_gridDef->getDetectorIndex(nearestLatIndex, nearestLonIndexSec + i);
     }
-    auto avgSecondDerivLong = secondDerivative(threeIndices, longHigh - longLow);
+    auto avgSecondDerivLong = secondDerivative(
+        threeIndices, m_gridDef->longitudeAt(nearestLonIndexSec + 1) - m_gridDef->longitudeAt(nearestLonIndexSec),
+        m_gridDef->longitudeAt(nearestLonIndexSec + 2) - m_gridDef->longitudeAt(nearestLonIndexSec + 1));
 
     // 2nd derivative in latitude
     for (int i = 0; i < 3; i++) {
       threeIndices[i] = m_gridDef->getDetectorIndex(nearestLatIndexSec + i, nearestLonIndex);
     }
-    auto avgSecondDerivLat = secondDerivative(threeIndices, latHigh - latLow);
+    auto avgSecondDerivLat = secondDerivative(
+        threeIndices, m_gridDef->latitudeAt(nearestLatIndexSec + 1) - m_gridDef->latitudeAt(nearestLatIndexSec),
+        m_gridDef->latitudeAt(nearestLatIndexSec + 2) - m_gridDef->latitudeAt(nearestLatIndexSec + 1));
 
     // calculate the interpolation error according to a Taylor expansion from
     // the low lat and low long points. Doesn't make any difference if do this
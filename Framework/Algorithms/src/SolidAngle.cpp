@@ -17,7 +17,9 @@
 #include "MantidKernel/BoundedValidator.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/UnitFactory.h"
+#include "MantidTypes/SpectrumDefinition.h"
 
+#include <algorithm>
 #include <atomic>
 
 namespace Mantid::Algorithms {
@@ -105,15 +107,20 @@ protected:
 struct GenericShape : public SolidAngleCalculator {
   using SolidAngleCalculator::SolidAngleCalculator;
   GenericShape(const ComponentInfo &componentInfo, const DetectorInfo &detectorInfo, const std::string &method,
-               const double pixelArea, const int numberOfCylinderSlices)
-      : SolidAngleCalculator(componentInfo, detectorInfo, method, pixelArea),
-        m_numberOfCylinderSlices(numberOfCylinderSlices) {}
-  double solidAngle(size_t index) const override {
-    return m_detectorInfo.detector(index).solidAngle(Geometry::SolidAngleParams(m_samplePos, m_numberOfCylinderSlices));
+               const double pixelArea, const std::vector<size_t> &detectorIndices, const int numberOfCylinderSlices)
+      : SolidAngleCalculator(componentInfo, detectorInfo, method, pixelArea), m_solidAngles(detectorInfo.size(), 0.0) {
+    // The detectors sharing a shape are calculated together, which is much
+    // faster than asking each detector for its solid angle
+    const auto solidAngles =
+        componentInfo.solidAngles(detectorIndices, Geometry::SolidAngleParams(m_samplePos, numberOfCylinderSlices));
+    for (size_t i = 0; i < detectorIndices.size(); ++i)
+      m_solidAngles[detectorIndices[i]] = solidAngles[i];
   }
+  double solidAngle(size_t index) const override { return m_solidAngles[index]; }
 
 private:
-  int m_numberOfCylinderSlices;
+  /// Solid angles of the detectors, by detector index
+  std::vector<double> m_solidAngles;
 };
 
 struct Rectangle : public SolidAngleCalculator {
@@ -248,8 +255,17 @@ void SolidAngle::exec() {
   int numberOfCylinderSlices = getProperty("NumberOfCylinderSlices");
   std::unique_ptr<SolidAngleCalculator> solidAngleCalculator;
   if (method == GENERIC_SHAPE) {
-    solidAngleCalculator =
-        std::make_unique<GenericShape>(componentInfo, detectorInfo, method, pixelArea, numberOfCylinderSlices);
+    std::vector<size_t> detectorIndices;
+    for (int j = m_MinSpec; j <= m_MaxSpec; ++j) {
+      for (const auto &detIndex : spectrumInfo.spectrumDefinition(j)) {
+        if (!detectorInfo.isMasked(detIndex.first) && !detectorInfo.isMonitor(detIndex.first))
+          detectorIndices.emplace_back(detIndex.first);
+      }
+    }
+    std::sort(detectorIndices.begin(), detectorIndices.end());
+    detectorIndices.erase(std::unique(detectorIndices.begin(), detectorIndices.end()), detectorIndices.end());
+    solidAngleCalculator = std::make_unique<GenericShape>(componentInfo, detectorInfo, method, pixelArea,
+                                                          detectorIndices, numberOfCylinderSlices);
   } else if (method == RECTANGLE) {
     solidAngleCalculator = std::make_unique<Rectangle>(componentInfo, detectorInfo, method, pixelArea);
   } else if (method == VERTICAL_TUBE || method == HORIZONTAL_TUBE) {
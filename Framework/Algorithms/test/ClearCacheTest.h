@@ -8,11 +8,16 @@
 
 #include "MantidAPI/AlgorithmManager.h"
 #include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/Axis.h"
 #include "MantidAPI/InstrumentDataService.h"
+#include "MantidFrameworkTestHelpers/WorkspaceCreationHelper.h"
+#include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/UsageService.h"
 #include <cxxtest/TestSuite.h>
 
 #include "MantidAlgorithms/ClearCache.h"
+#include "MantidAlgorithms/CylinderAbsorption.h"
+#include "MantidAlgorithms/SampleCorrections/AbsorptionCorrectionCache.h"
 #include <Poco/File.h>
 #include <Poco/Path.h>
 
@@ -163,6 +168,40 @@ public:
     TS_ASSERT_EQUALS(filesRemoved, 0);
   }
 
+  void test_exec_AbsorptionCorrection_Cache() {
+    using Mantid::Algorithms::AbsorptionCorrectionCache;
+    // Fill the cache by calculating a correction with the cache enabled
+    AbsorptionCorrectionCache::clear();
+    auto inputWS = WorkspaceCreationHelper::create2DWorkspaceWithFullInstrument(1, 10);
+    inputWS->getAxis(0)->unit() = UnitFactory::Instance().create("Wavelength");
+    Mantid::Algorithms::CylinderAbsorption absorption;
+    absorption.initialize();
+    absorption.setChild(true);
+    absorption.setProperty("InputWorkspace", inputWS);
+    absorption.setPropertyValue("OutputWorkspace", "factors");
+    absorption.setPropertyValue("NumberOfWavelengthPoints", "5");
+    absorption.setPropertyValue("CylinderSampleHeight", "4");
+    absorption.setPropertyValue("CylinderSampleRadius", "0.4");
+    absorption.setPropertyValue("AttenuationXSection", "5.08");
+    absorption.setPropertyValue("ScatteringXSection", "5.1");
+    absorption.setPropertyValue("SampleNumberDensity", "0.07192");
+    absorption.setProperty("UseCorrectionCache", true);
+    TS_ASSERT_THROWS_NOTHING(absorption.execute());
+    TS_ASSERT_EQUALS(AbsorptionCorrectionCache::size(), 1);
+
+    ClearCache alg;
+
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("AbsorptionCorrectionCache", true));
+    TS_ASSERT_THROWS_NOTHING(alg.execute(););
+    TS_ASSERT(alg.isExecuted());
+
+    TS_ASSERT_EQUALS(AbsorptionCorrectionCache::size(), 0);
+    int filesRemoved = alg.getProperty("FilesRemoved");
+    TS_ASSERT_EQUALS(filesRemoved, 0);
+  }
+
   std::string m_localInstDir;
   std::vector<std::string> m_originalInstDir;
   std::vector<Poco::File> m_directoriesToRemove;
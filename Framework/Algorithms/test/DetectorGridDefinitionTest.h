@@ -108,6 +108,53 @@ public:
     TS_ASSERT(inArray(indices, 6))
   }
 
+  void test_unevenly_spaced_grid() {
+    const DetectorGridDefinition def({0.0, 0.1, 0.5}, {-1.0, 0.0, 0.25, 2.0});
+    TS_ASSERT_EQUALS(def.numberRows(), 3)
+    TS_ASSERT_EQUALS(def.numberColumns(), 4)
+    TS_ASSERT_EQUALS(def.latitudeAt(1), 0.1)
+    TS_ASSERT_EQUALS(def.longitudeAt(2), 0.25)
+    auto index = def.getNearestVertex(0.3, 0.2);
+    TS_ASSERT_EQUALS(index.first, 1)
+    TS_ASSERT_EQUALS(index.second, 1)
+    index = def.getNearestVertex(0.5, 2.0);
+    TS_ASSERT_EQUALS(index.first, 1)
+    TS_ASSERT_EQUALS(index.second, 2)
+    const auto indices = def.nearestNeighbourIndices(0.05, 1.0);
+    TS_ASSERT(inArray(indices, 6))
+    TS_ASSERT(inArray(indices, 7))
+    TS_ASSERT(inArray(indices, 9))
+    TS_ASSERT(inArray(indices, 10))
+  }
+
+  void test_unevenly_spaced_grid_must_be_ascending() {
+    TS_ASSERT_THROWS(DetectorGridDefinition({0.0, 0.0, 0.5}, {0.0, 1.0}), const std::runtime_error &);
+    TS_ASSERT_THROWS(DetectorGridDefinition({0.0, 0.5}, {1.0, 0.0}), const std::runtime_error &);
+    TS_ASSERT_THROWS(DetectorGridDefinition({0.0}, {0.0, 1.0}), const std::runtime_error &);
+  }
+
+  void test_refined() {
+    const auto def = makeTestDefinition();
+    std::vector<bool> splitRows(nLat() - 1, false);
+    splitRows[2] = true;
+    std::vector<bool> splitColumns(nLong() - 1, false);
+    splitColumns.front() = true;
+    splitColumns.back() = true;
+    const auto refined = def.refined(splitRows, splitColumns);
+    TS_ASSERT_EQUALS(refined.numberRows(), nLat() + 1)
+    TS_ASSERT_EQUALS(refined.numberColumns(), nLong() + 2)
+    // the old rows and columns are kept
+    TS_ASSERT_EQUALS(refined.latitudeAt(2), def.latitudeAt(2))
+    TS_ASSERT_EQUALS(refined.latitudeAt(3), (def.latitudeAt(2) + def.latitudeAt(3)) / 2.0)
+    TS_ASSERT_EQUALS(refined.latitudeAt(4), def.latitudeAt(3))
+    TS_ASSERT_EQUALS(refined.latitudeAt(nLat()), maxLat())
+    TS_ASSERT_EQUALS(refined.longitudeAt(0), minLong())
+    TS_ASSERT_EQUALS(refined.longitudeAt(1), (def.longitudeAt(0) + def.longitudeAt(1)) / 2.0)
+    TS_ASSERT_EQUALS(refined.longitudeAt(nLong() - 1), def.longitudeAt(nLong() - 2))
+    TS_ASSERT_EQUALS(refined.longitudeAt(nLong() + 1), def.longitudeAt(nLong() - 1))
+    TS_ASSERT_THROWS(def.refined({true}, splitColumns), const std::invalid_argument &)
+  }
+
 private:
   static double minLat() { return -0.23; }
   static double maxLat() { return 1.36; }
@@ -48,6 +48,10 @@ public:
   void getXMinMax(const Mantid::API::MatrixWorkspace &ws, double &xmin, double &xmax) {
     DiscusMultipleScatteringCorrection::getXMinMax(ws, xmin, xmax);
   }
+  ComponentWorkspaceMappings prepareComponentWorkspacesForK(double k,
+                                                            const ComponentWorkspaceMappings &componentWorkspaces) {
+    return DiscusMultipleScatteringCorrection::prepareComponentWorkspacesForK(k, componentWorkspaces);
+  }
 };
 
 class DiscusMultipleScatteringCorrectionTest : public CxxTest::TestSuite {
@@ -725,6 +729,36 @@ public:
                                                      1E-05, scatteringCrossSectionWS);
   }
 
+  void test_preparing_importance_sampling_for_new_k_leaves_shared_workspaces_unchanged() {
+    DiscusMultipleScatteringCorrectionHelper alg;
+    // elastic Q.S(Q) for an isotropic S(Q)
+    const std::vector<double> qValues{0., 0.5, 1., 1.5, 2., 2.5, 3., 3.5, 4.};
+    ComponentWorkspaceMapping mapping;
+    mapping.QSQ = std::make_shared<DiscusData2D>(std::vector<DiscusData1D>{DiscusData1D(qValues, qValues)},
+                                                 std::make_shared<std::vector<double>>(1, 0.));
+    mapping.InvPOfQ = std::make_shared<DiscusData2D>(
+        std::vector<DiscusData1D>{DiscusData1D({0., 1.}, {0., 2.}), DiscusData1D({0., 1.}, {0., 0.})}, nullptr);
+    DiscusMultipleScatteringCorrection::ComponentWorkspaceMappings shared{mapping};
+    const auto sharedInvPOfQ = shared[0].InvPOfQ;
+    const auto originalHistograms = sharedInvPOfQ->histograms();
+
+    // the k after the first and second scatters of a path
+    const auto afterFirstScatter = alg.prepareComponentWorkspacesForK(1.0, shared);
+    const auto afterSecondScatter = alg.prepareComponentWorkspacesForK(1.5, shared);
+
+    TS_ASSERT_EQUALS(shared[0].InvPOfQ, sharedInvPOfQ);
+    for (size_t i = 0; i < originalHistograms.size(); ++i) {
+      TS_ASSERT_EQUALS(sharedInvPOfQ->histogram(i).X, originalHistograms[i].X);
+      TS_ASSERT_EQUALS(sharedInvPOfQ->histogram(i).Y, originalHistograms[i].Y);
+    }
+    TS_ASSERT_DIFFERS(afterFirstScatter[0].InvPOfQ, sharedInvPOfQ);
+    TS_ASSERT_DIFFERS(afterSecondScatter[0].InvPOfQ, sharedInvPOfQ);
+    TS_ASSERT_DIFFERS(afterFirstScatter[0].InvPOfQ, afterSecondScatter[0].InvPOfQ);
+    // max Q = 2k
+    TS_ASSERT_DELTA(afterFirstScatter[0].InvPOfQ->histogram(0).Y.back(), 2.0, 1e-10);
+    TS_ASSERT_DELTA(afterSecondScatter[0].InvPOfQ->histogram(0).Y.back(), 3.0, 1e-10);
+  }
+
   void test_getxminmax() {
     const double x0 = 0.5;
     const double deltax = 1.0;
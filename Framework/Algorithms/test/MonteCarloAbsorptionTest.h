@@ -13,6 +13,7 @@
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAlgorithms/ConvertUnits.h"
 #include "MantidAlgorithms/MonteCarloAbsorption.h"
+#include "MantidAlgorithms/SampleCorrections/AbsorptionCorrectionCache.h"
 #include "MantidAlgorithms/SampleCorrections/IBeamProfile.h"
 #include "MantidAlgorithms/SampleCorrections/IMCInteractionVolume.h"
 #include "MantidAlgorithms/SampleCorrections/MCInteractionStatistics.h"
@@ -608,6 +609,89 @@ public:
     // only checking that it can successfully execute
   }
 
+  void test_adaptive_sparse_instrument() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {9, 3, true, Environment::CylinderSampleOnly, DeltaEMode::Elastic, -1};
+    auto testWS = setUpWS(wsProps);
+    auto runSparse = [&](const bool adaptive, const double tolerance) {
+      auto mcAbsorb = createAlgorithm();
+      mcAbsorb->setProperty("InputWorkspace", testWS);
+      mcAbsorb->setProperty("SparseInstrument", true);
+      mcAbsorb->setProperty("NumberOfDetectorRows", 3);
+      mcAbsorb->setProperty("NumberOfDetectorColumns", 3);
+      mcAbsorb->setProperty("AdaptiveSparseInstrument", adaptive);
+      mcAbsorb->setProperty("InterpolationTolerance", tolerance);
+      mcAbsorb->setProperty("MaxNumberOfRefinements", 2);
+      TS_ASSERT_THROWS_NOTHING(mcAbsorb->execute());
+      return getOutputWorkspace(mcAbsorb);
+    };
+
+    const auto fixedGrid = runSparse(false, 1.0);
+    // within tolerance on the initial grid: nothing to refine
+    const auto unrefined = runSparse(true, 1.0);
+    for (size_t i = 0; i < static_cast<size_t>(wsProps.nspectra); ++i) {
+      TS_ASSERT_EQUALS(fixedGrid->y(i).rawData(), unrefined->y(i).rawData());
+    }
+    const auto refined = runSparse(true, 1e-12);
+    verifyDimensions(wsProps, refined);
+    for (size_t i = 0; i < static_cast<size_t>(wsProps.nspectra); ++i) {
+      for (const auto y : refined->y(i)) {
+        TS_ASSERT(std::isfinite(y))
+        TS_ASSERT_LESS_THAN(0.0, y)
+        TS_ASSERT_LESS_THAN_EQUALS(y, 1.0)
+      }
+    }
+  }
+
+  void test_adaptive_sparse_instrument_requires_sparse_instrument() {
+    using Mantid::Kernel::DeltaEMode;
+    TestWorkspaceDescriptor wsProps = {1, 3, true, Environment::CylinderSampleOnly, DeltaEMode::Elastic, -1};
+    auto mcAbsorb = createAlgorithm();
+    mcAbsorb->setProperty("InputWorkspace", setUpWS(wsProps));
+    mcAbsorb->setProperty("AdaptiveSparseInstrument", true);
+    TS_ASSERT_THROWS(mcAbsorb->execute(), const std::runtime_error &);
+  }
+
+  void test_correction_cache_reuses_factors_of_identical_inputs() {
+    using Mantid::Algorithms::AbsorptionCorrectionCache;
+    using Mantid::Kernel::DeltaEMode;
+    AbsorptionCorrectionCache::clear();
+    TestWorkspaceDescriptor wsProps = {3, 5, true, Environment::CylinderSampleOnly, DeltaEMode::Elastic, -1};
+    auto testWS = setUpWS(wsProps);
+    auto runWithCache = [this](const Mantid::API::MatrixWorkspace_sptr &inputWS, const int seed) {
+      auto mcAbsorb = createAlgorithm();
+      mcAbsorb->setProperty("InputWorkspace", inputWS);
+      mcAbsorb->setProperty("SeedValue", seed);
+      mcAbsorb->setProperty("UseCorrectionCache", true);
+      TS_ASSERT_THROWS_NOTHING(mcAbsorb->execute());
+      return getOutputWorkspace(mcAbsorb);
+    };
+
+    const auto first = runWithCache(testWS, 123456789);
+    TS_ASSERT_EQUALS(AbsorptionCorrectionCache::size(), 1);
+    // another run with the same sample and instrument
+    const auto second = runWithCache(testWS->clone(), 123456789);
+    TS_ASSERT_EQUALS(AbsorptionCorrectionCache::size(), 1);
+    verifyDimensions(wsProps, second);
+    for (size_t i = 0; i < static_cast<size_t>(wsProps.nspectra); ++i) {
+      TS_ASSERT_EQUALS(first->x(i).rawData(), second->x(i).rawData());
+      TS_ASSERT_EQUALS(first->y(i).rawData(), second->y(i).rawData());
+      TS_ASSERT_EQUALS(first->e(i).rawData(), second->e(i).rawData());
+    }
+
+    // different properties or a different masking give a new calculation
+    const auto otherSeed = runWithCache(testWS, 987654321);
+    TS_ASSERT_EQUALS(AbsorptionCorrectionCache::size(), 2);
+    TS_ASSERT_DIFFERS(first->y(0).rawData(), otherSeed->y(0).rawData());
+    testWS->mutableSpectrumInfo().setMasked(0, true);
+    const auto masked = runWithCache(testWS, 123456789);
+    TS_ASSERT_EQUALS(AbsorptionCorrectionCache::size(), 3);
+    TS_ASSERT_EQUALS(masked->y(0)[0], 0.0);
+
+    AbsorptionCorrectionCache::clear();
+    TS_ASSERT_EQUALS(AbsorptionCorrectionCache::size(), 0);
+  }
+
   Mantid::API::MatrixWorkspace_const_sptr do_test_Sparse_Workspace(Mantid::API::MatrixWorkspace_sptr modelWS,
                                                                    int nExpectedInterpolationCalls) {
     auto mcAbsorb = createTestAlgorithm();
@@ -455,6 +455,60 @@ public:
     }
   }
 
+  void test_interpolationErrorEstimate() {
+    using namespace WorkspaceCreationHelper;
+    auto ws = create2DWorkspaceWithRectangularInstrument(1, 2, 7);
+    const size_t sparseRows = 3;
+    const size_t sparseCols = 6;
+    const size_t wavelengths = 3;
+    auto sparseWS = std::make_unique<SparseWorkspaceWrapper>(*ws, wavelengths, sparseRows, sparseCols);
+    for (size_t row = 0; row < sparseRows; row++) {
+      for (size_t col = 0; col < sparseCols; col++) {
+        auto &ys = sparseWS->mutableY(row + col * sparseRows);
+        for (size_t j = 0; j < ys.size(); ++j) {
+          ys[j] = std::pow(col, 2);
+        }
+      }
+    }
+    // 2nd derivative in long is 2.0 per column squared, zero in lat
+    auto errors = sparseWS->interpolationErrorEstimate(1, 2);
+    TS_ASSERT_DELTA(errors.first, 0.0, 1e-7)
+    TS_ASSERT_DELTA(errors.second, 0.5 * 0.5 * 0.5 * 2.0, 1e-7)
+    errors = sparseWS->interpolationErrorEstimate(0, 0);
+    TS_ASSERT_DELTA(errors.second, 0.5 * 0.5 * 0.5 * 2.0, 1e-7)
+
+    // curvature which can be explained by the statistical errors is ignored
+    for (size_t i = 0; i < sparseWS->getNumberHistograms(); ++i) {
+      sparseWS->mutableE(i) = 10.0;
+    }
+    errors = sparseWS->interpolationErrorEstimate(1, 2);
+    TS_ASSERT_EQUALS(errors.first, 0.0)
+    TS_ASSERT_EQUALS(errors.second, 0.0)
+  }
+
+  void test_refined_grid_keeps_bilinear_interpolation() {
+    using namespace WorkspaceCreationHelper;
+    auto ws = create2DWorkspaceWithRectangularInstrument(1, 2, 7);
+    const size_t wavelengths = 3;
+    const auto coarseWS = std::make_unique<SparseWorkspaceWrapper>(*ws, wavelengths, 3, 4);
+    const auto grid = coarseWS->grid().refined({true, false}, {false, true, false});
+    auto sparseWS = std::make_unique<SparseWorkspace>(*ws, wavelengths, grid);
+    TS_ASSERT_EQUALS(sparseWS->getNumberHistograms(), 4 * 5)
+    // a plane is interpolated exactly on the uneven grid
+    for (size_t col = 0; col < grid.numberColumns(); ++col) {
+      for (size_t row = 0; row < grid.numberRows(); ++row) {
+        sparseWS->mutableY(grid.getDetectorIndex(row, col)) = 2.0 * grid.latitudeAt(row) + grid.longitudeAt(col);
+      }
+    }
+    const double lat = 0.3 * grid.latitudeAt(0) + 0.7 * grid.latitudeAt(3);
+    const double lon = 0.6 * grid.longitudeAt(1) + 0.4 * grid.longitudeAt(3);
+    const auto h = sparseWS->bilinearInterpolateFromDetectorGrid(lat, lon);
+    for (size_t i = 0; i < h.size(); ++i) {
+      TS_ASSERT_DELTA(h.y()[i], 2.0 * lat + lon, 1e-7)
+      TS_ASSERT_DELTA(h.e()[i], 0.0, 1e-7)
+    }
+  }
+
   void test_inverseDistanceWeights() {
     std::array<double, 4> ds{{0.3, 0.3, 0.0, 0.3}};
     auto weights = SparseWorkspaceWrapper::inverseDistanceWeights(ds);
@@ -15,6 +15,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace Mantid {
 namespace Beamline {
@@ -105,6 +106,9 @@ public:
   void setPosition(const std::pair<size_t, size_t> &index, const Eigen::Vector3d &newPosition);
   void setRotation(const size_t componentIndex, const Eigen::Quaterniond &newRotation);
   void setRotation(const std::pair<size_t, size_t> &index, const Eigen::Quaterniond &newRotation);
+  void setPositionsAndRotations(
+      const std::vector<size_t> &componentIndices, const std::vector<Eigen::Vector3d> &newPositions,
+      const std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>> &newRotations);
   void scaleComponent(const size_t componentIndex, const Eigen::Vector3d &newScaling);
   void scaleComponent(const std::pair<size_t, size_t> &index, const Eigen::Vector3d &newScaling);
 
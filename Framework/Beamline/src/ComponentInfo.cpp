@@ -7,6 +7,7 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidBeamline/ComponentInfo.h"
 #include "MantidBeamline/DetectorInfo.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/make_cow.h"
 #include <algorithm>
 #include <iterator>
@@ -407,6 +408,116 @@ void ComponentInfo::setRotation(const std::pair<size_t, size_t> &index, const Ei
   doSetRotation(index, newRotation, detectorRange);
 }
 
+/**
+ * Sets the positions and rotations of many components in one pass.
+ *
+ * The result is the same as calling setPosition and setRotation for each
+ *entry in turn, parents before children: every listed component ends up at its
+ *given absolute position and rotation, and every other component moves
+ *rigidly with its nearest listed ancestor. Each affected detector and
+ *component is transformed exactly once, which avoids the repeated subtree
+ *walks of the sequential calls when the listed components are nested.
+ *
+ * @param componentIndices : Component indices to update, without duplicates
+ * @param newPositions : Absolute positions to set, one per component index
+ * @param newRotations : Absolute rotations to set, one per component index
+ */
+void ComponentInfo::setPositionsAndRotations(
+    const std::vector<size_t> &componentIndices, const std::vector<Eigen::Vector3d> &newPositions,
+    const std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>> &newRotations) {
+  checkNoTimeDependence();
+  const size_t nEntries = componentIndices.size();
+  if (newPositions.size() != nEntries || newRotations.size() != nEntries)
+    throw std::invalid_argument("ComponentInfo::setPositionsAndRotations: "
+                                "need one position and one rotation per component index");
+
+  // Parents always have higher indices than their children, so visiting the
+  // entries by descending index handles every ancestor before its descendants.
+  std::vector<size_t> order(nEntries);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&componentIndices](const size_t a, const size_t b) { return componentIndices[a] > componentIndices[b]; });
+  for (size_t i = 1; i < nEntries; ++i) {
+    if (componentIndices[order[i]] == componentIndices[order[i - 1]])
+      throw std::invalid_argument("ComponentInfo::setPositionsAndRotations: duplicate component index");
+  }
+
+  // Each entry maps its subtree rigidly from the original geometry:
+  // x -> R * (x - oldPosition) + newPosition, rotation -> R * rotation
+  std::vector<Eigen::Matrix3d> transforms(nEntries);
+  std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>> rotDeltas(nEntries);
+  std::vector<Eigen::Vector3d> oldPositions(nEntries);
+  // The entry placing each component, -1 for components left untouched.
+  // Descendants overwrite their ancestors, leaving the nearest listed one.
+  std::vector<int64_t> owners(m_size, -1);
+  bool movesDetectors = false;
+  bool movesComponents = false;
+  for (const auto entry : order) {
+    const auto componentIndex = componentIndices[entry];
+    oldPositions[entry] = position(componentIndex);
+    rotDeltas[entry] = (newRotations[entry] * rotation(componentIndex).inverse()).normalized();
+    transforms[entry] = Eigen::Matrix3d(rotDeltas[entry]);
+    const auto owner = static_cast<int64_t>(entry);
+    if (isDetector(componentIndex)) {
+      owners[componentIndex] = owner;
+      movesDetectors = true;
+      continue;
+    }
+    for (const auto &subDetIndex : detectorRangeInSubtree(componentIndex)) {
+      owners[subDetIndex] = owner;
+      movesDetectors = true;
+    }
+    for (const auto &subCompIndex : componentRangeInSubtree(componentIndex))
+      owners[subCompIndex] = owner;
+    movesComponents = true;
+  }
+  if (movesDetectors)
+    failIfDetectorInfoScanning();
+
+  // Listed components take their given values exactly, everything else is
+  // transformed by its owner. Copy-on-write access is resolved before the
+  // parallel loops.
+  const auto nDetectors = static_cast<int64_t>(m_assemblySortedDetectorIndices->size());
+  if (movesDetectors) {
+    auto &detPositions = m_detectorInfo->m_positions.access();
+    auto &detRotations = m_detectorInfo->m_rotations.access();
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t detIndex = 0; detIndex < nDetectors; ++detIndex) {
+      const auto owner = owners[detIndex];
+      if (owner < 0)
+        continue;
+      if (componentIndices[owner] == static_cast<size_t>(detIndex)) {
+        detPositions[detIndex] = newPositions[owner];
+        detRotations[detIndex] = newRotations[owner].normalized();
+      } else {
+        detPositions[detIndex] =
+            transforms[owner] * (detPositions[detIndex] - oldPositions[owner]) + newPositions[owner];
+        detRotations[detIndex] = (rotDeltas[owner] * detRotations[detIndex]).normalized();
+      }
+    }
+  }
+
+  if (movesComponents) {
+    auto &positions = m_positions.access();
+    auto &rotations = m_rotations.access();
+    const auto nComponents = static_cast<int64_t>(nonDetectorSize());
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t offsetIndex = 0; offsetIndex < nComponents; ++offsetIndex) {
+      const auto owner = owners[nDetectors + offsetIndex];
+      if (owner < 0)
+        continue;
+      if (componentIndices[owner] == static_cast<size_t>(nDetectors + offsetIndex)) {
+        positions[offsetIndex] = newPositions[owner];
+        rotations[offsetIndex] = newRotations[owner].normalized();
+      } else {
+        positions[offsetIndex] =
+            transforms[owner] * (positions[offsetIndex] - oldPositions[owner]) + newPositions[owner];
+        rotations[offsetIndex] = (rotDeltas[owner] * rotations[offsetIndex]).normalized();
+      }
+    }
+  }
+}
+
 /**
  * Scales all detectors for a component around it's geometrical center described by target component index
  *
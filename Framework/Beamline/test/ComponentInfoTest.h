@@ -783,6 +783,48 @@ public:
     do_write_rotation_updates_positions_correctly(info, rootIndex, detectorIndex);
   }
 
+  void test_setPositionsAndRotations_matches_sequential_setters() {
+    auto sequentialOutputs = makeTreeExampleAndReturnGeometricArguments();
+    auto batchOutputs = makeTreeExampleAndReturnGeometricArguments();
+    ComponentInfo &sequentialInfo = *std::get<0>(sequentialOutputs);
+    ComponentInfo &batchInfo = *std::get<0>(batchOutputs);
+
+    // Root, sub-assembly and a detector directly below the root. Deliberately
+    // not given parents first.
+    const std::vector<size_t> indices{3, 1, 4};
+    const PosVec positions{{0, 2, 1}, {4, 0, -1}, {1, 1, 1}};
+    const RotVec rotations{Eigen::Quaterniond(Eigen::AngleAxisd(M_PI / 3, Eigen::Vector3d::UnitX())),
+                           Eigen::Quaterniond(Eigen::AngleAxisd(M_PI / 5, Eigen::Vector3d::UnitZ())),
+                           Eigen::Quaterniond(Eigen::AngleAxisd(M_PI / 2, Eigen::Vector3d::UnitY()))};
+
+    for (const size_t i : {2, 0, 1}) {
+      sequentialInfo.setPosition(indices[i], positions[i]);
+      sequentialInfo.setRotation(indices[i], rotations[i]);
+    }
+    batchInfo.setPositionsAndRotations(indices, positions, rotations);
+
+    for (size_t i = 0; i < batchInfo.size(); ++i) {
+      TSM_ASSERT("Batch position should match sequential updates",
+                 batchInfo.position(i).isApprox(sequentialInfo.position(i), 1e-12));
+      TSM_ASSERT("Batch rotation should match sequential updates",
+                 batchInfo.rotation(i).isApprox(sequentialInfo.rotation(i), 1e-12));
+    }
+    for (size_t i = 0; i < indices.size(); ++i) {
+      TS_ASSERT(batchInfo.position(indices[i]).isApprox(positions[i]));
+      TS_ASSERT(batchInfo.rotation(indices[i]).isApprox(rotations[i]));
+    }
+  }
+
+  void test_setPositionsAndRotations_throws_on_bad_input() {
+    auto allOutputs = makeTreeExampleAndReturnGeometricArguments();
+    ComponentInfo &info = *std::get<0>(allOutputs);
+    const RotVec rotations(2, Eigen::Quaterniond::Identity());
+
+    TS_ASSERT_THROWS(info.setPositionsAndRotations({3, 4}, PosVec(1), rotations), const std::invalid_argument &);
+    TS_ASSERT_THROWS(info.setPositionsAndRotations({3, 3}, PosVec(2, Eigen::Vector3d::Zero()), rotations),
+                     const std::invalid_argument &);
+  }
+
   void test_setScanInterval() {
     auto infos = makeTreeExample();
     auto &compInfo = *std::get<0>(infos);
@@ -42,18 +42,15 @@ private:
   mutable int n_iter;
   mutable std::vector<double> m_tofs;
 
-  const bool LOGCHILDALG{false};
   const Mantid::Kernel::V3D UNSET_HKL{0, 0, 0};
   // const double PI{3.1415926535897932384626433832795028841971693993751058209};
 
   /// helper functions
-  Mantid::API::IPeaksWorkspace_sptr moveInstruentComponentBy(double deltaX, double deltaY, double deltaZ,
-                                                             const std::string &componentName,
-                                                             Mantid::API::IPeaksWorkspace_sptr &pws) const;
-
-  Mantid::API::IPeaksWorkspace_sptr rotateInstrumentComponentBy(double rotX, double rotY, double rotZ,
-                                                                const std::string &componentName,
-                                                                Mantid::API::IPeaksWorkspace_sptr &pws) const;
+  Mantid::API::IPeaksWorkspace_sptr transformInstrumentComponents(const std::string &componentName,
+                                                                  const Mantid::Kernel::V3D &shift,
+                                                                  const Mantid::Kernel::V3D &rotXYZ,
+                                                                  const Mantid::Kernel::V3D &sampleShift,
+                                                                  Mantid::API::IPeaksWorkspace_sptr &pws) const;
 
   Mantid::API::IPeaksWorkspace_sptr scaleRectagularDetectorSize(const double &scalex, const double &scaley,
                                                                 const std::string &componentName,
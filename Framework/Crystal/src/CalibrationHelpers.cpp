@@ -65,6 +65,14 @@ void adjustBankPositionsAndSizes(const std::vector<std::string> &bankNames, cons
                                  ComponentInfo &componentInfo) {
   std::shared_ptr<ParameterMap> pmap = newInstrument.getParameterMap();
 
+  std::vector<std::shared_ptr<const RectangularDetector>> banks;
+  std::vector<size_t> bankComponentIndices;
+  std::vector<V3D> newPositions;
+  std::vector<Quat> newRotations;
+  banks.reserve(bankNames.size());
+  bankComponentIndices.reserve(bankNames.size());
+  newPositions.reserve(bankNames.size());
+  newRotations.reserve(bankNames.size());
   for (const auto &bankName : bankNames) {
     std::shared_ptr<const IComponent> bank1 = newInstrument.getComponentByName(bankName);
     std::shared_ptr<const Geometry::RectangularDetector> bank =
@@ -72,16 +80,19 @@ void adjustBankPositionsAndSizes(const std::vector<std::string> &bankNames, cons
 
     Quat relRot = bank->getRelativeRot();
     Quat parentRot = bank->getParent()->getRotation();
-    Quat newRot = parentRot * rot * relRot;
-
-    const auto bankComponentIndex = componentInfo.indexOf(bank->getComponentID());
-    componentInfo.setRotation(bankComponentIndex, newRot);
+    newRotations.emplace_back(parentRot * rot * relRot);
 
     V3D rotatedPos = V3D(pos);
-    bank->getParent()->getRotation().rotate(rotatedPos);
+    parentRot.rotate(rotatedPos);
+    newPositions.emplace_back(rotatedPos + bank->getPos());
 
-    componentInfo.setPosition(bankComponentIndex, rotatedPos + bank->getPos());
+    bankComponentIndices.emplace_back(componentInfo.indexOf(bank->getComponentID()));
+    banks.emplace_back(std::move(bank));
+  }
+  // Move all banks, and the pixels within them, in a single pass
+  componentInfo.setPositionsAndRotations(bankComponentIndices, newPositions, newRotations);
 
+  for (const auto &bank : banks) {
     std::vector<double> oldScalex = pmap->getDouble(bank->getName(), std::string("scalex"));
     std::vector<double> oldScaley = pmap->getDouble(bank->getName(), std::string("scaley"));
 
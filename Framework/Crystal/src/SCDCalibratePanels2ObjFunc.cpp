@@ -15,7 +15,9 @@
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidGeometry/Crystal/OrientedLattice.h"
 #include "MantidGeometry/Instrument.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/RectangularDetector.h"
+#include "MantidKernel/Quat.h"
 
 #include <boost/algorithm/string.hpp>
 #include <boost/math/special_functions/round.hpp>
@@ -123,18 +125,12 @@ void SCDCalibratePanels2ObjFunc::function1D(double *out, const double *xValues,
   //       -- For others, this will be none
   bool calibrateT0 = (m_cmpt == "none/sixteenpack") || (m_cmpt == "none");
   // we don't need to move the instrument if we are calibrating T0
-  if (!calibrateT0) {
+  if (!calibrateT0)
     pws = scaleRectagularDetectorSize(scalex, scaley, m_cmpt, pws);
 
-    // translation
-    pws = moveInstruentComponentBy(dx, dy, dz, m_cmpt, pws);
-
-    // rotation
-    pws = rotateInstrumentComponentBy(drx, dry, drz, m_cmpt, pws);
-  }
-
-  // tweak sample position
-  pws = moveInstruentComponentBy(dsx, dsy, dsz, "sample-position", pws);
+  // translate and rotate the component, and tweak the sample position
+  pws = transformInstrumentComponents(calibrateT0 ? "" : m_cmpt, V3D(dx, dy, dz), V3D(drx, dry, drz),
+                                      V3D(dsx, dsy, dsz), pws);
 
   // calculate residual
   // double residual = 0.0;
@@ -188,86 +184,57 @@ void SCDCalibratePanels2ObjFunc::function1D(double *out, const double *xValues,
 // -------///
 
 /**
- * @brief Translate the component of given workspace by delta_(x, y, z)
+ * @brief Translate and rotate a component and translate the sample, all
+ * relative to their current placement, in a single geometry update
  *
- * @param deltaX  :: The shift along the X-axis in m
- * @param deltaY  :: The shift along the Y-axis in m
- * @param deltaZ  :: The shift along the Z-axis in m
- * @param componentName  :: string representation of a component
- * @param pws  :: input workspace (mostly peaksworkspace)
- */
-IPeaksWorkspace_sptr SCDCalibratePanels2ObjFunc::moveInstruentComponentBy(double deltaX, double deltaY, double deltaZ,
-                                                                          const std::string &componentName,
-                                                                          IPeaksWorkspace_sptr &pws) const {
-  // Workspace_sptr inputws = std::dynamic_pointer_cast<Workspace>(pws);
-
-  // move instrument is really fast, even with zero input
-  auto mv_alg = Mantid::API::AlgorithmFactory::Instance().create("MoveInstrumentComponent", -1);
-  mv_alg->initialize();
-  mv_alg->setChild(true);
-  mv_alg->setLogging(LOGCHILDALG);
-  mv_alg->setProperty("Workspace", pws);
-  mv_alg->setProperty("ComponentName", componentName);
-  mv_alg->setProperty("X", deltaX);
-  mv_alg->setProperty("Y", deltaY);
-  mv_alg->setProperty("Z", deltaZ);
-  mv_alg->setProperty("RelativePosition", true);
-  mv_alg->executeAsChildAlg();
-
-  return pws;
-}
-
-/**
- * @brief Rotate the instrument by angle axis
+ * This gives the same geometry as MoveInstrumentComponent followed by
+ * RotateInstrumentComponent around X, Y and Z with RelativePosition and
+ * RelativeRotation set, plus a relative MoveInstrumentComponent of the sample,
+ * but the detectors of the component are only recomputed once.
  *
- * @param rotX  :: rotate around X
- * @param rotY  :: rotate around Y
- * @param rotZ  :: rotate around Z
- * @param componentName  :: component name
+ * @param componentName  :: name of the component to move, empty to only move the sample
+ * @param shift  :: the shift of the component in m
+ * @param rotXYZ  :: the rotations around X, then Y, then Z in degrees
+ * @param sampleShift  :: the shift of the sample in m
  * @param pws  :: peak workspace
  * @return IPeaksWorkspace_sptr
  */
-IPeaksWorkspace_sptr SCDCalibratePanels2ObjFunc::rotateInstrumentComponentBy(double rotX, double rotY, double rotZ,
-                                                                             const std::string &componentName,
-                                                                             IPeaksWorkspace_sptr &pws) const {
-  // rotate
-  auto rot_alg = Mantid::API::AlgorithmFactory::Instance().create("RotateInstrumentComponent", -1);
-  // around X
-  rot_alg->initialize();
-  rot_alg->setChild(true);
-  rot_alg->setLogging(LOGCHILDALG);
-  rot_alg->setProperty("Workspace", pws);
-  rot_alg->setProperty("ComponentName", componentName);
-  rot_alg->setProperty("X", 1.0);
-  rot_alg->setProperty("Y", 0.0);
-  rot_alg->setProperty("Z", 0.0);
-  rot_alg->setProperty("Angle", rotX);
-  rot_alg->setProperty("RelativeRotation", true);
-  rot_alg->executeAsChildAlg();
-  // around Y
-  rot_alg->initialize();
-  rot_alg->setChild(true);
-  rot_alg->setLogging(LOGCHILDALG);
-  rot_alg->setProperty("Workspace", pws);
-  rot_alg->setProperty("ComponentName", componentName);
-  rot_alg->setProperty("X", 0.0);
-  rot_alg->setProperty("Y", 1.0);
-  rot_alg->setProperty("Z", 0.0);
-  rot_alg->setProperty("Angle", rotY);
-  rot_alg->setProperty("RelativeRotation", true);
-  rot_alg->executeAsChildAlg();
-  // around Z
-  rot_alg->initialize();
-  rot_alg->setChild(true);
-  rot_alg->setLogging(LOGCHILDALG);
-  rot_alg->setProperty("Workspace", pws);
-  rot_alg->setProperty("ComponentName", componentName);
-  rot_alg->setProperty("X", 0.0);
-  rot_alg->setProperty("Y", 0.0);
-  rot_alg->setProperty("Z", 1.0);
-  rot_alg->setProperty("Angle", rotZ);
-  rot_alg->setProperty("RelativeRotation", true);
-  rot_alg->executeAsChildAlg();
+IPeaksWorkspace_sptr SCDCalibratePanels2ObjFunc::transformInstrumentComponents(const std::string &componentName,
+                                                                               const V3D &shift, const V3D &rotXYZ,
+                                                                               const V3D &sampleShift,
+                                                                               IPeaksWorkspace_sptr &pws) const {
+  auto &componentInfo = pws->mutableComponentInfo();
+  std::vector<size_t> indices;
+  std::vector<V3D> positions;
+  std::vector<Quat> rotations;
+  if (!componentName.empty()) {
+    const auto comp = pws->getInstrument()->getComponentByName(componentName);
+    if (!comp)
+      throw std::runtime_error("Component with name " + componentName + " was not found.");
+    const auto index = componentInfo.indexOf(comp->getComponentID());
+    indices.emplace_back(index);
+    positions.emplace_back(componentInfo.position(index) + shift);
+    // Note the order, as in RotateInstrumentComponent with RelativeRotation
+    rotations.emplace_back(componentInfo.rotation(index) * Quat(rotXYZ.X(), V3D(1, 0, 0)) *
+                           Quat(rotXYZ.Y(), V3D(0, 1, 0)) * Quat(rotXYZ.Z(), V3D(0, 0, 1)));
+  }
+
+  // the sample is shifted after the component, so a sample within it is
+  // shifted again from where the component takes it
+  const auto sampleIndex = componentInfo.sample();
+  bool sampleInComponent = !indices.empty() && indices.front() == sampleIndex;
+  for (auto index = sampleIndex; !indices.empty() && !sampleInComponent && componentInfo.hasParent(index);) {
+    index = componentInfo.parent(index);
+    sampleInComponent = index == indices.front();
+  }
+  if (!sampleInComponent) {
+    indices.emplace_back(sampleIndex);
+    positions.emplace_back(componentInfo.position(sampleIndex) + sampleShift);
+    rotations.emplace_back(componentInfo.rotation(sampleIndex));
+  }
+  componentInfo.setPositionsAndRotations(indices, positions, rotations);
+  if (sampleInComponent)
+    componentInfo.setPosition(sampleIndex, componentInfo.position(sampleIndex) + sampleShift);
 
   return pws;
 }
@@ -235,6 +235,53 @@ public:
     }
   }
 
+  /**
+   * @brief shifting and rotating through the parameters gives the same geometry
+   * as moving and rotating the bank and sample with the instrument algorithms
+   */
+  void test_shift_and_rotation_match_instrument_algorithms() {
+    PeaksWorkspace_sptr pws = m_pws->clone();
+    Mantid::API::IPeaksWorkspace_sptr ipws = std::dynamic_pointer_cast<Mantid::API::IPeaksWorkspace>(pws);
+    const std::string bankname = "bank27";
+    std::vector<double> tofs;
+    for (int i = 0; i < pws->getNumberPeaks(); ++i)
+      tofs.emplace_back(pws->getPeak(i).getTOF());
+    const int n_peaks = pws->getNumberPeaks();
+    double useless[5];
+    size_t order(1000);
+
+    SCDCalibratePanels2ObjFunc testfunc;
+    testfunc.initialize();
+    testfunc.setPeakWorkspace(ipws, bankname, tofs);
+    testfunc.setParameter("DeltaX", 1.1e-3);
+    testfunc.setParameter("DeltaY", -0.9e-3);
+    testfunc.setParameter("DeltaZ", 1.5e-3);
+    testfunc.setParameter("RotX", 0.3);
+    testfunc.setParameter("RotY", -0.2);
+    testfunc.setParameter("RotZ", 0.5);
+    testfunc.setParameter("DeltaSampleX", 2e-4);
+    testfunc.setParameter("DeltaSampleY", -1e-4);
+    testfunc.setParameter("DeltaSampleZ", 3e-4);
+    std::unique_ptr<double[]> out(new double[n_peaks * 3]);
+    testfunc.function1D(out.get(), useless, order);
+
+    // the same moves through the algorithms, then evaluated without any change
+    PeaksWorkspace_sptr movedpws = m_pws->clone();
+    adjustComponent(1.1e-3, -0.9e-3, 1.5e-3, 1, 0, 0, 0.3, bankname, movedpws);
+    adjustComponent(0, 0, 0, 0, 1, 0, -0.2, bankname, movedpws);
+    adjustComponent(0, 0, 0, 0, 0, 1, 0.5, bankname, movedpws);
+    adjustComponent(2e-4, -1e-4, 3e-4, 1, 0, 0, 0, "sample-position", movedpws);
+    Mantid::API::IPeaksWorkspace_sptr movedipws = std::dynamic_pointer_cast<Mantid::API::IPeaksWorkspace>(movedpws);
+    SCDCalibratePanels2ObjFunc reffunc;
+    reffunc.initialize();
+    reffunc.setPeakWorkspace(movedipws, bankname, tofs);
+    std::unique_ptr<double[]> expected(new double[n_peaks * 3]);
+    reffunc.function1D(expected.get(), useless, order);
+
+    for (int i = 0; i < n_peaks * 3; ++i)
+      TS_ASSERT_DELTA(out[i], expected[i], 1e-8);
+  }
+
 private:
   /**
    * @brief Adjust the position of a component through translation and rotation
@@ -13,6 +13,8 @@
 #include "MantidCurveFitting/Functions/BackgroundFunction.h"
 #include "MantidKernel/System.h"
 
+#include <unordered_map>
+
 namespace Mantid {
 namespace HistogramData {
 class HistogramX;
@@ -108,6 +110,23 @@ public:
   double getPeakMaximumValue(std::vector<int> hkl, const std::vector<double> &xvalues, size_t &ix);
 
 private:
+  /// Profile of a peak with unit height on the window of x values where it
+  /// is non-zero
+  struct PeakProfile {
+    /// Peak's parameter values the profile was calculated with
+    std::vector<double> parameters;
+    /// Index of the first x value of the window
+    size_t start = 0;
+    /// Profile values in the window
+    std::vector<double> values;
+  };
+
+  /// Make sure that the cached peak profiles are calculated on given x values
+  void setProfileCacheX(const std::vector<double> &xvalues) const;
+
+  /// Get the profile of a peak, recalculating it only if its parameters changed
+  const PeakProfile &getPeakProfile(const API::IPowderDiffPeakFunction_sptr &peak) const;
+
   /// Set peak parameters
   void setPeakParameters(const API::IPowderDiffPeakFunction_sptr &peak, const std::map<std::string, double> &parammap,
                          double peakheight, bool setpeakheight);
@@ -163,6 +182,13 @@ private:
   /// Has first value set up
   bool m_isInputValue;
 
+  /// Index of the peak height among the peak's parameters
+  size_t m_heightIndex;
+  /// X values the cached peak profiles are calculated on
+  mutable std::vector<double> m_profileCacheX;
+  /// Cached profiles of the peaks
+  mutable std::unordered_map<const API::IPowderDiffPeakFunction *, PeakProfile> m_profileCache;
+
   std::vector<double> heights;
 
   double m_minTOFPeakCentre;
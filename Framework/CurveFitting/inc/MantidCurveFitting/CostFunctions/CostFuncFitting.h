@@ -57,6 +57,8 @@ public:
   virtual double valDerivHessian(bool evalDeriv = true, bool evalHessian = true) const;
   const EigenVector &getDeriv() const;
   const EigenMatrix &getHessian() const;
+  /// Get the groups of parameters that form independent diagonal blocks of the Hessian
+  const std::vector<std::vector<size_t>> &getHessianBlocks() const { return m_hessianBlocks; }
   void push();
   void pop();
   void drop();
@@ -121,6 +123,10 @@ protected:
   mutable double m_value;
   mutable EigenVector m_der;
   mutable EigenMatrix m_hessian;
+  /// Groups of (local) parameters that couple in the Hessian only to each other
+  /// and to the parameters that are not in any group (global). Empty if the
+  /// structure of the Hessian is not known.
+  mutable std::vector<std::vector<size_t>> m_hessianBlocks;
 
   mutable bool m_pushed;
   mutable double m_pushedValue;
@@ -13,6 +13,13 @@
 #include "MantidCurveFitting/EigenMatrix.h"
 #include "MantidCurveFitting/EigenVector.h"
 
+namespace Mantid {
+namespace API {
+class CompositeDomain;
+class MultiDomainFunction;
+} // namespace API
+} // namespace Mantid
+
 namespace Mantid {
 namespace CurveFitting {
 namespace CostFunctions {
@@ -39,6 +46,9 @@ protected:
   void addValDerivHessian(API::IFunction_sptr function, API::FunctionDomain_sptr domain,
                           API::FunctionValues_sptr values, bool evalDeriv = true,
                           bool evalHessian = true) const override;
+  /// Increment the cost function and its derivatives domain by domain
+  void addValDerivHessianByDomain(const API::MultiDomainFunction &function, const API::CompositeDomain &domain,
+                                  API::FunctionValues_sptr values, bool evalHessian) const;
 
   /// Get mapped weights from FunctionValues
   virtual std::vector<double> getFitWeights(API::FunctionValues_sptr values) const;
@@ -106,6 +106,10 @@ public:
   /// Solve system of linear equations M*x == rhs, M is this matrix
   /// This matrix is destroyed.
   void solve(const EigenVector &rhs, EigenVector &x);
+  /// Solve system of linear equations M*x == rhs, where M has a block-arrow
+  /// structure
+  void solveBlockArrow(const std::vector<std::vector<size_t>> &blocks, const EigenVector &rhs,
+                       EigenVector &x) const;
   /// Invert this matrix
   void invert();
   /// Calculate the determinant
@@ -12,6 +12,9 @@
 #include "MantidCurveFitting/EigenVector.h"
 #include "MantidKernel/System.h"
 
+#include <memory>
+#include <random>
+
 namespace Mantid {
 namespace CurveFitting {
 namespace CostFunctions {
@@ -51,6 +54,12 @@ public:
   void boundApplication(const size_t &parameterIndex, double &newValue, double &step);
 
 private:
+  /// Do one iteration of this chain only
+  bool iterateChain();
+  /// Create the additional chains run in parallel with this one
+  void initExtraChains(size_t nExtraChains, size_t maxIterations);
+  /// The random number generator used by this chain
+  std::mt19937 &randomGenerator();
   /// Returns the step from a Gaussian given sigma = Jump
   double gaussianStep(const double &jump);
   /// Applied to the other parameters first and sequentially, finally to the
@@ -89,11 +98,24 @@ private:
   /// Output parameter table
   void outputParameterTable(const std::vector<double> &bestParameters, const std::vector<double> &errorsLeft,
                             const std::vector<double> &errorsRight);
+  /// Output the convergence diagnostic and the parameters of each chain
+  void outputChainDiagnostics(const std::vector<double> &rHat,
+                              const std::vector<std::vector<std::vector<double>>> &chainParameters);
   /// Calculated converged chain and parameters
   void calculateConvChainAndBestParameters(size_t convLength, int nSteps,
                                            std::vector<std::vector<double>> &reducedChain,
                                            std::vector<double> &bestParameters, std::vector<double> &errorLeft,
                                            std::vector<double> &errorRight);
+  /// Calculate the combined converged chain of all chains and parameters
+  void calculateCombinedChainAndBestParameters(size_t convLength, int nSteps,
+                                               std::vector<std::vector<double>> &reducedChain,
+                                               std::vector<double> &bestParameters, std::vector<double> &errorLeft,
+                                               std::vector<double> &errorRight);
+  /// Take every nSteps-th point of the converged chain
+  void reduceConvergedChain(size_t convLength, int nSteps, std::vector<std::vector<double>> &reducedChain) const;
+  /// Calculate the best parameters and errors from a reduced chain
+  void calculateBestParameters(std::vector<std::vector<double>> &reducedChain, std::vector<double> &bestParameters,
+                               std::vector<double> &errorLeft, std::vector<double> &errorRight);
   /// Initialize member variables related to fitting parameters
   void initChainsAndParameters();
   /// Initialize member variables related to simulated annealing
@@ -151,6 +173,12 @@ private:
   std::vector<size_t> m_numInactiveRegenerations;
   /// To track convergence through immobility
   std::vector<int> m_changesOld;
+  /// Additional chains run in parallel with this one
+  std::vector<std::unique_ptr<FABADAMinimizer>> m_extraChains;
+  /// Flags for the chains (this one first) which haven't finished yet
+  std::vector<int> m_chainRunning;
+  /// Random number generator of an additional chain
+  std::unique_ptr<std::mt19937> m_randomGenerator;
 };
 
 /// Used to access the setDirty() protected member
@@ -131,6 +131,13 @@ private:
   /// step in xValues) when in FFT mode, and the inverted resolution if in
   /// Direct mode
   mutable std::vector<double> m_resolution;
+  /// The resolution function evaluated on m_resolutionDomain, for adding
+  /// unshifted delta functions in FFT mode
+  mutable std::vector<double> m_resolutionOnDomain;
+  /// The x values and resolution parameters m_resolutionOnDomain was
+  /// evaluated with
+  mutable std::vector<double> m_resolutionDomain;
+  mutable std::vector<double> m_resolutionParameters;
   void innerFunctionsAre1D() const;
 };
 
@@ -62,10 +62,12 @@ private:
   std::string m_formula;
   /// extended muParser instance
   mu::Parser *m_parser;
-  /// Used as 'x' variable in m_parser.
+  /// Used as 'x' variable while the formula's variables are declared
   mutable double m_x;
   /// True indicates that input formula contains 'x' variable
   bool m_x_set;
+  /// Values of m_parser's variables for bulk evaluation
+  mutable std::vector<double> m_bulkValues;
   /// Temporary data storage used in functionDeriv
   mutable std::vector<double> m_tmp;
   /// Temporary data storage used in functionDeriv
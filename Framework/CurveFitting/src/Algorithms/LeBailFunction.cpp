@@ -13,6 +13,7 @@
 #include "MantidHistogramData/HistogramY.h"
 #include "MantidKernel/System.h"
 
+#include <algorithm>
 #include <sstream>
 #include <utility>
 
@@ -67,6 +68,7 @@ LeBailFunction::LeBailFunction(const std::string &peaktype) {
   }
 
   m_peakParameterNameVec = peakfunc->getParameterNames();
+  m_heightIndex = peakfunc->parameterIndex("Height");
   m_orderedProfileParameterNames = m_peakParameterNameVec;
   sort(m_orderedProfileParameterNames.begin(), m_orderedProfileParameterNames.end());
 
@@ -110,12 +112,16 @@ HistogramY LeBailFunction::function(const Mantid::HistogramData::HistogramX &xva
 
   // Peaks
   if (calpeaks) {
+    // Only add each peak within its window.  Peaks with unchanged parameters
+    // are taken from the cache.
+    setProfileCacheX(xvals);
     for (size_t ipk = 0; ipk < m_numPeaks; ++ipk) {
-      // Reset temporary vector for output
-      vector<double> temp(xvalues.size(), 0);
-      IPowderDiffPeakFunction_sptr peak = m_vecPeaks[ipk];
-      peak->function(temp, xvals);
-      transform(out.begin(), out.end(), temp.begin(), out.begin(), ::plus<double>());
+      const IPowderDiffPeakFunction_sptr &peak = m_vecPeaks[ipk];
+      const PeakProfile &profile = getPeakProfile(peak);
+      const double height = peak->height();
+      auto outiter = out.begin() + profile.start;
+      transform(profile.values.cbegin(), profile.values.cend(), outiter, outiter,
+                [height](double value, double sum) { return sum + height * value; });
     }
   }
 
@@ -154,6 +160,58 @@ HistogramY LeBailFunction::calPeak(size_t ipk, const std::vector<double> &xvalue
   return HistogramY(out);
 }
 
+//----------------------------------------------------------------------------------------------
+/** Make sure that the cached peak profiles are calculated on given x values.
+ * The cache is dropped if the x values differ from the previous ones.
+ * @param xvalues :: x values to calculate the peaks on
+ */
+void LeBailFunction::setProfileCacheX(const std::vector<double> &xvalues) const {
+  if (xvalues != m_profileCacheX) {
+    m_profileCacheX = xvalues;
+    m_profileCache.clear();
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Get the profile of a peak with unit height on the x values set by
+ * setProfileCacheX().  The profile is only evaluated within PEAKRANGECONSTANT
+ * FWHMs of the peak centre and it is recalculated only if any of the peak's
+ * parameters other than its height changed since the last call.
+ * @param peak :: peak function
+ * @return :: the cached profile
+ */
+const LeBailFunction::PeakProfile &LeBailFunction::getPeakProfile(const IPowderDiffPeakFunction_sptr &peak) const {
+  PeakProfile &profile = m_profileCache[peak.get()];
+
+  const size_t numparams = peak->nParams();
+  bool changed = profile.parameters.size() != numparams;
+  for (size_t i = 0; i < numparams && !changed; ++i) {
+    changed = i != m_heightIndex && peak->getParameter(i) != profile.parameters[i];
+  }
+  if (!changed)
+    return profile;
+
+  profile.parameters.resize(numparams);
+  for (size_t i = 0; i < numparams; ++i)
+    profile.parameters[i] = peak->getParameter(i);
+
+  // Locate the window of x values where the peak is non-zero
+  const double centre = peak->centre();
+  const double range = PEAKRANGECONSTANT * peak->fwhm();
+  auto left = lower_bound(m_profileCacheX.cbegin(), m_profileCacheX.cend(), centre - range);
+  auto right = lower_bound(left, m_profileCacheX.cend(), centre + range);
+  profile.start = static_cast<size_t>(left - m_profileCacheX.cbegin());
+  const vector<double> windowx(left, right);
+  profile.values.assign(windowx.size(), 0.0);
+
+  const double height = peak->height();
+  peak->setHeight(1.0);
+  peak->function(profile.values, windowx);
+  peak->setHeight(height);
+
+  return profile;
+}
+
 //----------------------------------------------------------------------------------------------
 /** Check whether a parameter is a profile parameter
  * @param paramname :: parameter name to check with
@@ -284,6 +342,10 @@ void LeBailFunction::addPeaks(std::vector<std::vector<int>> peakhkls) {
 
   m_numPeaks = m_vecPeaks.size();
 
+  // Keep the peaks sorted by d-spacing so that they need not be sorted again
+  // each time they are grouped
+  sort(m_dspPeakVec.begin(), m_dspPeakVec.end());
+
   g_log.information() << "Total " << m_numPeaks << " after trying to add " << peakhkls.size() << " peaks. \n";
 } // END of addPeaks()
 
@@ -325,6 +387,7 @@ bool LeBailFunction::calculatePeaksIntensities(const vector<double> &vecX, const
                                                vector<double> &vec_summedpeaks) {
   // Clear inputs
   std::fill(vec_summedpeaks.begin(), vec_summedpeaks.end(), 0.0);
+  setProfileCacheX(vecX);
 
   // Divide peaks into groups from peak's parameters
   vector<vector<pair<double, IPowderDiffPeakFunction_sptr>>> peakgroupvec;
@@ -474,7 +537,12 @@ bool LeBailFunction::calculateGroupPeakIntensities(vector<pair<double, IPowderDi
     IPowderDiffPeakFunction_sptr peak = peakgroup[ipk].second;
     peak->setHeight(1.0);
     vector<double> localpeakvalue(ndata, 0.0);
-    peak->function(localpeakvalue, datax);
+    // Copy the part of the (cached) peak's profile within the group's range
+    const PeakProfile &profile = getPeakProfile(peak);
+    const size_t first = std::max(profile.start, ileft);
+    const size_t last = std::min(profile.start + profile.values.size(), iright);
+    for (size_t i = first; i < last; ++i)
+      localpeakvalue[i - ileft] = profile.values[i - profile.start];
 
     // check data
     const auto numbadpts = std::count_if(localpeakvalue.cbegin(), localpeakvalue.cend(), [&](const auto &pt) {
@@ -698,10 +766,8 @@ void LeBailFunction::setProfileParameterValues(map<std::string, double> parammap
  */
 void LeBailFunction::groupPeaks(vector<vector<pair<double, IPowderDiffPeakFunction_sptr>>> &peakgroupvec,
                                 vector<IPowderDiffPeakFunction_sptr> &outboundpeakvec, double xmin, double xmax) {
-  // Sort peaks
-  if (m_numPeaks > 1) {
-    sort(m_dspPeakVec.begin(), m_dspPeakVec.end());
-  } else if (m_numPeaks == 0) {
+  // Peaks are sorted by d-spacing when they are added
+  if (m_numPeaks == 0) {
     std::stringstream errmsg;
     errmsg << "Group peaks:  No peak is found in the peak vector. ";
     g_log.error() << errmsg.str() << "\n";
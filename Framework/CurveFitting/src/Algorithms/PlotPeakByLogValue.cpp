@@ -33,6 +33,7 @@
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/MandatoryValidator.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 
 namespace {
@@ -92,6 +93,11 @@ void PlotPeakByLogValue::init() {
                   "If set to 'Individual' each fit starts with the same "
                   "initial values defined in the Function property.");
 
+  declareProperty("Parallel", false,
+                  "If true and FitType is 'Individual' the spectra are fitted "
+                  "concurrently, each with its own copy of the function. \n"
+                  "Ignored for 'Sequential' fits and multi-domain functions.");
+
   declareProperty("PassWSIndexToFunction", false,
                   "For each spectrum in Input pass its workspace index to all "
                   "functions that"
@@ -182,6 +188,7 @@ void PlotPeakByLogValue::exec() {
 
   std::string logName = getProperty("LogValue");
   bool individual = getPropertyValue("FitType") == "Individual";
+  bool parallel = getProperty("Parallel");
   bool passWSIndexToFunction = getProperty("PassWSIndexToFunction");
   bool createFitOutput = getProperty("CreateOutput");
   bool outputCompositeMembers = getProperty("OutputCompositeMembers");
@@ -231,8 +238,39 @@ void PlotPeakByLogValue::exec() {
     fitChiSquared.reserve(wsNames.size());
   }
 
+  // the fitting range of the i-th input
+  auto fitRange = [&startX, &endX](const int i) -> std::pair<double, double> {
+    if (startX.empty())
+      return {EMPTY_DBL(), EMPTY_DBL()};
+    if (startX.size() == 1)
+      return {startX[0], endX[0]};
+    return {startX[i], endX[i]};
+  };
+
+  // Fits starting from the same initial values do not depend on each other,
+  // so they can run concurrently if each has its own copy of the function.
+  const bool runInParallel = parallel && individual && !isMultiDomainFunction;
+  std::vector<std::shared_ptr<Algorithm>> parallelFits(runInParallel ? wsNames.size() : 0);
+  if (runInParallel) {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
+      PARALLEL_START_INTERRUPT_REGION
+      const InputSpectraToFit &data = wsNames[i];
+      if (data.ws && data.i >= 0) {
+        IFunction_sptr ifun = setupFunction(individual, passWSIndexToFunction, inputFunction->clone(), initialParams,
+                                            isMultiDomainFunction, i, data);
+        const auto range = fitRange(i);
+        parallelFits[i] = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data,
+                                       range.first, range.second, exclude[i]);
+      }
+      PARALLEL_END_INTERRUPT_REGION
+    }
+    PARALLEL_CHECK_INTERRUPT_REGION
+  }
+
   double dProg = 1. / static_cast<double>(wsNames.size());
   double Prog = 0.;
+  IFunction_sptr lastFitFunction;
   for (int i = 0; i < static_cast<int>(wsNames.size()); ++i) {
     InputSpectraToFit data = wsNames[i];
 
@@ -246,21 +284,19 @@ void PlotPeakByLogValue::exec() {
       continue;
     }
 
-    IFunction_sptr ifun =
-        setupFunction(individual, passWSIndexToFunction, inputFunction, initialParams, isMultiDomainFunction, i, data);
     std::shared_ptr<Algorithm> fit;
-    if (startX.size() == 0) {
-      fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, EMPTY_DBL(),
-                         EMPTY_DBL(), exclude[i]);
-    } else if (startX.size() == 1) {
-      fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, startX[0],
-                         endX[0], exclude[i]);
+    if (runInParallel) {
+      fit = std::move(parallelFits[i]);
     } else {
-      fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, startX[i],
-                         endX[i], exclude[i]);
+      IFunction_sptr ifun = setupFunction(individual, passWSIndexToFunction, inputFunction, initialParams,
+                                          isMultiDomainFunction, i, data);
+      const auto range = fitRange(i);
+      fit = runSingleFit(createFitOutput, outputCompositeMembers, outputConvolvedMembers, ifun, data, range.first,
+                         range.second, exclude[i]);
     }
 
-    ifun = fit->getProperty("Function");
+    IFunction_sptr ifun = fit->getProperty("Function");
+    lastFitFunction = ifun;
     double chi2 = fit->getProperty("OutputChi2overDoF");
 
     if (createFitOutput) {
@@ -289,6 +325,14 @@ void PlotPeakByLogValue::exec() {
     interruption_point();
   }
 
+  // As for the serial fits, leave the input function with the results of the last one
+  if (runInParallel && lastFitFunction) {
+    for (size_t k = 0; k < inputFunction->nParams(); ++k) {
+      inputFunction->setParameter(k, lastFitFunction->getParameter(k));
+      inputFunction->setError(k, lastFitFunction->getError(k));
+    }
+  }
+
   if (outputFitStatus) {
     setProperty("OutputStatus", fitStatus);
     setProperty("OutputChiSquared", fitChiSquared);
@@ -545,7 +589,9 @@ std::string PlotPeakByLogValue::getMinimizerString(const std::string &wsName, co
       const std::string &wsPropValue = minimizerProp->value();
       if (!wsPropValue.empty()) {
         const std::string &wsPropName = minimizerProp->name();
-        m_minimizerWorkspaces[wsPropName].emplace_back(wsPropValue);
+        PARALLEL_CRITICAL(PlotPeakByLogValue_minimizerWorkspaces) {
+          m_minimizerWorkspaces[wsPropName].emplace_back(wsPropValue);
+        }
       }
     }
   }
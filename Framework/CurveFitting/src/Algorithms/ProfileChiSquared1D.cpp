@@ -14,8 +14,12 @@
 #include "MantidCurveFitting/Algorithms/CalculateChiSquared.h"
 #include "MantidCurveFitting/Algorithms/Fit.h"
 #include "MantidCurveFitting/EigenJacobian.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <boost/math/distributions/chi_squared.hpp>
+#include <array>
+#include <iterator>
+#include <map>
 #include <utility>
 
 namespace {
@@ -55,12 +59,12 @@ public:
   /// @param inputWS :: The input workspace (used for fit algorithm)
   /// @param workspaceIndex :: Workspace index (used for fit algorithm)
   /// @param domain :: Function's domain.
-  /// @param values :: Functin's values.
+  /// @param values :: Functin's values (copied so that slices can be evaluated concurrently).
   /// @param chi0 :: Chi squared at the minimum.
   /// @param freeParameters :: Parameters which are free in the function.
   ChiSlice(IFunction_sptr inputFunction, int fixedParameterIndex, API::MatrixWorkspace_sptr inputWS, int workspaceIndex,
-           const API::FunctionDomain &domain, API::FunctionValues &values, double chi0,
-           std::vector<int> &freeParameters)
+           const API::FunctionDomain &domain, const API::FunctionValues &values, double chi0,
+           const std::vector<int> &freeParameters)
       : m_fixedParameterIndex(fixedParameterIndex), m_domain(domain), m_values(values), m_chi0(chi0),
         m_fitalg(AlgorithmFactory::Instance().create("Fit", -1)), m_function(std::move(inputFunction)),
         m_ws(std::move(inputWS)), m_workspaceIndex(workspaceIndex), m_freeParameters(freeParameters) {
@@ -81,6 +85,12 @@ public:
     for (auto ip = 0u; ip < function->nParams(); ++ip) {
       originalParamValues[ip] = function->getParameter(ip);
     }
+    // Warm start from the solution at the nearest point evaluated so far
+    if (const auto *start = nearestSolution(p)) {
+      for (auto ip = 0u; ip < function->nParams(); ++ip) {
+        function->setParameter(ip, (*start)[ip]);
+      }
+    }
     function->setParameter(m_fixedParameterIndex, originalParamValues[m_fixedParameterIndex] + p);
     function->fix(m_fixedParameterIndex);
 
@@ -91,6 +101,12 @@ public:
     // just fixed
     int numFreeParameters = static_cast<int>(m_freeParameters.size() - 1);
     double res = getDiff(*function, numFreeParameters, m_domain, m_values, m_chi0);
+    // remember the solution as a starting point for the neighbouring points
+    std::vector<double> solution(function->nParams());
+    for (auto ip = 0u; ip < function->nParams(); ++ip) {
+      solution[ip] = function->getParameter(ip);
+    }
+    m_solutions[p] = std::move(solution);
     // reset fit to original values
     for (auto ip = 0u; ip < function->nParams(); ++ip) {
       function->setParameter(ip, originalParamValues[ip]);
@@ -155,12 +171,30 @@ public:
   }
 
 private:
+  /// Find the fitted parameters at the evaluated point closest to p.
+  /// @param p :: A distance from the minimum.
+  /// @return :: A pointer to the parameters or nullptr if nothing has been evaluated yet.
+  const std::vector<double> *nearestSolution(double p) const {
+    if (m_solutions.empty()) {
+      return nullptr;
+    }
+    auto upper = m_solutions.lower_bound(p);
+    if (upper == m_solutions.end()) {
+      return &std::prev(upper)->second;
+    }
+    if (upper == m_solutions.begin()) {
+      return &upper->second;
+    }
+    auto lower = std::prev(upper);
+    return p - lower->first <= upper->first - p ? &lower->second : &upper->second;
+  }
+
   // Fixed parameter index
   int m_fixedParameterIndex;
   /// The domain
   const API::FunctionDomain &m_domain;
   /// The values
-  API::FunctionValues &m_values;
+  API::FunctionValues m_values;
   /// The chi squared at the minimum
   double m_chi0;
   // fitting algorithm
@@ -171,6 +205,8 @@ private:
   int m_workspaceIndex;
   // Vector of free parameter indices
   std::vector<int> m_freeParameters;
+  /// Fitted parameters at each evaluated distance from the minimum
+  std::map<double, std::vector<double>> m_solutions;
 }; // namespace Algorithms
 
 /// Default constructor
@@ -185,7 +221,12 @@ const std::string ProfileChiSquared1D::summary() const {
          "for the input function.";
 }
 
-void ProfileChiSquared1D::initConcrete() { declareProperty("Output", "", "A base name for output workspaces."); }
+void ProfileChiSquared1D::initConcrete() {
+  declareProperty("Output", "", "A base name for output workspaces.");
+  declareProperty("Parallel", false,
+                  "If true the parameters are profiled concurrently, each with "
+                  "its own copy of the function.");
+}
 
 void ProfileChiSquared1D::execConcrete() {
   // Number of fiting parameters
@@ -267,21 +308,31 @@ void ProfileChiSquared1D::execConcrete() {
   pdfTable->setRowCount(n);
   const double fac = 1e-4;
 
+  // Add columns for the parameters to the pdf table: parameter values, chi
+  // squared values and PDF values
+  std::vector<std::array<API::Column_sptr, 3>> pdfColumns;
   for (auto p = 0u; p < freeParameters.size(); ++p) {
-    int row = p;
-    int ip = freeParameters[p];
-    // Add columns for the parameter to the pdf table.
-    auto parName = m_function->parameterName(ip);
-    nameColumn->read(row, parName);
-    // Parameter values
+    auto parName = m_function->parameterName(freeParameters[p]);
+    nameColumn->read(p, parName);
     auto col1 = pdfTable->addColumn("double", parName);
     col1->setPlotType(1);
-    // Chi squared values
     auto col2 = pdfTable->addColumn("double", parName + "_chi2");
     col2->setPlotType(2);
-    // PDF values
     auto col3 = pdfTable->addColumn("double", parName + "_pdf");
     col3->setPlotType(2);
+    pdfColumns.push_back({col1, col2, col3});
+  }
+
+  const bool parallel = getProperty("Parallel");
+  const auto nFreeParameters = static_cast<int>(freeParameters.size());
+  PARALLEL_FOR_IF(parallel)
+  for (int p = 0; p < nFreeParameters; ++p) {
+    PARALLEL_START_INTERRUPT_REGION
+    int row = p;
+    int ip = freeParameters[p];
+    auto &col1 = pdfColumns[p][0];
+    auto &col2 = pdfColumns[p][1];
+    auto &col3 = pdfColumns[p][2];
 
     double par0 = m_function->getParameter(ip);
     double shift = fabs(par0 * fac);
@@ -289,8 +340,10 @@ void ProfileChiSquared1D::execConcrete() {
       shift = fac;
     }
 
-    // Make a slice along this parameter
-    ChiSlice slice(m_function, ip, inputws, workspaceIndex, *domain, *values, chi0, freeParameters);
+    // Make a slice along this parameter. Concurrent slices need their own
+    // copies of the function.
+    auto function = parallel ? m_function->clone() : m_function;
+    ChiSlice slice(function, ip, inputws, workspaceIndex, *domain, *values, chi0, freeParameters);
 
     // Find the bounds withn which the PDF is significantly above zero.
     // The bounds are defined relative to par0:
@@ -355,8 +408,10 @@ void ProfileChiSquared1D::execConcrete() {
       col3->fromDouble(i, exp(-chi + chiMin));
     }
     // reset parameter values back to original value
-    m_function->setParameter(ip, par0);
+    function->setParameter(ip, par0);
+    PARALLEL_END_INTERRUPT_REGION
   }
+  PARALLEL_CHECK_INTERRUPT_REGION
 
   // Square roots of the diagonals of the covariance matrix give
   // the standard deviations in the quadratic approximation of the chi^2.
@@ -429,6 +429,10 @@ void QENSFitSequential::init() {
                   "the Function property. Allowed values: [Sequential, Individual]",
                   Kernel::Direction::Input);
 
+  declareProperty("Parallel", false,
+                  "If true and FitType is Individual the spectra are fitted "
+                  "concurrently, each with its own copy of the function.");
+
   declareProperty(std::make_unique<ArrayProperty<double>>("Exclude", ""),
                   "A list of pairs of real numbers, defining the regions to "
                   "exclude from the fit.");
@@ -719,6 +723,7 @@ ITableWorkspace_sptr QENSFitSequential::performFit(const std::string &input, con
   const bool passWsIndex = getProperty("PassWSIndexToFunction");
   const bool ignoreInvalidData = getProperty("IgnoreInvalidData");
   const bool outputFitStatus = getProperty("OutputFitStatus");
+  const bool parallel = getProperty("Parallel");
   IFunction_sptr inputFunction = getProperty("Function");
 
   // Run PlotPeaksByLogValue
@@ -742,6 +747,7 @@ ITableWorkspace_sptr QENSFitSequential::performFit(const std::string &input, con
   plotPeaks->setProperty("LogValue", getPropertyValue("LogName"));
   plotPeaks->setProperty("EvaluationType", getPropertyValue("EvaluationType"));
   plotPeaks->setProperty("FitType", getPropertyValue("FitType"));
+  plotPeaks->setProperty("Parallel", parallel);
   plotPeaks->setProperty("CostFunction", getPropertyValue("CostFunction"));
   plotPeaks->setProperty("OutputFitStatus", outputFitStatus);
 
@@ -384,6 +384,7 @@ double CostFuncFitting::valDerivHessian(bool evalDeriv, bool evalHessian) const
     m_hessian.resize(numParams, numParams);
     m_hessian.zero();
   }
+  m_hessianBlocks.clear();
 
   auto seqDomain = std::dynamic_pointer_cast<SeqDomain>(m_domain);
 
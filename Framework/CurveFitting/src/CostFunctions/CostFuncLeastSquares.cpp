@@ -11,11 +11,14 @@
 #include "MantidAPI/CompositeDomain.h"
 #include "MantidAPI/FunctionValues.h"
 #include "MantidAPI/IConstraint.h"
+#include "MantidAPI/MultiDomainFunction.h"
 #include "MantidCurveFitting/Jacobian.h"
 #include "MantidCurveFitting/SeqDomain.h"
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MultiThreaded.h"
 
+#include <algorithm>
+#include <iterator>
 #include <sstream>
 
 namespace Mantid::CurveFitting::CostFunctions {
@@ -65,79 +68,231 @@ void CostFuncLeastSquares::addVal(API::FunctionDomain_sptr domain, API::Function
 void CostFuncLeastSquares::addValDerivHessian(API::IFunction_sptr function, API::FunctionDomain_sptr domain,
                                               API::FunctionValues_sptr values, bool evalDeriv, bool evalHessian) const {
   UNUSED_ARG(evalDeriv);
+  const auto multiDomainFunction = std::dynamic_pointer_cast<API::MultiDomainFunction>(function);
+  const auto compositeDomain = std::dynamic_pointer_cast<API::CompositeDomain>(domain);
+  if (multiDomainFunction && compositeDomain && !multiDomainFunction->getAttribute("NumDeriv").asBool()) {
+    addValDerivHessianByDomain(*multiDomainFunction, *compositeDomain, values, evalHessian);
+    return;
+  }
+
   function->function(*domain, *values);
   size_t np = function->nParams(); // number of parameters
   size_t ny = values->size();      // number of data points
   Jacobian jacobian(ny, np);
   function->functionDeriv(*domain, jacobian);
 
-  size_t iActiveP = 0;
-  double fVal = 0.0;
   std::vector<double> weights = getFitWeights(values);
 
-  for (size_t ip = 0; ip < np; ++ip) {
-    if (!function->isActive(ip))
-      continue;
+  // Indices of the active parameters that contribute to the derivatives
+  std::vector<size_t> activeParams;
+  for (size_t ip = 0; ip < np && activeParams.size() < m_der.size(); ++ip) {
+    if (function->isActive(ip))
+      activeParams.emplace_back(ip);
+  }
+  const auto na = static_cast<Eigen::Index>(activeParams.size());
+  // Without active parameters nothing is added, not even to the value
+  if (na == 0)
+    return;
+  const bool needHessian = evalHessian && m_hessian.size1() > 0;
+
+  // The data are split into blocks of rows. Each thread accumulates the
+  // gradient J^T r and the Hessian approximation J^T J of its blocks with
+  // dense matrix products. The partial sums are added in the order of the
+  // threads so that the result doesn't depend on thread timing.
+  const size_t blockSize = 4096;
+  const auto nBlocks = static_cast<int64_t>((ny + blockSize - 1) / blockSize);
+
+  struct PartialSums {
+    double fVal = 0.0;
+    Eigen::VectorXd der;
+    Eigen::MatrixXd hessian;
+  };
+  std::vector<PartialSums> partials(static_cast<size_t>(PARALLEL_GET_MAX_THREADS));
+  for (auto &partial : partials) {
+    partial.der = Eigen::VectorXd::Zero(na);
+    if (needHessian)
+      partial.hessian = Eigen::MatrixXd::Zero(na, na);
+  }
+
+  PRAGMA_OMP(parallel if (nBlocks > 1)) {
+    auto &partial = partials[static_cast<size_t>(PARALLEL_THREAD_NUMBER)];
+    Eigen::MatrixXd weightedJacobian;
+    Eigen::VectorXd residuals;
 
-    double d = 0.0;
-    for (size_t i = 0; i < ny; ++i) {
-      double calc = values->getCalculated(i);
-      double obs = values->getFitData(i);
-      double w = weights[i];
-      double y = (calc - obs) * w;
-      d += y * jacobian.get(i, ip) * w;
-      if (iActiveP == 0) {
-        fVal += y * y;
+    PRAGMA_OMP(for schedule(static))
+    for (int64_t iBlock = 0; iBlock < nBlocks; ++iBlock) {
+      const size_t start = static_cast<size_t>(iBlock) * blockSize;
+      const size_t end = std::min(start + blockSize, ny);
+      const auto nRows = static_cast<Eigen::Index>(end - start);
+      residuals.resize(nRows);
+      weightedJacobian.resize(nRows, na);
+      for (size_t i = start; i < end; ++i) {
+        const auto row = static_cast<Eigen::Index>(i - start);
+        const double w = weights[i];
+        residuals(row) = (values->getCalculated(i) - values->getFitData(i)) * w;
+        for (Eigen::Index a = 0; a < na; ++a) {
+          weightedJacobian(row, a) = jacobian.get(i, activeParams[a]) * w;
+        }
       }
+      partial.fVal += residuals.squaredNorm();
+      partial.der.noalias() += weightedJacobian.transpose() * residuals;
+      if (needHessian)
+        partial.hessian.selfadjointView<Eigen::Lower>().rankUpdate(weightedJacobian.transpose());
     }
-    PARALLEL_CRITICAL(der_set) {
-      double der = m_der.get(iActiveP);
-      m_der.set(iActiveP, der + d);
+  }
+
+  const auto nh = needHessian ? std::min(na, static_cast<Eigen::Index>(m_hessian.size1())) : 0;
+  for (auto &partial : partials) {
+    if (needHessian)
+      partial.hessian.triangularView<Eigen::StrictlyUpper>() = partial.hessian.transpose();
+  }
+  // A parallel domain calls this method from several threads at once
+  PARALLEL_CRITICAL(lsq_merge) {
+    for (const auto &partial : partials) {
+      m_value += 0.5 * partial.fVal;
+      m_der.mutator().head(na) += partial.der;
+      if (needHessian)
+        m_hessian.mutator().topLeftCorner(nh, nh) += partial.hessian.topLeftCorner(nh, nh);
     }
-    ++iActiveP;
+  }
+}
 
-    if (iActiveP >= m_der.size())
-      break;
+/**
+ * Update the cost function, derivatives and hessian of a MultiDomainFunction
+ * one member domain at a time. Only the parameters of the member functions
+ * applied to a domain are differentiated on it, so the full (mostly zero)
+ * Jacobian is never formed. The parameters that affect a single domain are
+ * recorded as independent blocks of the Hessian.
+ * @param function :: A MultiDomainFunction to use to calculate the value and the derivatives
+ * @param domain :: The composite domain of the function.
+ * @param values :: The fit function values
+ * @param evalHessian :: Flag to evaluate the Hessian
+ */
+void CostFuncLeastSquares::addValDerivHessianByDomain(const API::MultiDomainFunction &function,
+                                                      const API::CompositeDomain &domain,
+                                                      API::FunctionValues_sptr values, bool evalHessian) const {
+  function.function(domain, *values);
+  const size_t ny = values->size();
+  const size_t np = function.nParams();
+  const size_t nDomains = domain.getNParts();
+  const bool needHessian = evalHessian && m_hessian.size1() > 0;
+  std::vector<double> weights = getFitWeights(values);
+
+  // Cost function (active) index of each parameter or -1 if it isn't active
+  std::vector<int64_t> activeIndex(np, -1);
+  size_t nActive = 0;
+  for (size_t ip = 0; ip < np && nActive < m_der.size(); ++ip) {
+    if (function.isActive(ip))
+      activeIndex[ip] = static_cast<int64_t>(nActive++);
   }
 
-  PARALLEL_ATOMIC
-  m_value += 0.5 * fVal;
+  // Member functions applied to each domain
+  std::vector<std::vector<size_t>> domainFunctions(nDomains);
+  for (size_t iFun = 0; iFun < function.nFunctions(); ++iFun) {
+    std::vector<size_t> domains;
+    function.getDomainIndices(iFun, nDomains, domains);
+    for (auto iDomain : domains) {
+      domainFunctions[iDomain].emplace_back(iFun);
+    }
+  }
 
-  if (!evalHessian)
-    return;
+  double fVal = 0.0;
+  for (size_t i = 0; i < ny; ++i) {
+    const double y = (values->getCalculated(i) - values->getFitData(i)) * weights[i];
+    fVal += y * y;
+  }
+  // The sums over the domains are added to the cost function at the end
+  const auto nA = static_cast<Eigen::Index>(nActive);
+  Eigen::VectorXd derSum = Eigen::VectorXd::Zero(nA);
+  Eigen::MatrixXd hessianSum;
+  if (needHessian)
+    hessianSum = Eigen::MatrixXd::Zero(nA, nA);
 
-  size_t i1 = 0;                  // active parameter index
-  for (size_t i = 0; i < np; ++i) // over parameters
-  {
-    if (!function->isActive(i))
+  // Number of domains each active parameter affects
+  std::vector<size_t> nParameterDomains(nActive, 0);
+  std::vector<std::vector<size_t>> domainParameters(nDomains);
+  size_t valueOffset = 0;
+  for (size_t iDomain = 0; iDomain < nDomains; ++iDomain) {
+    const API::FunctionDomain &memberDomain = domain.getDomain(iDomain);
+    const size_t nyDomain = memberDomain.size();
+    // Columns of the Jacobian of this domain are the parameters of its functions
+    std::vector<size_t> columnOffsets;
+    size_t nColumns = 0;
+    for (auto iFun : domainFunctions[iDomain]) {
+      columnOffsets.emplace_back(nColumns);
+      nColumns += function.getFunction(iFun)->nParams();
+    }
+    if (nyDomain == 0 || nColumns == 0) {
+      valueOffset += nyDomain;
       continue;
-    size_t i2 = 0;                  // active parameter index
-    for (size_t j = 0; j <= i; ++j) // over ~ half of parameters
-    {
-      if (!function->isActive(j))
-        continue;
-      double d = 0.0;
-      for (size_t k = 0; k < ny; ++k) // over fitting data
-      {
-        double w = weights[k];
-        d += jacobian.get(k, i) * jacobian.get(k, j) * w * w;
+    }
+    Jacobian jacobian(nyDomain, nColumns);
+    std::vector<size_t> columns; // active columns
+    std::vector<size_t> active;  // cost function indices of the active columns
+    for (size_t k = 0; k < domainFunctions[iDomain].size(); ++k) {
+      const size_t iFun = domainFunctions[iDomain][k];
+      API::PartialJacobian partialJacobian(&jacobian, columnOffsets[k]);
+      function.getFunction(iFun)->functionDeriv(memberDomain, partialJacobian);
+      const size_t paramOffset = function.paramOffset(iFun);
+      for (size_t ip = 0; ip < function.getFunction(iFun)->nParams(); ++ip) {
+        const auto index = activeIndex[paramOffset + ip];
+        if (index < 0)
+          continue;
+        columns.emplace_back(columnOffsets[k] + ip);
+        active.emplace_back(static_cast<size_t>(index));
       }
-      PARALLEL_CRITICAL(hessian_set) {
-        double h = m_hessian.get(i1, i2);
-        m_hessian.set(i1, i2, h + d);
-        if (i1 != i2) {
-          m_hessian.set(i2, i1, h + d);
+    }
+
+    const auto na = static_cast<Eigen::Index>(active.size());
+    Eigen::MatrixXd weightedJacobian(static_cast<Eigen::Index>(nyDomain), na);
+    Eigen::VectorXd residuals(static_cast<Eigen::Index>(nyDomain));
+    for (size_t i = 0; i < nyDomain; ++i) {
+      const auto row = static_cast<Eigen::Index>(i);
+      const double w = weights[valueOffset + i];
+      residuals(row) = (values->getCalculated(valueOffset + i) - values->getFitData(valueOffset + i)) * w;
+      for (Eigen::Index a = 0; a < na; ++a) {
+        weightedJacobian(row, a) = jacobian.get(i, columns[a]) * w;
+      }
+    }
+    const Eigen::VectorXd der = weightedJacobian.transpose() * residuals;
+    for (Eigen::Index a = 0; a < na; ++a) {
+      derSum(static_cast<Eigen::Index>(active[a])) += der(a);
+      ++nParameterDomains[active[a]];
+    }
+    if (needHessian) {
+      const Eigen::MatrixXd hessian = weightedJacobian.transpose() * weightedJacobian;
+      for (Eigen::Index a = 0; a < na; ++a) {
+        for (Eigen::Index b = 0; b < na; ++b) {
+          hessianSum(static_cast<Eigen::Index>(active[a]), static_cast<Eigen::Index>(active[b])) += hessian(a, b);
         }
       }
-      ++i2;
+    }
+    domainParameters[iDomain] = std::move(active);
+    valueOffset += nyDomain;
+  }
 
-      if (i2 >= m_hessian.size2())
-        break;
+  // Parameters affecting only one domain are local to it
+  std::vector<std::vector<size_t>> hessianBlocks;
+  for (const auto &parameters : domainParameters) {
+    std::vector<size_t> block;
+    std::copy_if(parameters.cbegin(), parameters.cend(), std::back_inserter(block),
+                 [&nParameterDomains](size_t i) { return nParameterDomains[i] == 1; });
+    if (!block.empty()) {
+      hessianBlocks.emplace_back(std::move(block));
     }
-    ++i1;
+  }
 
-    if (i1 >= m_hessian.size1())
-      break;
+  // A parallel domain calls this method from several threads at once
+  PARALLEL_CRITICAL(lsq_merge) {
+    m_value += 0.5 * fVal;
+    if (nA > 0) {
+      m_der.mutator().head(nA) += derSum;
+      if (needHessian) {
+        const auto nh = std::min(nA, static_cast<Eigen::Index>(m_hessian.size1()));
+        m_hessian.mutator().topLeftCorner(nh, nh) += hessianSum.topLeftCorner(nh, nh);
+      }
+    }
+    m_hessianBlocks = std::move(hessianBlocks);
   }
 }
 
@@ -274,6 +274,102 @@ void EigenMatrix::solve(const EigenVector &rhs, EigenVector &x) {
   //}
 }
 
+/// Solve system of linear equations M*x == rhs, M is this matrix. The indices
+/// in each of the blocks must couple in M only to each other and to the
+/// indices which aren't in any block (the "arrow"). Each block is eliminated
+/// separately and only the Schur complement of the remaining indices is solved
+/// as a dense system.
+/// @param blocks :: Disjoint groups of indices forming the diagonal blocks
+/// @param rhs :: The right-hand-side vector
+/// @param x :: The solution vector
+/// @throws std::invalid_argument if the input vectors have wrong sizes or
+/// the matrix is singular.
+void EigenMatrix::solveBlockArrow(const std::vector<std::vector<size_t>> &blocks, const EigenVector &rhs,
+                                  EigenVector &x) const {
+  if (size1() != size2()) {
+    throw std::invalid_argument("System of linear equations: the matrix must be square.");
+  }
+  const size_t n = size1();
+  if (rhs.size() != n) {
+    throw std::invalid_argument("System of linear equations: right-hand side vector has wrong size.");
+  }
+
+  std::vector<bool> inBlock(n, false);
+  for (const auto &block : blocks) {
+    for (auto i : block) {
+      if (i >= n || inBlock[i]) {
+        throw std::invalid_argument("System of linear equations: invalid block structure.");
+      }
+      inBlock[i] = true;
+    }
+  }
+  std::vector<size_t> global;
+  for (size_t i = 0; i < n; ++i) {
+    if (!inBlock[i])
+      global.emplace_back(i);
+  }
+
+  const auto m = inspector();
+  const auto b = rhs.inspector();
+  const auto ng = static_cast<Eigen::Index>(global.size());
+  Eigen::MatrixXd schur(ng, ng);
+  Eigen::VectorXd schurRhs(ng);
+  for (Eigen::Index i = 0; i < ng; ++i) {
+    schurRhs(i) = b(global[i]);
+    for (Eigen::Index j = 0; j < ng; ++j) {
+      schur(i, j) = m(global[i], global[j]);
+    }
+  }
+
+  // Eliminate the blocks: S = C - B^T A^-1 B
+  std::vector<Eigen::MatrixXd> blockCoupling(blocks.size());
+  std::vector<Eigen::VectorXd> blockSolution(blocks.size());
+  for (size_t k = 0; k < blocks.size(); ++k) {
+    const auto &block = blocks[k];
+    const auto nb = static_cast<Eigen::Index>(block.size());
+    Eigen::MatrixXd a(nb, nb), coupling(nb, ng);
+    Eigen::VectorXd r(nb);
+    for (Eigen::Index i = 0; i < nb; ++i) {
+      r(i) = b(block[i]);
+      for (Eigen::Index j = 0; j < nb; ++j) {
+        a(i, j) = m(block[i], block[j]);
+      }
+      for (Eigen::Index j = 0; j < ng; ++j) {
+        coupling(i, j) = m(block[i], global[j]);
+      }
+    }
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> dec(a);
+    if (!dec.isInvertible()) {
+      throw std::invalid_argument("Matrix A is singular.");
+    }
+    blockCoupling[k] = dec.solve(coupling);
+    blockSolution[k] = dec.solve(r);
+    schur.noalias() -= coupling.transpose() * blockCoupling[k];
+    schurRhs.noalias() -= coupling.transpose() * blockSolution[k];
+  }
+
+  Eigen::VectorXd res(static_cast<Eigen::Index>(n));
+  Eigen::VectorXd globalSolution(ng);
+  if (ng > 0) {
+    Eigen::ColPivHouseholderQR<Eigen::MatrixXd> dec(schur);
+    if (!dec.isInvertible()) {
+      throw std::invalid_argument("Matrix A is singular.");
+    }
+    globalSolution = dec.solve(schurRhs);
+  }
+  for (Eigen::Index i = 0; i < ng; ++i) {
+    res(global[i]) = globalSolution(i);
+  }
+  // Back substitute: x_k = A_k^-1 (r_k - B_k x_g)
+  for (size_t k = 0; k < blocks.size(); ++k) {
+    const Eigen::VectorXd xk = blockSolution[k] - blockCoupling[k] * globalSolution;
+    for (size_t i = 0; i < blocks[k].size(); ++i) {
+      res(blocks[k][i]) = xk(static_cast<Eigen::Index>(i));
+    }
+  }
+  x = res;
+}
+
 /// Invert this matrix
 void EigenMatrix::invert() {
   if (size1() != size2()) {
@@ -20,20 +20,27 @@
 #include "MantidCurveFitting/Constraints/BoundaryConstraint.h"
 #include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
 #include "MantidCurveFitting/FuncMinimizers/FABADAMinimizer.h"
+#include "MantidCurveFitting/SeqDomain.h"
 
 #include "MantidHistogramData/LinearGenerator.h"
 
 #include "MantidKernel/Logger.h"
 #include "MantidKernel/MersenneTwister.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PseudoRandomNumberGenerator.h"
 #include "MantidKernel/normal_distribution.h"
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <numeric>
 #include <random>
 
 namespace Mantid::CurveFitting::FuncMinimisers {
@@ -53,6 +60,8 @@ const size_t JUMP_CHECKING_RATE = 200;
 const double LOW_JUMP_LIMIT = 1e-25;
 // random number generator
 std::mt19937 rng;
+// R-hat above which the chains are not considered to be mixed
+const double RHAT_WARNING_LIMIT = 1.1;
 
 API::MatrixWorkspace_sptr createWorkspace(std::vector<double> const &xValues, std::vector<double> const &yValues,
                                           int const numberOfSpectra,
@@ -71,6 +80,40 @@ API::MatrixWorkspace_sptr createWorkspace(std::vector<double> const &xValues, st
   return createWorkspaceAlgorithm->getProperty("OutputWorkspace");
 }
 
+/** Gelman-Rubin potential scale reduction factor (R-hat) of a quantity
+ * sampled by several chains of equal length.
+ *
+ * @param samples :: the samples of each chain
+ * @return :: R-hat, close to 1 if the chains sample the same distribution
+ */
+double potentialScaleReduction(std::vector<std::vector<double>> const &samples) {
+  const auto nChains = static_cast<double>(samples.size());
+  const auto n = static_cast<double>(samples.front().size());
+  std::vector<double> means;
+  double withinVariance = 0.0;
+  for (const auto &chain : samples) {
+    const double mean = std::accumulate(chain.cbegin(), chain.cend(), 0.0) / n;
+    double variance = 0.0;
+    for (const auto value : chain) {
+      variance += (value - mean) * (value - mean);
+    }
+    withinVariance += variance / (n - 1.0);
+    means.emplace_back(mean);
+  }
+  withinVariance /= nChains;
+  const double mean = std::accumulate(means.cbegin(), means.cend(), 0.0) / nChains;
+  double betweenVariance = 0.0;
+  for (const auto chainMean : means) {
+    betweenVariance += (chainMean - mean) * (chainMean - mean);
+  }
+  betweenVariance *= n / (nChains - 1.0);
+  if (withinVariance == 0.0) {
+    return betweenVariance == 0.0 ? 1.0 : std::numeric_limits<double>::infinity();
+  }
+  const double pooledVariance = (n - 1.0) / n * withinVariance + betweenVariance / n;
+  return std::sqrt(pooledVariance / withinVariance);
+}
+
 } // namespace
 
 DECLARE_FUNCMINIMIZER(FABADAMinimizer, FABADA)
@@ -80,7 +123,8 @@ FABADAMinimizer::FABADAMinimizer()
     : m_counter(0), m_chainIterations(0), m_changes(), m_jump(), m_parameters(), m_chain(), m_chi2(0.),
       m_converged(false), m_convPoint(0), m_parConverged(), m_criteria(), m_maxIter(0), m_parChanged(),
       m_temperature(0.), m_counterGlobal(0), m_simAnnealingItStep(0), m_leftRefrPoints(0), m_tempStep(0.),
-      m_overexploration(false), m_nParams(0), m_numInactiveRegenerations(), m_changesOld() {
+      m_overexploration(false), m_nParams(0), m_numInactiveRegenerations(), m_changesOld(), m_extraChains(),
+      m_chainRunning(), m_randomGenerator() {
   declareProperty("ChainLength", static_cast<size_t>(10000), "Length of the converged chain.");
   declareProperty("StepsBetweenValues", 10,
                   "Steps done between chain points to avoid correlation"
@@ -90,6 +134,10 @@ FABADAMinimizer::FABADAMinimizer()
                   "Number of Innactive Regenerations to consider"
                   " a certain parameter to be converged");
   declareProperty("JumpAcceptanceRate", 0.6666666, "Desired jumping acceptance rate");
+  declareProperty("NumberOfChains", 1,
+                  "Number of independent Markov chains run in parallel. The"
+                  " converged chains of all of them are combined into the"
+                  " posterior.");
   // Simulated Annealing properties
   declareProperty("SimAnnealingApplied", false,
                   "If minimization should be run with Simulated"
@@ -119,6 +167,11 @@ FABADAMinimizer::FABADAMinimizer()
   declareProperty(
       std::make_unique<API::WorkspaceProperty<API::ITableWorkspace>>("Parameters", "", Kernel::Direction::Output),
       "The name to give the output workspace (Parameter values and errors)");
+  declareProperty(std::make_unique<API::WorkspaceProperty<API::ITableWorkspace>>(
+                      "ChainDiagnostics", "", Kernel::Direction::Output, API::PropertyMode::Optional),
+                  "The name to give the output workspace with the R-hat"
+                  " convergence diagnostic and the parameters of each chain"
+                  " (only if NumberOfChains > 1)");
 
   // To be implemented in the future
   /*declareProperty(
@@ -169,13 +222,89 @@ void FABADAMinimizer::initialize(API::ICostFunction_sptr function, size_t maxIte
                             " 350 iterations for the burn-in period. Increase"
                             " MaxIterations property");
   }
+
+  m_extraChains.clear();
+  const int nChains = getProperty("NumberOfChains");
+  if (nChains > 1) {
+    initExtraChains(static_cast<size_t>(nChains - 1), maxIterations);
+  }
+  m_chainRunning.assign(m_extraChains.size() + 1, 1);
+}
+
+/** Create the additional chains. Each of them samples its own copy of the
+ * fitting function and cost function, starting from the same parameters but
+ * with a different random sequence.
+ *
+ * @param nExtraChains :: the number of chains to add
+ * @param maxIterations :: maximum number of iterations
+ */
+void FABADAMinimizer::initExtraChains(size_t nExtraChains, size_t maxIterations) {
+  if (std::dynamic_pointer_cast<SeqDomain>(m_leastSquares->getDomain())) {
+    g_log.warning() << "NumberOfChains is ignored: a sequential domain cannot"
+                       " be shared by parallel chains.\n";
+    return;
+  }
+  for (size_t i = 0; i < nExtraChains; ++i) {
+    auto chain = std::make_unique<FABADAMinimizer>();
+    for (const auto *property : getProperties()) {
+      if (property->direction() == Kernel::Direction::Input) {
+        chain->setPropertyValue(property->name(), property->value());
+      }
+    }
+    chain->setProperty("NumberOfChains", 1);
+    chain->m_randomGenerator = std::make_unique<std::mt19937>(rng());
+
+    auto costFunction = std::dynamic_pointer_cast<CostFunctions::CostFuncLeastSquares>(
+        API::CostFunctionFactory::Instance().create(m_leastSquares->name()));
+    auto values = std::make_shared<API::FunctionValues>(*m_leastSquares->getValues());
+    costFunction->setFittingFunction(m_fitFunction->clone(), m_leastSquares->getDomain(), values);
+    chain->initialize(costFunction, maxIterations);
+    m_extraChains.emplace_back(std::move(chain));
+  }
 }
 
-/** Do one iteration.
+/** Do one iteration. All chains which haven't finished do one iteration in
+ * parallel.
  *
  * @return :: true if iterations must be continued, false otherwise
  */
 bool FABADAMinimizer::iterate(size_t /*iteration*/) {
+  if (m_extraChains.empty()) {
+    return iterateChain();
+  }
+
+  const auto nChains = static_cast<int>(m_chainRunning.size());
+  std::vector<std::exception_ptr> errors(nChains);
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < nChains; ++i) {
+    if (!m_chainRunning[i])
+      continue;
+    try {
+      if (i == 0) {
+        m_chainRunning[i] = iterateChain();
+      } else {
+        // Fit only notifies the function of the first chain
+        auto &chain = *m_extraChains[i - 1];
+        chain.m_fitFunction->iterationStarting();
+        m_chainRunning[i] = chain.iterateChain();
+        chain.m_fitFunction->iterationFinished();
+      }
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+  for (const auto &error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+  return std::any_of(m_chainRunning.cbegin(), m_chainRunning.cend(), [](int running) { return running != 0; });
+}
+
+/** Do one iteration of this chain.
+ *
+ * @return :: true if iterations must be continued, false otherwise
+ */
+bool FABADAMinimizer::iterateChain() {
 
   if (!m_leastSquares) {
     throw std::runtime_error("Cost function isn't set up.");
@@ -284,7 +413,7 @@ bool FABADAMinimizer::iterate(size_t /*iteration*/) {
   // Evaluates if iterations should continue or not
   return iterationContinuation();
 
-} // Iterate() end
+} // iterateChain() end
 
 double FABADAMinimizer::costFunctionVal() { return m_chi2; }
 
@@ -312,7 +441,15 @@ void FABADAMinimizer::finalize() {
   std::vector<double> errorLeft(m_nParams);
   std::vector<double> errorRight(m_nParams);
 
-  calculateConvChainAndBestParameters(convLength, nSteps, reducedConvergedChain, bestParameters, errorLeft, errorRight);
+  if (m_extraChains.empty()) {
+    calculateConvChainAndBestParameters(convLength, nSteps, reducedConvergedChain, bestParameters, errorLeft,
+                                        errorRight);
+  } else {
+    calculateCombinedChainAndBestParameters(convLength, nSteps, reducedConvergedChain, bestParameters, errorLeft,
+                                            errorRight);
+  }
+  // Length of the (possibly combined) reduced chain
+  const size_t reducedLength = reducedConvergedChain.empty() ? 0 : reducedConvergedChain.front().size();
 
   if (!getPropertyValue("Parameters").empty()) {
     outputParameterTable(bestParameters, errorLeft, errorRight);
@@ -336,7 +473,7 @@ void FABADAMinimizer::finalize() {
     outputChains();
   }
 
-  double mostPchi2 = outputPDF(convLength, reducedConvergedChain);
+  double mostPchi2 = outputPDF(reducedLength, reducedConvergedChain);
 
   if (!getPropertyValue("ConvergedChain").empty()) {
     outputConvergedChains(convLength, nSteps);
@@ -360,9 +497,15 @@ void FABADAMinimizer::finalize() {
  * @return :: the step
  */
 double FABADAMinimizer::gaussianStep(const double &jump) {
-  return Kernel::normal_distribution<double>(0.0, std::abs(jump))(rng);
+  return Kernel::normal_distribution<double>(0.0, std::abs(jump))(randomGenerator());
 }
 
+/** The first chain uses the shared generator, the additional ones their own.
+ *
+ * @return :: the random number generator of this chain
+ */
+std::mt19937 &FABADAMinimizer::randomGenerator() { return m_randomGenerator ? *m_randomGenerator : rng; }
+
 /** If the new point is out of its bounds, it is changed to fit in the bound
  * limits
  *
@@ -474,7 +617,7 @@ void FABADAMinimizer::algorithmDisplacement(const size_t &parameterIndex, const
     double prob = exp((m_chi2 - chi2New) / (2.0 * m_temperature));
 
     // Decide if changing or not
-    double p = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    double p = std::uniform_real_distribution<double>(0.0, 1.0)(randomGenerator());
     if (p <= prob) {
       for (size_t j = 0; j < m_nParams; j++) {
         m_chain[j].emplace_back(newParameters.get(j));
@@ -922,47 +1065,8 @@ void FABADAMinimizer::calculateConvChainAndBestParameters(size_t convLength, int
 
   // In case of reduced chain
   if (convLength > 0) {
-    // Write first element of the reduced chain
-    for (size_t e = 0; e <= m_nParams; ++e) {
-      std::vector<double> v;
-      v.emplace_back(m_chain[e][m_convPoint]);
-      reducedChain.emplace_back(std::move(v));
-    }
-
-    // Calculate the reducedConvergedChain for the cost fuction.
-    for (size_t k = 1; k < convLength; ++k) {
-      reducedChain[m_nParams].emplace_back(m_chain[m_nParams][nSteps * k + m_convPoint]);
-    }
-
-    // Calculate the position of the minimum Chi square value
-    auto positionMinChi2 = std::min_element(reducedChain[m_nParams].begin(), reducedChain[m_nParams].end());
-    m_chi2 = *positionMinChi2;
-
-    // Calculate the parameter value and the errors
-    for (size_t j = 0; j < m_nParams; ++j) {
-      // Obs: Starts at 1 (0 already added)
-      for (size_t k = 1; k < convLength; ++k) {
-        reducedChain[j].emplace_back(m_chain[j][m_convPoint + nSteps * k]);
-      }
-      // best fit parameters taken
-      bestParameters[j] = reducedChain[j][positionMinChi2 - reducedChain[m_nParams].begin()];
-      std::sort(reducedChain[j].begin(), reducedChain[j].end());
-      auto posBestPar = std::find(reducedChain[j].begin(), reducedChain[j].end(), bestParameters[j]);
-      double varLeft = 0, varRight = 0;
-      for (auto k = reducedChain[j].begin(); k < reducedChain[j].end(); k += 2) {
-        if (k < posBestPar)
-          varLeft += (*k - bestParameters[j]) * (*k - bestParameters[j]);
-        else if (k > posBestPar)
-          varRight += (*k - bestParameters[j]) * (*k - bestParameters[j]);
-      }
-      if (posBestPar != reducedChain[j].begin())
-        varLeft /= double(posBestPar - reducedChain[j].begin());
-      if (posBestPar != reducedChain[j].end() - 1)
-        varRight /= double(reducedChain[j].end() - posBestPar - 1);
-
-      errorLeft[j] = -sqrt(varLeft);
-      errorRight[j] = sqrt(varRight);
-    }
+    reduceConvergedChain(convLength, nSteps, reducedChain);
+    calculateBestParameters(reducedChain, bestParameters, errorLeft, errorRight);
   } // End if there is converged chain
 
   // If the converged chain is empty
@@ -976,6 +1080,166 @@ void FABADAMinimizer::calculateConvChainAndBestParameters(size_t convLength, int
   }
 }
 
+/** Combine the reduced converged chains of all chains into one, calculate the
+ * best parameter values and errors of the combined chain and the R-hat
+ * convergence diagnostic.
+ *
+ * @param convLength :: length of the converged chain of each chain
+ * @param nSteps :: number of steps done between chain points to avoid
+ * correlation
+ * @param reducedChain :: [output] the combined reduced chain
+ * @param bestParameters :: [output] vector containing best values for fitting
+ *parameters
+ * @param errorLeft :: [output] vector containing the sqrt of the mean square
+ *left deviation
+ * @param errorRight :: [output] vector containing the sqrt of the mean square
+ *right deviation
+ */
+void FABADAMinimizer::calculateCombinedChainAndBestParameters(size_t convLength, int nSteps,
+                                                              std::vector<std::vector<double>> &reducedChain,
+                                                              std::vector<double> &bestParameters,
+                                                              std::vector<double> &errorLeft,
+                                                              std::vector<double> &errorRight) {
+  if (convLength < 2) {
+    g_log.warning() << "The converged chains are too short to be combined."
+                       " Only the first chain is used.\n";
+    calculateConvChainAndBestParameters(convLength, nSteps, reducedChain, bestParameters, errorLeft, errorRight);
+    return;
+  }
+
+  std::vector<std::vector<std::vector<double>>> chains(m_extraChains.size() + 1);
+  reduceConvergedChain(convLength, nSteps, chains.front());
+  for (size_t i = 0; i < m_extraChains.size(); ++i) {
+    m_extraChains[i]->reduceConvergedChain(convLength, nSteps, chains[i + 1]);
+  }
+
+  // Convergence diagnostic of each parameter
+  std::vector<double> rHat(m_nParams);
+  for (size_t j = 0; j < m_nParams; ++j) {
+    std::vector<std::vector<double>> samples;
+    std::transform(chains.cbegin(), chains.cend(), std::back_inserter(samples),
+                   [j](const auto &chain) { return chain[j]; });
+    rHat[j] = potentialScaleReduction(samples);
+    if (!(rHat[j] < RHAT_WARNING_LIMIT)) {
+      g_log.warning() << "The chains haven't mixed for parameter " << m_fitFunction->parameterName(j)
+                      << " (R-hat = " << rHat[j] << "). Increase ChainLength.\n";
+    }
+  }
+
+  // Best parameters of each chain: value, left and right errors
+  std::vector<std::vector<std::vector<double>>> chainParameters;
+  if (!getPropertyValue("ChainDiagnostics").empty()) {
+    for (size_t i = 0; i < chains.size(); ++i) {
+      auto &chain = i == 0 ? *this : *m_extraChains[i - 1];
+      auto chainCopy = chains[i];
+      std::vector<std::vector<double>> parameters(3, std::vector<double>(m_nParams));
+      chain.calculateBestParameters(chainCopy, parameters[0], parameters[1], parameters[2]);
+      chainParameters.emplace_back(std::move(parameters));
+    }
+  }
+
+  // Combined posterior
+  reducedChain = std::move(chains.front());
+  for (size_t i = 1; i < chains.size(); ++i) {
+    for (size_t j = 0; j <= m_nParams; ++j) {
+      reducedChain[j].insert(reducedChain[j].end(), chains[i][j].cbegin(), chains[i][j].cend());
+    }
+  }
+  calculateBestParameters(reducedChain, bestParameters, errorLeft, errorRight);
+
+  if (!chainParameters.empty()) {
+    outputChainDiagnostics(rHat, chainParameters);
+  }
+}
+
+/** Take every nSteps-th point of the converged part of the chain
+ *
+ * @param convLength :: length of the reduced chain
+ * @param nSteps :: number of steps done between chain points to avoid
+ * correlation
+ * @param reducedChain :: [output] the reduced chain
+ */
+void FABADAMinimizer::reduceConvergedChain(size_t convLength, int nSteps,
+                                           std::vector<std::vector<double>> &reducedChain) const {
+  reducedChain.assign(m_nParams + 1, std::vector<double>());
+  for (size_t j = 0; j <= m_nParams; ++j) {
+    reducedChain[j].reserve(convLength);
+    for (size_t k = 0; k < convLength; ++k) {
+      reducedChain[j].emplace_back(m_chain[j][m_convPoint + nSteps * k]);
+    }
+  }
+}
+
+/** Calculate the best parameter values (at the minimum chi squared) and their
+ * errors from a reduced chain. The parameter chains are sorted.
+ *
+ * @param reducedChain :: the reduced chain
+ * @param bestParameters :: [output] vector containing best values for fitting
+ *parameters
+ * @param errorLeft :: [output] vector containing the sqrt of the mean square
+ *left deviation
+ * @param errorRight :: [output] vector containing the sqrt of the mean square
+ *right deviation
+ */
+void FABADAMinimizer::calculateBestParameters(std::vector<std::vector<double>> &reducedChain,
+                                              std::vector<double> &bestParameters, std::vector<double> &errorLeft,
+                                              std::vector<double> &errorRight) {
+  // Calculate the position of the minimum Chi square value
+  auto positionMinChi2 = std::min_element(reducedChain[m_nParams].begin(), reducedChain[m_nParams].end());
+  m_chi2 = *positionMinChi2;
+
+  // Calculate the parameter value and the errors
+  for (size_t j = 0; j < m_nParams; ++j) {
+    // best fit parameters taken
+    bestParameters[j] = reducedChain[j][positionMinChi2 - reducedChain[m_nParams].begin()];
+    std::sort(reducedChain[j].begin(), reducedChain[j].end());
+    auto posBestPar = std::find(reducedChain[j].begin(), reducedChain[j].end(), bestParameters[j]);
+    double varLeft = 0, varRight = 0;
+    for (auto k = reducedChain[j].begin(); k < reducedChain[j].end(); k += 2) {
+      if (k < posBestPar)
+        varLeft += (*k - bestParameters[j]) * (*k - bestParameters[j]);
+      else if (k > posBestPar)
+        varRight += (*k - bestParameters[j]) * (*k - bestParameters[j]);
+    }
+    if (posBestPar != reducedChain[j].begin())
+      varLeft /= double(posBestPar - reducedChain[j].begin());
+    if (posBestPar != reducedChain[j].end() - 1)
+      varRight /= double(reducedChain[j].end() - posBestPar - 1);
+
+    errorLeft[j] = -sqrt(varLeft);
+    errorRight[j] = sqrt(varRight);
+  }
+}
+
+/** Create the table workspace with the R-hat convergence diagnostic and the
+ * parameter values and errors of each chain
+ *
+ * @param rHat :: R-hat of each parameter
+ * @param chainParameters :: values, left and right errors of the parameters
+ * of each chain
+ */
+void FABADAMinimizer::outputChainDiagnostics(const std::vector<double> &rHat,
+                                             const std::vector<std::vector<std::vector<double>>> &chainParameters) {
+  API::ITableWorkspace_sptr wsDiagnostics = API::WorkspaceFactory::Instance().createTable("TableWorkspace");
+  wsDiagnostics->addColumn("str", "Name");
+  wsDiagnostics->addColumn("double", "R-hat");
+  for (size_t i = 0; i < chainParameters.size(); ++i) {
+    const std::string chain = "Chain " + std::to_string(i) + " ";
+    wsDiagnostics->addColumn("double", chain + "Value");
+    wsDiagnostics->addColumn("double", chain + "Left's error");
+    wsDiagnostics->addColumn("double", chain + "Right's error");
+  }
+
+  for (size_t j = 0; j < m_nParams; ++j) {
+    API::TableRow row = wsDiagnostics->appendRow();
+    row << m_fitFunction->parameterName(j) << rHat[j];
+    for (const auto &parameters : chainParameters) {
+      row << parameters[0][j] << parameters[1][j] << parameters[2][j];
+    }
+  }
+  setProperty("ChainDiagnostics", wsDiagnostics);
+}
+
 /** Initialze member variables related to fitting parameters
  *
  */
@@ -148,7 +148,13 @@ bool LevenbergMarquardtMDMinimizer::iterate(size_t /*iteration*/) {
   // To find dx solve the system of linear equations   H * dx == -m_der
   dd *= -1.0;
   try {
-    H.solve(dd, dx);
+    // Exploit the block structure of the Hessian of a fit with many local parameters
+    const auto &blocks = m_costFunction->getHessianBlocks();
+    if (blocks.empty()) {
+      H.solve(dd, dx);
+    } else {
+      H.solveBlockArrow(blocks, dd, dx);
+    }
   } catch (std::runtime_error &error) {
     m_errorString = error.what();
     return false;
@@ -18,6 +18,9 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_fft_halfcomplex.h>
@@ -101,16 +104,46 @@ void Convolution::setAttribute(const std::string &attName, const IFunction::Attr
 namespace {
 // anonymous namespace for local definitions
 
+// The forward and inverse wavetables for transforms of one size. GSL only
+// reads them during a transform, so they can be shared between threads.
+struct FFTWavetables {
+  explicit FFTWavetables(size_t nData)
+      : real(gsl_fft_real_wavetable_alloc(nData)), halfComplex(gsl_fft_halfcomplex_wavetable_alloc(nData)) {}
+  ~FFTWavetables() {
+    gsl_fft_halfcomplex_wavetable_free(halfComplex);
+    gsl_fft_real_wavetable_free(real);
+  }
+  FFTWavetables(const FFTWavetables &) = delete;
+  FFTWavetables &operator=(const FFTWavetables &) = delete;
+  gsl_fft_real_wavetable *real;
+  gsl_fft_halfcomplex_wavetable *halfComplex;
+};
+
+// Every evaluation in a fit, and usually every fit of a sequence, transforms
+// data of the same size, so the wavetables are computed once per size.
+std::shared_ptr<const FFTWavetables> getWavetables(size_t nData) {
+  // a handful of sizes is typical, this only bounds pathological use
+  constexpr size_t maxCachedSizes{64};
+  static std::mutex cacheMutex;
+  static std::map<size_t, std::shared_ptr<const FFTWavetables>> cache;
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  auto found = cache.find(nData);
+  if (found != cache.end())
+    return found->second;
+  if (cache.size() >= maxCachedSizes)
+    cache.clear();
+  auto wavetables = std::make_shared<const FFTWavetables>(nData);
+  cache.emplace(nData, wavetables);
+  return wavetables;
+}
+
 // A struct incapsulating workspaces for real fft
 struct RealFFTWorkspace {
   explicit RealFFTWorkspace(size_t nData)
-      : workspace(gsl_fft_real_workspace_alloc(nData)), wavetable(gsl_fft_real_wavetable_alloc(nData)) {}
-  ~RealFFTWorkspace() {
-    gsl_fft_real_wavetable_free(wavetable);
-    gsl_fft_real_workspace_free(workspace);
-  }
+      : workspace(gsl_fft_real_workspace_alloc(nData)), wavetables(getWavetables(nData)) {}
+  ~RealFFTWorkspace() { gsl_fft_real_workspace_free(workspace); }
   gsl_fft_real_workspace *workspace;
-  gsl_fft_real_wavetable *wavetable;
+  std::shared_ptr<const FFTWavetables> wavetables;
 };
 } // namespace
 
@@ -206,7 +239,7 @@ void Convolution::functionFFTMode(const FunctionDomain &domain, FunctionValues &
         m_resolution[n2 + i] = tmp;
       }
     }
-    gsl_fft_real_transform(m_resolution.data(), 1, nData, workspace.wavetable, workspace.workspace);
+    gsl_fft_real_transform(m_resolution.data(), 1, nData, workspace.wavetables->real, workspace.workspace);
     std::transform(m_resolution.begin(), m_resolution.end(), m_resolution.begin(),
                    std::bind(std::multiplies<double>(), _1, dx));
   }
@@ -259,7 +292,7 @@ void Convolution::functionFFTMode(const FunctionDomain &domain, FunctionValues &
   if (!deltaFunctionsOnly) {
     // Transform the model function
     getFunction(1)->function(domain, values);
-    gsl_fft_real_transform(out, 1, nData, workspace.wavetable, workspace.workspace);
+    gsl_fft_real_transform(out, 1, nData, workspace.wavetables->real, workspace.workspace);
 
     // Fourier transform is integration - multiply by the step in the
     // integration variable
@@ -283,9 +316,7 @@ void Convolution::functionFFTMode(const FunctionDomain &domain, FunctionValues &
     }
 
     // Inverse fourier transform of fun
-    gsl_fft_halfcomplex_wavetable *wavetable_r = gsl_fft_halfcomplex_wavetable_alloc(nData);
-    gsl_fft_halfcomplex_inverse(out, 1, nData, wavetable_r, workspace.workspace);
-    gsl_fft_halfcomplex_wavetable_free(wavetable_r);
+    gsl_fft_halfcomplex_inverse(out, 1, nData, workspace.wavetables->halfComplex, workspace.workspace);
 
     // Inverse fourier transform is integration - multiply by the step in the
     // integration variable
@@ -297,11 +328,21 @@ void Convolution::functionFFTMode(const FunctionDomain &domain, FunctionValues &
 
   if (dltF != 0.0 && !deltaShifted) {
     // If model contains any delta functions their effect is addition of scaled
-    // resolution
-    std::vector<double> tmp(nData);
-    evaluateFunctionOnRange(getFunction(0), nData, xValues, tmp);
-    std::transform(tmp.begin(), tmp.end(), tmp.begin(), std::bind(std::multiplies<double>(), _1, dltF));
-    std::transform(out, out + nData, tmp.data(), out, std::plus<double>());
+    // resolution. Its values are reused while the domain and the resolution
+    // parameters stay the same.
+    const auto &resolution = *getFunction(0);
+    std::vector<double> resolutionParameters(resolution.nParams());
+    for (size_t i = 0; i < resolutionParameters.size(); ++i)
+      resolutionParameters[i] = resolution.getParameter(i);
+    if (resolutionParameters != m_resolutionParameters || m_resolutionDomain.size() != nData ||
+        !std::equal(xValues, xValues + nData, m_resolutionDomain.begin())) {
+      m_resolutionParameters = std::move(resolutionParameters);
+      m_resolutionDomain.assign(xValues, xValues + nData);
+      m_resolutionOnDomain.resize(nData);
+      evaluateFunctionOnRange(getFunction(0), nData, xValues, m_resolutionOnDomain);
+    }
+    std::transform(out, out + nData, m_resolutionOnDomain.begin(), out,
+                   [dltF](double value, double resolution) { return value + dltF * resolution; });
   } else if (!dltFuns.empty()) {
     std::vector<double> x(nData);
     for (const auto &df : dltFuns) {
@@ -480,7 +521,10 @@ size_t Convolution::addFunction(IFunction_sptr f) {
  * Make sure that the resolution is updated if this function is reused in
  * several Fits.
  */
-void Convolution::setUpForFit() { m_resolution.clear(); }
+void Convolution::setUpForFit() {
+  m_resolution.clear();
+  m_resolutionDomain.clear();
+}
 
 /// Deletes and zeroes pointer m_resolution forsing function(...) to recalculate
 /// the resolution function
@@ -501,6 +545,7 @@ void Convolution::refreshResolution() const {
     return;
   // delete fourier transform of the resolution to force its recalculation
   m_resolution.clear();
+  m_resolutionDomain.clear();
 }
 
 } // namespace Mantid::CurveFitting::Functions
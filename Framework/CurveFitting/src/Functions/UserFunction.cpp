@@ -13,8 +13,15 @@
 #include "MantidGeometry/muParser_Silent.h"
 #include <boost/tokenizer.hpp>
 
+#include <algorithm>
+
 namespace Mantid::CurveFitting::Functions {
 
+namespace {
+/// Maximum number of points evaluated by one call to muParser in bulk mode
+constexpr size_t BULK_SIZE = 1024;
+} // namespace
+
 using namespace CurveFitting;
 
 // Register the class into the function factory
@@ -69,6 +76,7 @@ void UserFunction::setAttribute(const std::string &attName, const Attribute &val
 
   m_x_set = false;
   clearAllParameters();
+  m_bulkValues.clear();
 
   try {
     mu::Parser tmp_parser;
@@ -91,10 +99,13 @@ void UserFunction::setAttribute(const std::string &attName, const Attribute &val
     return;
   }
 
+  // In bulk mode muParser reads each variable from an array of BULK_SIZE
+  // values: x followed by the parameters.
+  m_bulkValues.assign((nParams() + 1) * BULK_SIZE, 0.0);
   m_parser->ClearVar();
-  m_parser->DefineVar("x", &m_x);
+  m_parser->DefineVar("x", m_bulkValues.data());
   for (size_t i = 0; i < nParams(); i++) {
-    m_parser->DefineVar(parameterName(i), getParameterAddress(i));
+    m_parser->DefineVar(parameterName(i), m_bulkValues.data() + (i + 1) * BULK_SIZE);
   }
 
   m_parser->SetExpr(m_formula);
@@ -111,13 +122,25 @@ void UserFunction::function1D(double *out, const double *xValues, const size_t n
   if (m_formula.empty()) {
     throw std::invalid_argument("Empty formula supplied for user function");
   }
-  for (size_t i = 0; i < nData; i++) {
-    m_x = xValues[i];
+  if (m_bulkValues.empty()) {
+    throw std::invalid_argument("Invalid formula supplied for user function: " + m_formula);
+  }
+  // The parameters are the same for all points
+  const size_t bulkSize = std::min(nData, BULK_SIZE);
+  for (size_t i = 0; i < nParams(); i++) {
+    auto parameterValues = m_bulkValues.begin() + (i + 1) * BULK_SIZE;
+    std::fill(parameterValues, parameterValues + bulkSize, getParameter(i));
+  }
+  // Evaluate the formula for the x values in blocks of up to BULK_SIZE
+  for (size_t start = 0; start < nData; start += BULK_SIZE) {
+    const size_t n = std::min(nData - start, BULK_SIZE);
+    std::copy(xValues + start, xValues + start + n, m_bulkValues.begin());
     try {
-      out[i] = m_parser->Eval();
+      m_parser->Eval(out + start, static_cast<int>(n));
     } catch (mu::Parser::exception_type &e) {
-      throw std::invalid_argument("Error evaluating function \"" + m_formula + "\" for x=" + std::to_string(m_x) +
-                                  ": " + e.GetMsg());
+      throw std::invalid_argument("Error evaluating function \"" + m_formula + "\" for x in [" +
+                                  std::to_string(xValues[start]) + ", " + std::to_string(xValues[start + n - 1]) +
+                                  "]: " + e.GetMsg());
     }
   }
 }
@@ -305,6 +305,58 @@ public:
     return;
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Test that the cached peak profiles used by function() follow changes of
+   * the peak heights and of the profile parameters
+   */
+  void test_cachedPeaksFollowParameterChanges() {
+    LeBailFunction lebailfunction("ThermalNeutronBk2BkExpConvPVoigt");
+
+    map<string, double> parammap{{"Dtt1", 29671.7500}, {"Dtt2", 0.0},          {"Dtt1t", 29671.750},
+                                 {"Dtt2t", 0.30},      {"Zero", 0.0},          {"Zerot", 33.70},
+                                 {"Alph0", 4.026},     {"Alph1", 7.362},       {"Beta0", 3.489},
+                                 {"Beta1", 19.535},    {"Alph0t", 60.683},     {"Alph1t", 39.730},
+                                 {"Beta0t", 96.864},   {"Beta1t", 96.864},     {"Sig2", sqrt(11.380)},
+                                 {"Sig1", sqrt(9.901)}, {"Sig0", sqrt(17.370)}, {"Width", 1.0055},
+                                 {"Tcross", 0.4700},   {"Gam0", 0.0},          {"Gam1", 0.0},
+                                 {"Gam2", 0.0},        {"LatticeConstant", 4.156890}};
+    lebailfunction.setProfileParameterValues(parammap);
+    std::vector<std::vector<int>> hkls{{9, 3, 2}, {8, 5, 2}};
+    lebailfunction.addPeaks(hkls);
+
+    MatrixWorkspace_sptr dataws = createDataWorkspace(2);
+    const MantidVec &vecX = dataws->readX(0);
+    const MantidVec &vecY = dataws->readY(0);
+    vector<double> vecoutput(vecY.size(), 0.);
+    lebailfunction.calculatePeaksIntensities(vecX, vecY, vecoutput);
+
+    auto pattern = lebailfunction.function(vecX, true, false);
+    assertPatternIsSumOfPeaks(lebailfunction, vecX);
+
+    // Change the height of a peak only
+    lebailfunction.getPeak(0)->setHeight(2.0 * lebailfunction.getPeak(0)->height());
+    assertPatternIsSumOfPeaks(lebailfunction, vecX);
+
+    // Change the profile
+    parammap["Sig1"] = 2.0 * sqrt(9.901);
+    lebailfunction.setProfileParameterValues(parammap);
+    auto newpattern = lebailfunction.function(vecX, true, false);
+    TS_ASSERT(newpattern.rawData() != pattern.rawData());
+    assertPatternIsSumOfPeaks(lebailfunction, vecX);
+  }
+
+  void assertPatternIsSumOfPeaks(LeBailFunction &lebailfunction, const std::vector<double> &vecX) {
+    auto pattern = lebailfunction.function(vecX, true, false);
+    std::vector<double> expected(vecX.size(), 0.0);
+    for (size_t ipk = 0; ipk < lebailfunction.getNumberOfPeaks(); ++ipk) {
+      auto peak = lebailfunction.calPeak(ipk, vecX, vecX.size());
+      for (size_t i = 0; i < vecX.size(); ++i)
+        expected[i] += peak[i];
+    }
+    for (size_t i = 0; i < vecX.size(); ++i)
+      TS_ASSERT_DELTA(pattern[i], expected[i], 1.0E-8 * (1.0 + fabs(expected[i])));
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Goal: Test function() of LeBailFunction of Fullprof No. 9 by plotting 2
    *adjacent peaks
@@ -230,6 +230,43 @@ public:
     WorkspaceCreationHelper::removeWS("PlotPeakResult");
   }
 
+  void testWorkspaceList_parallel_individual_fits_match_serial() {
+    createData();
+
+    auto runFits = [](const bool parallel, const std::string &outputName) {
+      PlotPeakByLogValue alg;
+      alg.initialize();
+      alg.setPropertyValue("Input", "PlotPeakGroup_0;PlotPeakGroup_1;PlotPeakGroup_2");
+      alg.setPropertyValue("OutputWorkspace", outputName);
+      alg.setPropertyValue("WorkspaceIndex", "1");
+      alg.setPropertyValue("LogValue", "var");
+      alg.setPropertyValue("FitType", "Individual");
+      alg.setProperty("Parallel", parallel);
+      alg.setPropertyValue("Function", "name=LinearBackground,A0=1,A1=0.3;name="
+                                       "Gaussian,PeakCentre=5,Height=2,Sigma=0."
+                                       "1");
+      alg.execute();
+      TS_ASSERT(alg.isExecuted());
+    };
+    runFits(false, "PlotPeakResultSerial");
+    runFits(true, "PlotPeakResultParallel");
+
+    TWS_type serial = WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResultSerial");
+    TWS_type parallel = WorkspaceCreationHelper::getWS<TableWorkspace>("PlotPeakResultParallel");
+    TS_ASSERT_EQUALS(parallel->getColumnNames(), serial->getColumnNames());
+    TS_ASSERT_EQUALS(parallel->rowCount(), 3);
+    TS_ASSERT_EQUALS(parallel->rowCount(), serial->rowCount());
+    for (size_t row = 0; row < serial->rowCount(); ++row) {
+      for (size_t col = 0; col < serial->columnCount(); ++col) {
+        TS_ASSERT_DELTA(parallel->Double(row, col), serial->Double(row, col), 1e-10);
+      }
+    }
+
+    deleteData();
+    WorkspaceCreationHelper::removeWS("PlotPeakResultSerial");
+    WorkspaceCreationHelper::removeWS("PlotPeakResultParallel");
+  }
+
   void testWorkspaceList_plotting_against_ws_names() {
     createData();
 
@@ -18,6 +18,8 @@ using namespace Mantid;
 using namespace Mantid::API;
 using namespace Mantid::DataObjects;
 
+#include "FitTestHelpers.h"
+
 namespace {
 constexpr const char *linearFunctionString = "name = LinearBackground, A0=0.8753627851076761,  A1 = "
                                              "2.026706319695708 ";
@@ -38,7 +40,7 @@ public:
     algo->execute();
   }
 
-  void executeAlgorithmOnLinearData(const std::string &outputName) {
+  void executeAlgorithmOnLinearData(const std::string &outputName, bool parallel = false) {
     std::string wsName = "ProfileChiSquared1DData_linear";
     loadLinearData(wsName);
     auto ws = AnalysisDataService::Instance().retrieveWS<Workspace>(wsName);
@@ -48,6 +50,7 @@ public:
     profileAlg.setProperty("Function", functionString);
     profileAlg.setProperty("InputWorkspace", ws);
     profileAlg.setProperty("Output", outputName);
+    profileAlg.setProperty("Parallel", parallel);
     profileAlg.execute();
   }
 
@@ -153,4 +156,68 @@ public:
     TS_ASSERT_EQUALS(pdfTable->rowCount(), 100);
     AnalysisDataService::Instance().clear();
   };
+
+  void test_parallel_scan_gives_same_results_as_serial() {
+    executeAlgorithmOnLinearData("Serial");
+    executeAlgorithmOnLinearData("Parallel", true);
+    auto &ads = AnalysisDataService::Instance();
+    TableWorkspace_sptr serialErrors, parallelErrors, serialPdf, parallelPdf;
+    TS_ASSERT_THROWS_NOTHING(serialErrors = ads.retrieveWS<TableWorkspace>("Serial_errors"));
+    TS_ASSERT_THROWS_NOTHING(parallelErrors = ads.retrieveWS<TableWorkspace>("Parallel_errors"));
+    TS_ASSERT_THROWS_NOTHING(serialPdf = ads.retrieveWS<TableWorkspace>("Serial_pdf"));
+    TS_ASSERT_THROWS_NOTHING(parallelPdf = ads.retrieveWS<TableWorkspace>("Parallel_pdf"));
+
+    TS_ASSERT_EQUALS(parallelErrors->rowCount(), serialErrors->rowCount());
+    TS_ASSERT_EQUALS(parallelErrors->columnCount(), serialErrors->columnCount());
+    for (size_t row = 0; row < serialErrors->rowCount(); ++row) {
+      TS_ASSERT_EQUALS(parallelErrors->String(row, 0), serialErrors->String(row, 0));
+      for (size_t col = 1; col < serialErrors->columnCount(); ++col) {
+        TS_ASSERT_DELTA(parallelErrors->Double(row, col), serialErrors->Double(row, col), 1e-6);
+      }
+    }
+    TS_ASSERT_EQUALS(parallelPdf->columnCount(), serialPdf->columnCount());
+    for (size_t row = 0; row < serialPdf->rowCount(); row += 25) {
+      for (size_t col = 0; col < serialPdf->columnCount(); ++col) {
+        TS_ASSERT_DELTA(parallelPdf->Double(row, col), serialPdf->Double(row, col), 1e-6);
+      }
+    }
+    ads.clear();
+  }
+};
+
+class ProfileChiSquared1DTestPerformance : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ProfileChiSquared1DTestPerformance *createSuite() { return new ProfileChiSquared1DTestPerformance(); }
+  static void destroySuite(ProfileChiSquared1DTestPerformance *suite) {
+    AnalysisDataService::Instance().clear();
+    delete suite;
+  }
+
+  ProfileChiSquared1DTestPerformance() {
+    // Profile around the minimum of a peak with five free parameters
+    m_ws = FitTestHelpers::generateCurveDataForFit(FitTestHelpers::SingleB2BPeak);
+    auto fit = FitTestHelpers::runFitAlgorithm(m_ws, FitTestHelpers::SingleB2BPeak);
+    IFunction_sptr function = fit->getProperty("Function");
+    m_function = function->asString();
+  }
+
+  void test_profile_serial() { runProfile(false); }
+
+  void test_profile_parallel() { runProfile(true); }
+
+private:
+  void runProfile(bool parallel) {
+    ProfileChiSquared1D alg;
+    alg.initialize();
+    alg.setProperty("Function", m_function);
+    alg.setProperty("InputWorkspace", m_ws);
+    alg.setProperty("Output", "ProfileChiSquared1DPerf");
+    alg.setProperty("Parallel", parallel);
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+  }
+
+  MatrixWorkspace_sptr m_ws;
+  std::string m_function;
 };
\ No newline at end of file
@@ -11,6 +11,8 @@
 #include "MantidAPI/CompositeFunction.h"
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionValues.h"
+#include "MantidAPI/JointDomain.h"
+#include "MantidAPI/MultiDomainFunction.h"
 #include "MantidCurveFitting/CostFunctions/CostFuncLeastSquares.h"
 #include "MantidCurveFitting/CostFunctions/CostFuncRwp.h"
 #include "MantidCurveFitting/FuncMinimizers/BFGS_Minimizer.h"
@@ -19,8 +21,10 @@
 #include "MantidCurveFitting/Functions/ExpDecay.h"
 #include "MantidCurveFitting/Functions/Gaussian.h"
 #include "MantidCurveFitting/Functions/LinearBackground.h"
+#include "MantidCurveFitting/Functions/Polynomial.h"
 #include "MantidCurveFitting/Functions/UserFunction.h"
 #include "MantidCurveFitting/GSLFunctions.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include <gsl/gsl_blas.h>
 #include <sstream>
@@ -213,6 +217,179 @@ public:
     TS_ASSERT_DELTA(L, -0.145, 1e-10); // L + costFun->val() == 0
   }
 
+  void test_valDerivHessian_over_several_data_blocks() {
+    // Enough points to be split into more than one block of rows
+    const size_t ny = 10001;
+    API::FunctionDomain1D_sptr domain(new API::FunctionDomain1DVector(0.0, 1.0, ny));
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    std::vector<double> y(ny), e(ny);
+    const auto &x = dynamic_cast<const API::FunctionDomain1D &>(*domain);
+    for (size_t i = 0; i < ny; ++i) {
+      y[i] = 1.0 + 2.0 * x[i] - 3.0 * x[i] * x[i] + sin(10.0 * x[i]);
+      e[i] = 1.0 + 0.5 * x[i];
+    }
+    values->setFitData(y);
+    values->setFitWeights(e);
+
+    auto fun = std::make_shared<Polynomial>();
+    fun->setAttributeValue("n", 3);
+    fun->setParameter("A0", 0.5);
+    fun->setParameter("A1", 1.5);
+    fun->setParameter("A2", -2.0);
+    fun->setParameter("A3", 0.3);
+    fun->fix(2);
+
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+    const double value = costFun->valDerivHessian();
+    const EigenVector &g = costFun->getDeriv();
+    const EigenMatrix &H = costFun->getHessian();
+
+    // Reference values computed directly from the Jacobian
+    API::FunctionValues calculated(*domain);
+    fun->function(*domain, calculated);
+    Jacobian jacobian(ny, fun->nParams());
+    fun->functionDeriv(*domain, jacobian);
+    const std::vector<size_t> active{0, 1, 3};
+    double expectedValue = 0.0;
+    std::vector<double> expectedDeriv(active.size(), 0.0);
+    std::vector<double> expectedHessian(active.size() * active.size(), 0.0);
+    for (size_t i = 0; i < ny; ++i) {
+      const double w = values->getFitWeight(i);
+      const double r = (calculated.getCalculated(i) - y[i]) * w;
+      expectedValue += 0.5 * r * r;
+      for (size_t a = 0; a < active.size(); ++a) {
+        expectedDeriv[a] += r * jacobian.get(i, active[a]) * w;
+        for (size_t b = 0; b < active.size(); ++b) {
+          expectedHessian[a * active.size() + b] += jacobian.get(i, active[a]) * jacobian.get(i, active[b]) * w * w;
+        }
+      }
+    }
+
+    TS_ASSERT_DELTA(value, expectedValue, 1e-8 * expectedValue);
+    TS_ASSERT_EQUALS(g.size(), active.size());
+    TS_ASSERT_EQUALS(H.size1(), active.size());
+    for (size_t a = 0; a < active.size(); ++a) {
+      TS_ASSERT_DELTA(g.get(a), expectedDeriv[a], 1e-8 * std::abs(expectedDeriv[a]) + 1e-10);
+      for (size_t b = 0; b < active.size(); ++b) {
+        const double expected = expectedHessian[a * active.size() + b];
+        TS_ASSERT_DELTA(H.get(a, b), expected, 1e-8 * std::abs(expected));
+      }
+    }
+
+    // The partial sums are reduced in a fixed order so repeated evaluations
+    // are bitwise identical
+    const EigenVector firstDeriv(g);
+    const EigenMatrix firstHessian(H);
+    costFun->setParameter(0, costFun->getParameter(0));
+    TS_ASSERT_EQUALS(costFun->valDerivHessian(), value);
+    for (size_t a = 0; a < active.size(); ++a) {
+      TS_ASSERT_EQUALS(costFun->getDeriv().get(a), firstDeriv.get(a));
+      for (size_t b = 0; b < active.size(); ++b) {
+        TS_ASSERT_EQUALS(costFun->getHessian().get(a, b), firstHessian.get(a, b));
+      }
+    }
+  }
+
+  void test_multi_domain_function_derivatives_by_domain() {
+    auto domain = std::make_shared<API::JointDomain>();
+    std::vector<double> y, e;
+    for (size_t i = 0; i < 3; ++i) {
+      auto memberDomain = std::make_shared<API::FunctionDomain1DVector>(-1.0 + 0.1 * double(i), 1.0, 20 + i);
+      domain->addDomain(memberDomain);
+      for (size_t j = 0; j < memberDomain->size(); ++j) {
+        const double x = (*memberDomain)[j];
+        y.emplace_back(double(i) + 0.5 * x + 3.0 * exp(-x * x / 0.08));
+        e.emplace_back(1.0 + 0.1 * double(j));
+      }
+    }
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    values->setFitData(y);
+    values->setFitWeights(e);
+
+    auto fun = makeMultiDomainFunction();
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+    const double value = costFun->valDerivHessian();
+    const EigenVector &g = costFun->getDeriv();
+    const EigenMatrix &H = costFun->getHessian();
+
+    // Reference values computed from the full Jacobian
+    API::FunctionValues calculated(*domain);
+    fun->function(*domain, calculated);
+    const size_t ny = domain->size();
+    Jacobian jacobian(ny, fun->nParams());
+    fun->functionDeriv(*domain, jacobian);
+    std::vector<size_t> active;
+    for (size_t ip = 0; ip < fun->nParams(); ++ip) {
+      if (fun->isActive(ip))
+        active.emplace_back(ip);
+    }
+    TS_ASSERT_EQUALS(active.size(), 8);
+    TS_ASSERT_EQUALS(g.size(), active.size());
+    double expectedValue = 0.0;
+    for (size_t i = 0; i < ny; ++i) {
+      const double r = (calculated.getCalculated(i) - y[i]) * values->getFitWeight(i);
+      expectedValue += 0.5 * r * r;
+    }
+    TS_ASSERT_DELTA(value, expectedValue, 1e-10 * expectedValue);
+    for (size_t a = 0; a < active.size(); ++a) {
+      double d = 0.0;
+      for (size_t i = 0; i < ny; ++i) {
+        const double w = values->getFitWeight(i);
+        d += (calculated.getCalculated(i) - y[i]) * w * jacobian.get(i, active[a]) * w;
+      }
+      TS_ASSERT_DELTA(g.get(a), d, 1e-10 * (std::abs(d) + 1.0));
+      for (size_t b = 0; b < active.size(); ++b) {
+        double h = 0.0;
+        for (size_t i = 0; i < ny; ++i) {
+          const double w = values->getFitWeight(i);
+          h += jacobian.get(i, active[a]) * jacobian.get(i, active[b]) * w * w;
+        }
+        TS_ASSERT_DELTA(H.get(a, b), h, 1e-10 * (std::abs(h) + 1.0));
+      }
+    }
+
+    // The background parameters are local to their domains, the peak is global
+    const std::vector<std::vector<size_t>> expectedBlocks{{0, 1}, {2}, {3, 4}};
+    TS_ASSERT_EQUALS(costFun->getHessianBlocks(), expectedBlocks);
+  }
+
+  void test_multi_domain_fit_with_LM_uses_block_structure() {
+    auto domain = std::make_shared<API::JointDomain>();
+    std::vector<double> y;
+    for (size_t i = 0; i < 3; ++i) {
+      auto memberDomain = std::make_shared<API::FunctionDomain1DVector>(-1.0, 1.0, 30);
+      domain->addDomain(memberDomain);
+      for (size_t j = 0; j < memberDomain->size(); ++j) {
+        const double x = (*memberDomain)[j];
+        y.emplace_back(double(i) + 0.2 * x + 2.0 * exp(-0.5 * (x - 0.1) * (x - 0.1) / 0.04));
+      }
+    }
+    API::FunctionValues_sptr values(new API::FunctionValues(*domain));
+    values->setFitData(y);
+    values->setFitWeights(1.0);
+
+    auto fun = makeMultiDomainFunction();
+    fun->unfix(fun->parameterIndex("f1.A1"));
+    auto costFun = std::make_shared<CostFuncLeastSquares>();
+    costFun->setFittingFunction(fun, domain, values);
+
+    LevenbergMarquardtMDMinimizer s;
+    s.initialize(costFun);
+    TS_ASSERT(s.minimize());
+    TS_ASSERT_EQUALS(costFun->getHessianBlocks().size(), 3);
+    TS_ASSERT_DELTA(costFun->val(), 0.0, 1e-8);
+    for (size_t i = 0; i < 3; ++i) {
+      const std::string prefix = "f" + std::to_string(i) + ".";
+      TS_ASSERT_DELTA(fun->getParameter(prefix + "A0"), double(i), 1e-4);
+      TS_ASSERT_DELTA(fun->getParameter(prefix + "A1"), 0.2, 1e-4);
+    }
+    TS_ASSERT_DELTA(fun->getParameter("f3.Height"), 2.0, 1e-4);
+    TS_ASSERT_DELTA(fun->getParameter("f3.PeakCentre"), 0.1, 1e-4);
+    TS_ASSERT_DELTA(fun->getParameter("f3.Sigma"), 0.2, 1e-4);
+  }
+
   void test_Fixing_parameter() {
     std::vector<double> x(10), y(10);
     for (size_t i = 0; i < x.size(); ++i) {
@@ -341,4 +518,64 @@ public:
       //}
     }
   }
+
+private:
+  /// A local linear background on each of three domains plus a global peak
+  std::shared_ptr<API::MultiDomainFunction> makeMultiDomainFunction() {
+    auto fun = std::make_shared<API::MultiDomainFunction>();
+    for (size_t i = 0; i < 3; ++i) {
+      auto bk = std::make_shared<LinearBackground>();
+      bk->initialize();
+      bk->setParameter("A0", 0.5 * double(i));
+      bk->setParameter("A1", 0.1);
+      fun->addFunction(bk);
+      fun->setDomainIndex(i, i);
+    }
+    auto peak = std::make_shared<Gaussian>();
+    peak->initialize();
+    peak->setParameter("Height", 2.5);
+    peak->setParameter("PeakCentre", 0.05);
+    peak->setParameter("Sigma", 0.25);
+    fun->addFunction(peak);
+    fun->setDomainIndices(3, {0, 1, 2});
+    fun->fix(fun->parameterIndex("f1.A1"));
+    return fun;
+  }
+};
+
+class LeastSquaresTestPerformance : public CxxTest::TestSuite {
+public:
+  static LeastSquaresTestPerformance *createSuite() { return new LeastSquaresTestPerformance(); }
+  static void destroySuite(LeastSquaresTestPerformance *suite) { delete suite; }
+
+  LeastSquaresTestPerformance() {
+    const size_t ny = 200000;
+    m_domain = std::make_shared<API::FunctionDomain1DVector>(-1.0, 1.0, ny);
+    m_values = std::make_shared<API::FunctionValues>(*m_domain);
+    std::vector<double> y(ny);
+    const auto &x = dynamic_cast<const API::FunctionDomain1D &>(*m_domain);
+    for (size_t i = 0; i < ny; ++i) {
+      y[i] = cos(3.0 * x[i]) + 0.1 * x[i];
+    }
+    m_values->setFitData(y);
+    m_values->setFitWeights(1.0);
+
+    auto fun = std::make_shared<Polynomial>();
+    fun->setAttributeValue("n", 49);
+    m_costFun = std::make_shared<CostFuncLeastSquares>();
+    m_costFun->setFittingFunction(fun, m_domain, m_values);
+  }
+
+  void test_valDerivHessian_many_points_and_parameters() {
+    for (size_t i = 0; i < 5; ++i) {
+      // Changing a parameter forces a full re-evaluation
+      m_costFun->setParameter(0, 0.1 * static_cast<double>(i + 1));
+      TS_ASSERT(m_costFun->valDerivHessian() > 0.0);
+    }
+  }
+
+private:
+  API::FunctionDomain1D_sptr m_domain;
+  API::FunctionValues_sptr m_values;
+  std::shared_ptr<CostFuncLeastSquares> m_costFun;
 };
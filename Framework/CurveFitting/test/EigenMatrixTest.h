@@ -402,4 +402,35 @@ public:
     TS_ASSERT_DELTA(test_sol[0], 5.0, 1e-8);
     TS_ASSERT_DELTA(test_sol[1], 2.0, 1e-8);
   }
+
+  void test_solveBlockArrow() {
+    // Indices {0, 1} and {2} couple only to themselves and to index 3
+    EigenMatrix m({{4.0, 1.0, 0.0, 1.0}, {1.0, 3.0, 0.0, 0.5}, {0.0, 0.0, 2.0, 1.0}, {1.0, 0.5, 1.0, 5.0}});
+    EigenVector b({1.0, 2.0, 3.0, 4.0});
+    EigenVector x;
+    m.solveBlockArrow({{0, 1}, {2}}, b, x);
+    EigenVector expected;
+    EigenMatrix mm = m;
+    mm.solve(b, expected);
+
+    TS_ASSERT_EQUALS(x.size(), 4);
+    for (size_t i = 0; i < 4; ++i) {
+      TS_ASSERT_DELTA(x[i], expected[i], 1e-12);
+    }
+  }
+
+  void test_solveBlockArrow_singular_block() {
+    EigenMatrix m({{1.0, 2.0, 0.0}, {2.0, 4.0, 0.0}, {0.0, 0.0, 1.0}});
+    EigenVector b({1.0, 2.0, 3.0});
+    EigenVector x;
+    TS_ASSERT_THROWS(m.solveBlockArrow({{0, 1}}, b, x), const std::invalid_argument &);
+  }
+
+  void test_solveBlockArrow_bad_blocks() {
+    EigenMatrix m({{1.0, 0.0}, {0.0, 1.0}});
+    EigenVector b({1.0, 2.0});
+    EigenVector x;
+    TS_ASSERT_THROWS(m.solveBlockArrow({{0}, {0}}, b, x), const std::invalid_argument &);
+    TS_ASSERT_THROWS(m.solveBlockArrow({{2}}, b, x), const std::invalid_argument &);
+  }
 };
@@ -34,6 +34,7 @@
 #include "MantidKernel/PropertyManager.h"
 
 #include <sstream>
+#include <tuple>
 
 using namespace Mantid;
 using namespace Mantid::CurveFitting;
@@ -480,6 +481,39 @@ public:
     TS_ASSERT_DELTA(v1d->getFitData(0), 4.0, 1e-13);
   }
 
+  void test_parallel_domain_fit_gives_same_result_as_simple_domain() {
+    auto ws = createTestWorkspace(false, 1, 5000);
+    auto runFit = [&ws](const std::string &domainType) {
+      API::IFunction_sptr fun(new ExpDecay);
+      fun->setParameter("Height", 1.);
+      fun->setParameter("Lifetime", 1.);
+      Fit fit;
+      fit.initialize();
+      fit.setProperty("Function", fun);
+      fit.setProperty("DomainType", domainType);
+      fit.setProperty("InputWorkspace", ws);
+      fit.setProperty("WorkspaceIndex", 0);
+      if (domainType != "Simple") {
+        // Split the data into many small domains evaluated concurrently
+        fit.setProperty("MaxSize", 50);
+      }
+      fit.execute();
+      TS_ASSERT(fit.isExecuted());
+      const double chi2 = fit.getProperty("OutputChi2overDoF");
+      return std::make_tuple(fun->getParameter("Height"), fun->getParameter("Lifetime"), chi2);
+    };
+
+    const auto [height, lifetime, chi2] = runFit("Simple");
+    TS_ASSERT_DELTA(height, 10.0, 1e-3);
+    TS_ASSERT_DELTA(lifetime, 0.5, 1e-4);
+    for (int repeat = 0; repeat < 5; ++repeat) {
+      const auto [parHeight, parLifetime, parChi2] = runFit("Parallel");
+      TS_ASSERT_DELTA(parHeight, height, 1e-8 * height);
+      TS_ASSERT_DELTA(parLifetime, lifetime, 1e-8 * lifetime);
+      TS_ASSERT_DELTA(parChi2, chi2, 1e-10);
+    }
+  }
+
   void test_Composite_Function_With_SeparateMembers_Option_On_FitMW_Outputs_Composite_Values_Plus_Each_Member() {
     const bool histogram = true;
     auto ws2 = createTestWorkspace(histogram);
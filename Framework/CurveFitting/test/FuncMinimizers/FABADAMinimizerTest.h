@@ -249,6 +249,59 @@ public:
     TS_ASSERT(param->Double(1, 1) == fun->getParameter("Lifetime"));
   }
 
+  void test_expDecay_multiple_chains() {
+    auto ws2 = createExpDecayWorkspace();
+
+    Mantid::API::IFunction_sptr fun(new ExpDecay);
+    fun->setParameter("Height", 8.);
+    fun->setParameter("Lifetime", 1.0);
+
+    Fit fit;
+    fit.initialize();
+    fit.setChild(true);
+    fit.setProperty("Function", fun);
+    fit.setProperty("InputWorkspace", ws2);
+    fit.setProperty("WorkspaceIndex", 0);
+    fit.setProperty("CreateOutput", true);
+    fit.setProperty("MaxIterations", 100000);
+    fit.setProperty("Minimizer", "FABADA,ChainLength=10000,StepsBetweenValues="
+                                 "10,ConvergenceCriteria=0.1,NumberOfChains=3,"
+                                 "ConvergedChain=ConvergedChain,Parameters="
+                                 "Parameters,ChainDiagnostics=ChainDiagnostics");
+
+    TS_ASSERT_THROWS_NOTHING(fit.execute());
+    TS_ASSERT(fit.isExecuted());
+
+    TS_ASSERT_DELTA(fun->getParameter("Height"), 10.0, 0.1);
+    TS_ASSERT_DELTA(fun->getParameter("Lifetime"), 0.5, 0.01);
+    TS_ASSERT_DELTA(fun->getError(0), 0.7, 1e-1);
+    TS_ASSERT_DELTA(fun->getError(1), 0.06, 1e-2);
+
+    // The converged chain output is the first chain only
+    MatrixWorkspace_sptr convChain = fit.getProperty("ConvergedChain");
+    TS_ASSERT(convChain);
+    TS_ASSERT_EQUALS(convChain->x(0).size(), 1000);
+
+    ITableWorkspace_sptr param = fit.getProperty("Parameters");
+    TS_ASSERT(param);
+    TS_ASSERT(param->Double(0, 1) == fun->getParameter("Height"));
+    TS_ASSERT(param->Double(1, 1) == fun->getParameter("Lifetime"));
+
+    ITableWorkspace_sptr diagnostics = fit.getProperty("ChainDiagnostics");
+    TS_ASSERT(diagnostics);
+    TS_ASSERT_EQUALS(diagnostics->rowCount(), fun->nParams());
+    TS_ASSERT_EQUALS(diagnostics->columnCount(), 2 + 3 * 3);
+    TS_ASSERT_EQUALS(diagnostics->getColumn(1)->name(), "R-hat");
+    TS_ASSERT_EQUALS(diagnostics->getColumn(5)->name(), "Chain 1 Value");
+    for (size_t i = 0; i < fun->nParams(); ++i) {
+      TS_ASSERT_EQUALS(diagnostics->String(i, 0), fun->parameterName(i));
+      TS_ASSERT_DELTA(diagnostics->Double(i, 1), 1.0, 0.1);
+      for (size_t chain = 0; chain < 3; ++chain) {
+        TS_ASSERT_DELTA(diagnostics->Double(i, 2 + 3 * chain), fun->getParameter(i), 3.0 * fun->getError(i));
+      }
+    }
+  }
+
   void test_low_MaxIterations() {
     auto ws2 = createExpDecayWorkspace();
 
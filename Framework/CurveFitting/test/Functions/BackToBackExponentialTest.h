@@ -11,6 +11,7 @@
 #include "MantidAPI/FunctionDomain1D.h"
 #include "MantidAPI/FunctionValues.h"
 #include "MantidCurveFitting/Functions/BackToBackExponential.h"
+#include "MantidCurveFitting/Jacobian.h"
 
 #include <cmath>
 
@@ -172,6 +173,32 @@ public:
     }
   }
 
+  void test_analytic_derivatives_match_numerical() { checkAnalyticDerivatives(0.8); }
+
+  void test_analytic_derivatives_match_numerical_for_negative_S() { checkAnalyticDerivatives(-0.8); }
+
+  void checkAnalyticDerivatives(double s) {
+    BackToBackExponential b2bExp;
+    b2bExp.initialize();
+    b2bExp.setParameter("I", 2.1);
+    b2bExp.setParameter("A", 1.3);
+    b2bExp.setParameter("B", 0.4);
+    b2bExp.setParameter("X0", 0.5);
+    b2bExp.setParameter("S", s);
+    b2bExp.setStepSizeMethod(Mantid::API::IFunction::StepSizeMethod::SQRT_EPSILON);
+
+    Mantid::API::FunctionDomain1DVector x(-5, 10, 61);
+    Mantid::CurveFitting::Jacobian analytic(x.size(), 5);
+    Mantid::CurveFitting::Jacobian numerical(x.size(), 5);
+    b2bExp.functionDeriv(x, analytic);
+    b2bExp.calNumericalDeriv(x, numerical);
+    for (size_t i = 0; i < x.size(); ++i) {
+      for (size_t j = 0; j < 5; ++j) {
+        TS_ASSERT_DELTA(analytic.get(i, j), numerical.get(i, j), 1e-6);
+      }
+    }
+  }
+
   void testIntensity() {
     const double s = 4.0;
     const double I = 2.1;
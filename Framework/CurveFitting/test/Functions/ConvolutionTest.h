@@ -417,6 +417,37 @@ public:
     }
   }
 
+  void test_delta_function_follows_resolution_changes() {
+    Convolution conv;
+    auto res = std::make_shared<ConvolutionTest_Gauss>();
+    res->setParameter("c", 0.0);
+    res->setParameter("h", 1.0);
+    res->setParameter("s", 1.0);
+    conv.addFunction(res);
+    auto fun = std::make_shared<DeltaFunction>();
+    fun->setParameter("Height", 2.0);
+    conv.addFunction(fun);
+
+    const int N = 116;
+    double xs[N];
+    double xm{-4.0}, xM{4.0};
+    double dx{(xM - xm) / (N - 1)};
+    for (int i = 0; i < N; i++) {
+      xs[i] = xm + i * dx;
+    }
+    FunctionDomain1DView ds(&xs[0], N);
+    FunctionValues first(ds), second(ds), changed(ds);
+    conv.function(ds, first);
+    conv.function(ds, second);
+    res->setParameter("s", 2.0);
+    conv.function(ds, changed);
+    for (int i = 0; i < N; i++) {
+      TS_ASSERT_EQUALS(second.getCalculated(i), first.getCalculated(i));
+      TS_ASSERT_DELTA(first.getCalculated(i), 2.0 * exp(-xs[i] * xs[i]), 1e-10);
+      TS_ASSERT_DELTA(changed.getCalculated(i), 2.0 * exp(-2.0 * xs[i] * xs[i]), 1e-10);
+    }
+  }
+
   void test_convoluting_two_composite_functions() {
     Convolution conv;
     auto compositeFunction1 = std::make_shared<CompositeFunction>();
@@ -98,4 +98,38 @@ public:
     // Check that the 'a' parameter has not been reset
     TS_ASSERT_EQUALS(1.1, fun.getParameter("a"));
   }
+
+  void test_function_on_many_points() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("a*x^2+b*exp(-x)"));
+    fun.setParameter("a", 0.3);
+    fun.setParameter("b", -1.5);
+
+    // More points than are evaluated by muParser at once
+    const size_t nData = 2500;
+    std::vector<double> x(nData), y(nData);
+    for (size_t i = 0; i < nData; i++) {
+      x[i] = 0.01 * static_cast<double>(i);
+    }
+    fun.function1D(y.data(), x.data(), nData);
+    for (size_t i = 0; i < nData; i++) {
+      TS_ASSERT_DELTA(y[i], 0.3 * x[i] * x[i] - 1.5 * exp(-x[i]), 1e-10);
+    }
+
+    // Parameter changes are picked up by the next evaluation
+    fun.setParameter("b", 2.0);
+    fun.function1D(y.data(), x.data(), 10);
+    for (size_t i = 0; i < 10; i++) {
+      TS_ASSERT_DELTA(y[i], 0.3 * x[i] * x[i] + 2.0 * exp(-x[i]), 1e-10);
+    }
+  }
+
+  void test_function_throws_for_invalid_formula() {
+    UserFunction fun;
+    fun.setAttribute("Formula", UserFunction::Attribute("a*x"));
+    fun.setAttribute("Formula", UserFunction::Attribute("a*("));
+
+    std::vector<double> x(3, 1.0), y(3);
+    TS_ASSERT_THROWS(fun.function1D(y.data(), x.data(), x.size()), const std::invalid_argument &);
+  }
 };
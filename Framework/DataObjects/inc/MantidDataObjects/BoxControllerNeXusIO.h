@@ -38,6 +38,19 @@ public:
   /**Return the size of the NeXus data block used in NeXus data array*/
   size_t getDataChunk() const override { return m_dataChunk; }
 
+  /** Enable deflate compression of the events dataset. Has an effect only on
+   * datasets created after the call; reading compressed data is transparent */
+  void setCompression(const bool compress) { m_compressEvents = compress; }
+  /// @return true if newly created events datasets are compressed
+  bool isCompressed() const { return m_compressEvents; }
+
+  /** Read up to this number of events in one go when a load request misses the
+   * read-ahead buffer, so that subsequent requests for neighbouring events are
+   * served from memory. Zero (the default) disables read-ahead. */
+  void setReadAheadSize(const size_t nEvents);
+  /// @return the maximal number of events read ahead of a load request
+  size_t getReadAheadSize() const { return m_readAheadEvents; }
+
   bool openFile(const std::string &fileName, const std::string &mode) override;
 
   void saveBlock(const std::vector<float> & /* DataBlock */, const uint64_t /*blockPosition*/) const override;
@@ -123,6 +136,8 @@ private:
   /// The size of the events block which can be written in the neXus array at
   /// once (continuous part of the data block)
   size_t m_dataChunk;
+  /// if true, the events dataset is created chunked and deflate-compressed
+  bool m_compressEvents;
   /// shared pointer to the box controller, which is repsoponsible for this IO
   API::BoxController *const m_bc;
   //------
@@ -135,6 +150,16 @@ private:
   /// lock Nexus file operations as Nexus is not thread safe
   mutable std::mutex m_fileMutex;
 
+  /// the number of events to read ahead on a load request
+  size_t m_readAheadEvents;
+  /// file position of the first event held in the read-ahead buffer
+  mutable uint64_t m_readAheadStart;
+  /// number of events held in the read-ahead buffer
+  mutable uint64_t m_readAheadLength;
+  /// read-ahead buffers; only the one of the type used to read the file is filled
+  mutable std::vector<float> m_readAheadFloat;
+  mutable std::vector<double> m_readAheadDouble;
+
   // Mainly static information which may be split into different IO classes
   // selected through chein of responsibility.
   /// number of bytes in the event coordinates (coord_t length). Set by
@@ -191,6 +216,10 @@ private:
   /// Load generic data block from the opened NeXus file.
   template <typename Type>
   void loadGenericBlock(std::vector<Type> &Block, const uint64_t blockPosition, const size_t nPoints) const;
+  /// The read-ahead buffer of the given type
+  template <typename Type> std::vector<Type> &readAheadBuffer() const;
+  /// Drop the contents of the read-ahead buffers
+  void clearReadAheadBuffers() const;
 };
 } // namespace DataObjects
 } // namespace Mantid
@@ -34,9 +34,10 @@ std::string BoxControllerNeXusIO::g_DBDataName("free_space_blocks");
  @param bc shared pointer to the box controller which uses this IO operations
 */
 BoxControllerNeXusIO::BoxControllerNeXusIO(API::BoxController *const bc)
-    : m_File(nullptr), m_ReadOnly(true), m_dataChunk(DATA_CHUNK), m_bc(bc), m_BlockStart(2, 0), m_BlockSize(2, 0),
-      m_CoordSize(sizeof(coord_t)), m_EventType(FatEvent), m_EventsVersion("1.0"),
-      m_EventDataVersion(EventDataVersion::EDVGoniometer), m_ReadConversion(noConversion) {
+    : m_File(nullptr), m_ReadOnly(true), m_dataChunk(DATA_CHUNK), m_compressEvents(false), m_bc(bc),
+      m_BlockStart(2, 0), m_BlockSize(2, 0), m_readAheadEvents(0), m_readAheadStart(0), m_readAheadLength(0),
+      m_readAheadFloat(), m_readAheadDouble(), m_CoordSize(sizeof(coord_t)), m_EventType(FatEvent),
+      m_EventsVersion("1.0"), m_EventDataVersion(EventDataVersion::EDVGoniometer), m_ReadConversion(noConversion) {
   m_BlockSize[1] = 5 + m_bc->getNDims();
 
   std::copy(std::cbegin(EventHeaders), std::cend(EventHeaders), std::back_inserter(m_EventsTypeHeaders));
@@ -240,11 +241,15 @@ void BoxControllerNeXusIO::prepareNxSToWrite_CurVersion() {
     std::vector<int64_t> chunk(m_BlockSize);
     chunk[0] = static_cast<int64_t>(m_dataChunk);
 
+    // Each chunk is compressed independently by HDF5, so random access to the
+    // events of a box costs at most decompressing the chunks it spans
+    const auto compression = m_compressEvents ? ::NeXus::LZW : ::NeXus::NONE;
+
     // Make and open the data
     if (m_CoordSize == 4)
-      m_File->makeCompData("event_data", ::NeXus::FLOAT32, m_BlockSize, ::NeXus::NONE, chunk, true);
+      m_File->makeCompData("event_data", ::NeXus::FLOAT32, m_BlockSize, compression, chunk, true);
     else
-      m_File->makeCompData("event_data", ::NeXus::FLOAT64, m_BlockSize, ::NeXus::NONE, chunk, true);
+      m_File->makeCompData("event_data", ::NeXus::FLOAT64, m_BlockSize, compression, chunk, true);
 
     // A little bit of description for humans to read later
     m_File->putAttr("description", m_EventsTypeHeaders[m_EventType]);
@@ -339,6 +344,8 @@ void BoxControllerNeXusIO::saveGenericBlock(const std::vector<Type> &DataBlock,
   // makes putSlab method non-constant
   auto &mData = const_cast<std::vector<Type> &>(DataBlock);
 
+  // the data held in memory may be overwritten
+  this->clearReadAheadBuffers();
   {
     m_File->putSlab<Type>(mData, start, dims);
 
@@ -501,6 +508,9 @@ template DLLExport void BoxControllerNeXusIO::adjustEventDataBlock<float>(std::v
 template DLLExport void BoxControllerNeXusIO::adjustEventDataBlock<double>(std::vector<double> &Block,
                                                                            const std::string &accessMode) const;
 
+template <> std::vector<float> &BoxControllerNeXusIO::readAheadBuffer<float>() const { return m_readAheadFloat; }
+template <> std::vector<double> &BoxControllerNeXusIO::readAheadBuffer<double>() const { return m_readAheadDouble; }
+
 template <typename Type>
 void BoxControllerNeXusIO::loadGenericBlock(std::vector<Type> &Block, const uint64_t blockPosition,
                                             const size_t nPoints) const {
@@ -516,12 +526,49 @@ void BoxControllerNeXusIO::loadGenericBlock(std::vector<Type> &Block, const uint
 
   std::lock_guard<std::mutex> _lock(m_fileMutex);
 
-  Block.resize(size[0] * size[1]);
-  m_File->getSlab(&Block[0], start, size);
+  if (m_readAheadEvents == 0) {
+    Block.resize(size[0] * size[1]);
+    m_File->getSlab(&Block[0], start, size);
+  } else {
+    auto &buffer = readAheadBuffer<Type>();
+    if (buffer.empty() || blockPosition < m_readAheadStart ||
+        blockPosition + nPoints > m_readAheadStart + m_readAheadLength) {
+      // refill the buffer with one large read starting at the requested position
+      this->clearReadAheadBuffers();
+      const uint64_t nAvailable = this->getFileLength() - blockPosition;
+      size[0] = static_cast<int64_t>(std::max<uint64_t>(nPoints, std::min<uint64_t>(m_readAheadEvents, nAvailable)));
+      buffer.resize(size[0] * size[1]);
+      m_File->getSlab(buffer.data(), start, size);
+      m_readAheadStart = blockPosition;
+      m_readAheadLength = static_cast<uint64_t>(size[0]);
+    }
+    const auto first = buffer.cbegin() + static_cast<std::ptrdiff_t>((blockPosition - m_readAheadStart) * size[1]);
+    Block.assign(first, first + static_cast<std::ptrdiff_t>(nPoints * size[1]));
+  }
 
   adjustEventDataBlock(Block, "READ"); // insert goniometer info if necessary
 }
 
+void BoxControllerNeXusIO::clearReadAheadBuffers() const {
+  m_readAheadFloat.clear();
+  m_readAheadDouble.clear();
+  m_readAheadStart = 0;
+  m_readAheadLength = 0;
+}
+
+/** Set the number of events read from the file at once when a load request is not
+ * satisfied by the events already in memory.
+ *@param nEvents -- the number of events to read ahead; 0 disables read-ahead
+ */
+void BoxControllerNeXusIO::setReadAheadSize(const size_t nEvents) {
+  std::lock_guard<std::mutex> _lock(m_fileMutex);
+  m_readAheadEvents = nEvents;
+  this->clearReadAheadBuffers();
+  // release the memory held by a previous, larger buffer
+  m_readAheadFloat.shrink_to_fit();
+  m_readAheadDouble.shrink_to_fit();
+}
+
 /** Helper funcion which allows to convert one data fomat into another */
 template <typename FROM, typename TO> void convertFormats(const std::vector<FROM> &inData, std::vector<TO> &outData) {
   outData.reserve(inData.size());
@@ -602,6 +649,7 @@ void BoxControllerNeXusIO::closeFile() {
     m_File->closeGroup(); // close workspace group
     m_File->close();      // close NeXus file
     m_File = nullptr;
+    this->clearReadAheadBuffers();
   }
 }
 
@@ -13,6 +13,7 @@
 #include "MantidGeometry/MDGeometry/MDDimensionExtents.h"
 #include "MantidGeometry/MDGeometry/MDGeometryXMLBuilder.h"
 #include "MantidGeometry/MDGeometry/MDHistoDimension.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/Utils.h"
 #include "MantidKernel/VMD.h"
 #include "MantidKernel/WarningSuppressions.h"
@@ -28,6 +29,24 @@ using namespace Mantid::Geometry;
 using namespace Mantid::API;
 
 namespace Mantid::DataObjects {
+namespace {
+/// Workspaces with fewer bins than this are processed by a single thread
+constexpr size_t MIN_BINS_FOR_PARALLEL_LOOP = 100000;
+
+/**
+ * Apply an element-wise operation to every bin. Large workspaces are split
+ * between threads; the loop body is inlined so it can be vectorized.
+ * @param length :: number of bins
+ * @param func :: operation taking the linear index of a bin
+ */
+template <typename Func> void forEachBin(const size_t length, const Func &func) {
+  const auto nBins = static_cast<int64_t>(length);
+  PARALLEL_FOR_IF(length >= MIN_BINS_FOR_PARALLEL_LOOP)
+  for (int64_t i = 0; i < nBins; ++i)
+    func(static_cast<size_t>(i));
+}
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor given the 4 dimensions
  * @param dimX :: X dimension binning parameters
@@ -701,11 +720,11 @@ MDHistoWorkspace &MDHistoWorkspace::operator+=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "add");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] += b.m_signals[i];
     m_errorsSquared[i] += b.m_errorsSquared[i];
     m_numEvents[i] += b.m_numEvents[i];
-  }
+  });
   m_nEventsContributed += b.m_nEventsContributed;
 }
 
@@ -717,10 +736,10 @@ void MDHistoWorkspace::add(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::add(const signal_t signal, const signal_t error) {
   signal_t errorSquared = error * error;
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] += signal;
     m_errorsSquared[i] += errorSquared;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -740,11 +759,11 @@ MDHistoWorkspace &MDHistoWorkspace::operator-=(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "subtract");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] -= b.m_signals[i];
     m_errorsSquared[i] += b.m_errorsSquared[i];
     m_numEvents[i] += b.m_numEvents[i];
-  }
+  });
   m_nEventsContributed += b.m_nEventsContributed;
 }
 
@@ -756,10 +775,10 @@ void MDHistoWorkspace::subtract(const MDHistoWorkspace &b) {
  * */
 void MDHistoWorkspace::subtract(const signal_t signal, const signal_t error) {
   signal_t errorSquared = error * error;
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] -= signal;
     m_errorsSquared[i] += errorSquared;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -788,7 +807,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator*=(const MDHistoWorkspace &b_ws) {
  * */
 void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
   checkWorkspaceSize(b_ws, "multiply");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
 
@@ -800,7 +819,7 @@ void MDHistoWorkspace::multiply(const MDHistoWorkspace &b_ws) {
 
     m_signals[i] = f;
     m_errorsSquared[i] = df2;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -819,7 +838,7 @@ void MDHistoWorkspace::multiply(const signal_t signal, const signal_t error) {
   signal_t b = signal;
   signal_t db2 = error * error;
 
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
 
@@ -828,7 +847,7 @@ void MDHistoWorkspace::multiply(const signal_t signal, const signal_t error) {
 
     m_signals[i] = f;
     m_errorsSquared[i] = df2;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -857,7 +876,7 @@ MDHistoWorkspace &MDHistoWorkspace::operator/=(const MDHistoWorkspace &b_ws) {
  **/
 void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
   checkWorkspaceSize(b_ws, "divide");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
 
@@ -869,7 +888,7 @@ void MDHistoWorkspace::divide(const MDHistoWorkspace &b_ws) {
 
     m_signals[i] = f;
     m_errorsSquared[i] = df2;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -888,7 +907,7 @@ void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
   signal_t b = signal;
   signal_t db2 = error * error;
   signal_t db2_relative = db2 / (b * b);
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
 
@@ -897,7 +916,7 @@ void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
 
     m_signals[i] = f;
     m_errorsSquared[i] = df2;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -907,7 +926,7 @@ void MDHistoWorkspace::divide(const signal_t signal, const signal_t error) {
  * \f$ df^2 = a^2 / da^2 \f$
  */
 void MDHistoWorkspace::log(double filler) {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
     if (a <= 0) {
@@ -917,7 +936,7 @@ void MDHistoWorkspace::log(double filler) {
       m_signals[i] = std::log(a);
       m_errorsSquared[i] = da2 / (a * a);
     }
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -927,7 +946,7 @@ void MDHistoWorkspace::log(double filler) {
  * \f$ df^2 = (ln(10)^-2) * a^2 / da^2 \f$
  */
 void MDHistoWorkspace::log10(double filler) {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t da2 = m_errorsSquared[i];
     if (a <= 0) {
@@ -937,7 +956,7 @@ void MDHistoWorkspace::log10(double filler) {
       m_signals[i] = std::log10(a);
       m_errorsSquared[i] = 0.1886117 * da2 / (a * a); // 0.1886117  = ln(10)^-2
     }
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -947,12 +966,12 @@ void MDHistoWorkspace::log10(double filler) {
  * \f$ df^2 = f^2 * da^2 \f$
  */
 void MDHistoWorkspace::exp() {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t f = std::exp(m_signals[i]);
     signal_t da2 = m_errorsSquared[i];
     m_signals[i] = f;
     m_errorsSquared[i] = f * f * da2;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -964,13 +983,13 @@ void MDHistoWorkspace::exp() {
  */
 void MDHistoWorkspace::power(double exponent) {
   double exponent_squared = exponent * exponent;
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t a = m_signals[i];
     signal_t f = std::pow(a, exponent);
     signal_t da2 = m_errorsSquared[i];
     m_signals[i] = f;
     m_errorsSquared[i] = f * f * exponent_squared * da2 / (a * a);
-  }
+  });
 }
 
 //==============================================================================================
@@ -989,10 +1008,10 @@ void MDHistoWorkspace::power(double exponent) {
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator&=(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "&= (and)");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) && (b.m_signals[i] != 0 && !b.m_masks[i])) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
   return *this;
 }
 /// @endcond DOXYGEN_BUG
@@ -1006,10 +1025,10 @@ MDHistoWorkspace &MDHistoWorkspace::operator&=(const MDHistoWorkspace &b) {
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator|=(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "|= (or)");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) || (b.m_signals[i] != 0 && !b.m_masks[i])) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
   return *this;
 }
 
@@ -1023,10 +1042,10 @@ MDHistoWorkspace &MDHistoWorkspace::operator|=(const MDHistoWorkspace &b) {
  * @return *this after operation */
 MDHistoWorkspace &MDHistoWorkspace::operator^=(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "^= (xor)");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = ((m_signals[i] != 0 && !m_masks[i]) ^ (b.m_signals[i] != 0 && !b.m_masks[i])) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
   return *this;
 }
 
@@ -1037,10 +1056,10 @@ MDHistoWorkspace &MDHistoWorkspace::operator^=(const MDHistoWorkspace &b) {
  * 0.0 is "false", all other values are "true". All errors are set to 0.
  */
 void MDHistoWorkspace::operatorNot() {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = (m_signals[i] == 0.0 || m_masks[i]) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0.0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1053,10 +1072,10 @@ void MDHistoWorkspace::operatorNot() {
  */
 void MDHistoWorkspace::lessThan(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "lessThan");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = (m_signals[i] < b.m_signals[i]) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0.0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1068,10 +1087,10 @@ void MDHistoWorkspace::lessThan(const MDHistoWorkspace &b) {
  * @param signal :: signal value on the RHS of the comparison.
  */
 void MDHistoWorkspace::lessThan(const signal_t signal) {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = (m_signals[i] < signal) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0.0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1084,10 +1103,10 @@ void MDHistoWorkspace::lessThan(const signal_t signal) {
  */
 void MDHistoWorkspace::greaterThan(const MDHistoWorkspace &b) {
   checkWorkspaceSize(b, "greaterThan");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = (m_signals[i] > b.m_signals[i]) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1099,10 +1118,10 @@ void MDHistoWorkspace::greaterThan(const MDHistoWorkspace &b) {
  * @param signal :: signal value on the RHS of the comparison.
  */
 void MDHistoWorkspace::greaterThan(const signal_t signal) {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     m_signals[i] = (m_signals[i] > signal) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1116,11 +1135,11 @@ void MDHistoWorkspace::greaterThan(const signal_t signal) {
  */
 void MDHistoWorkspace::equalTo(const MDHistoWorkspace &b, const signal_t tolerance) {
   checkWorkspaceSize(b, "equalTo");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t diff = fabs(m_signals[i] - b.m_signals[i]);
     m_signals[i] = (diff < tolerance) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1133,11 +1152,11 @@ void MDHistoWorkspace::equalTo(const MDHistoWorkspace &b, const signal_t toleran
  * @param tolerance :: accept this deviation from a perfect equality
  */
 void MDHistoWorkspace::equalTo(const signal_t signal, const signal_t tolerance) {
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     signal_t diff = fabs(m_signals[i] - signal);
     m_signals[i] = (diff < tolerance) ? 1.0 : 0.0;
     m_errorsSquared[i] = 0;
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1159,12 +1178,12 @@ void MDHistoWorkspace::equalTo(const signal_t signal, const signal_t tolerance)
 void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask, const MDHistoWorkspace &values) {
   checkWorkspaceSize(mask, "setUsingMask");
   checkWorkspaceSize(values, "setUsingMask");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     if (mask.m_signals[i] != 0.0) {
       m_signals[i] = values.m_signals[i];
       m_errorsSquared[i] = values.m_errorsSquared[i];
     }
-  }
+  });
 }
 
 //----------------------------------------------------------------------------------------------
@@ -1187,12 +1206,12 @@ void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask, const MDHistoW
 void MDHistoWorkspace::setUsingMask(const MDHistoWorkspace &mask, const signal_t signal, const signal_t error) {
   signal_t errorSquared = error * error;
   checkWorkspaceSize(mask, "setUsingMask");
-  for (size_t i = 0; i < m_length; ++i) {
+  forEachBin(m_length, [&](const size_t i) {
     if (mask.m_signals[i] != 0.0) {
       m_signals[i] = signal;
       m_errorsSquared[i] = errorSquared;
     }
-  }
+  });
 }
 
 /**
@@ -1231,11 +1250,7 @@ void MDHistoWorkspace::setMDMaskAt(const size_t &index, bool mask) {
  * Note that this clears the mask flag but does not restore the data
  * which was set to NaN when it was masked.
  */
-void MDHistoWorkspace::clearMDMasking() {
-  for (size_t i = 0; i < this->getNPoints(); ++i) {
-    m_masks[i] = false;
-  }
-}
+void MDHistoWorkspace::clearMDMasking() { std::fill_n(m_masks.get(), this->getNPoints(), false); }
 
 uint64_t MDHistoWorkspace::getNEvents() const {
   volatile uint64_t cach = this->m_nEventsContributed;
@@ -1250,8 +1265,10 @@ uint64_t MDHistoWorkspace::getNEvents() const {
 
 uint64_t MDHistoWorkspace::sumNContribEvents() const {
   uint64_t sum(0);
-  for (size_t i = 0; i < m_length; ++i)
-    sum += uint64_t(m_numEvents[i]);
+  const auto nBins = static_cast<int64_t>(m_length);
+  PRAGMA_OMP(parallel for reduction(+ : sum) if (m_length >= MIN_BINS_FOR_PARALLEL_LOOP))
+  for (int64_t i = 0; i < nBins; ++i)
+    sum += uint64_t(m_numEvents[static_cast<size_t>(i)]);
 
   return sum;
 }
@@ -9,6 +9,7 @@
 #include "MantidAPI/FileFinder.h"
 #include "MantidDataObjects/BoxControllerNeXusIO.h"
 #include "MantidFrameworkTestHelpers/MDEventsTestHelper.h"
+#include "MantidKernel/Exception.h"
 
 #include <map>
 #include <memory>
@@ -212,11 +213,12 @@ public:
     }
   };
 
-  template <typename FROM, typename TO> void WriteReadRead() {
+  template <typename FROM, typename TO> void WriteReadRead(const bool compress = false) {
     using Mantid::DataObjects::BoxControllerNeXusIO;
 
     auto pSaver = createTestBoxController();
     pSaver->setDataType(sizeof(FROM), "MDEvent");
+    pSaver->setCompression(compress);
     std::string FullPathFile;
 
     TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
@@ -256,6 +258,52 @@ public:
 
   void test_WriteFloatReadDouble() { this->WriteReadRead<float, double>(); }
 
+  void test_WriteReadCompressedFloat() { this->WriteReadRead<float, float>(true); }
+  void test_WriteReadCompressedDouble() { this->WriteReadRead<double, double>(true); }
+
+  void test_readAhead_returns_same_data_as_direct_reads() {
+    auto pSaver = createTestBoxController();
+    pSaver->setDataType(sizeof(float), "MDEvent");
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(this->xxfFileName, "w"));
+    const std::string fullPathFile = pSaver->getFileName();
+
+    const size_t nEvents = 50;
+    const auto nColumns = static_cast<size_t>(pSaver->getNDataColums());
+    std::vector<float> toWrite(nColumns * nEvents);
+    for (size_t i = 0; i < toWrite.size(); i++)
+      toWrite[i] = static_cast<float>(i);
+    TS_ASSERT_THROWS_NOTHING(pSaver->saveBlock(toWrite, 0));
+    pSaver->closeFile();
+
+    TS_ASSERT_EQUALS(0, pSaver->getReadAheadSize());
+    pSaver->setReadAheadSize(16);
+    TS_ASSERT_EQUALS(16, pSaver->getReadAheadSize());
+    TS_ASSERT_THROWS_NOTHING(pSaver->openFile(fullPathFile, "r"));
+
+    // sequential reads smaller than, straddling and larger than the buffer, then a read backwards
+    const std::vector<std::pair<uint64_t, size_t>> requests{{0, 3}, {3, 10}, {13, 5}, {18, 20}, {38, 12}, {5, 2}};
+    for (const auto &request : requests) {
+      std::vector<float> block;
+      TS_ASSERT_THROWS_NOTHING(pSaver->loadBlock(block, request.first, request.second));
+      TS_ASSERT_EQUALS(block.size(), request.second * nColumns);
+      for (size_t i = 0; i < block.size(); i++)
+        TS_ASSERT_EQUALS(block[i], toWrite[request.first * nColumns + i]);
+    }
+    std::vector<float> beyondEnd;
+    TS_ASSERT_THROWS(pSaver->loadBlock(beyondEnd, 45, 10), const Mantid::Kernel::Exception::FileError &);
+
+    pSaver->closeFile();
+    if (Poco::File(fullPathFile).exists())
+      Poco::File(fullPathFile).remove();
+  }
+
+  void test_compression_is_off_by_default() {
+    auto pSaver = createTestBoxController();
+    TS_ASSERT(!pSaver->isCompressed());
+    pSaver->setCompression(true);
+    TS_ASSERT(pSaver->isCompressed());
+  }
+
   void test_dataEventCount() {
     using Mantid::DataObjects::BoxControllerNeXusIO;
     using EDV = BoxControllerNeXusIO::EventDataVersion;
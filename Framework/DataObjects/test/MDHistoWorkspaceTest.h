@@ -776,6 +776,20 @@ public:
     checkWorkspace(a, 1.5, 1.5 * 1.5 * (.5 + 1. / 3.), 1.0);
   }
 
+  //--------------------------------------------------------------------------------------
+  void test_operations_on_workspace_large_enough_to_run_in_parallel() {
+    // 3 dimensions * 50 bins = 125000 bins
+    MDHistoWorkspace_sptr a = MDEventsTestHelper::makeFakeMDHistoWorkspace(3.0, 3, 50, 10.0, 3.0 /*errorSquared*/);
+    MDHistoWorkspace_sptr b = MDEventsTestHelper::makeFakeMDHistoWorkspace(2.0, 3, 50, 10.0, 2.0 /*errorSquared*/);
+    *a += *b;
+    checkWorkspace(a, 5.0, 5.0, 2.0);
+    TS_ASSERT_EQUALS(a->sumNContribEvents(), 2 * 125000);
+    *a /= *b;
+    checkWorkspace(a, 2.5, 5.0 / 4.0 + 2.0 * 2.5 * 2.5 / 4.0, 2.0);
+    a->greaterThan(2.0);
+    checkWorkspace(a, 1.0, 0.0, 2.0);
+  }
+
   //--------------------------------------------------------------------------------------
   void test_exp() {
     MDHistoWorkspace_sptr a = MDEventsTestHelper::makeFakeMDHistoWorkspace(2.0, 2, 5, 10.0, 3.0);
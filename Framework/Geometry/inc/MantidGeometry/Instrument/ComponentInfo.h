@@ -97,6 +97,9 @@ public:
   void setRotation(size_t componentIndex, const Kernel::Quat &newRotation);
   void setPosition(const std::pair<size_t, size_t> &index, const Kernel::V3D &newPosition);
   void setRotation(const std::pair<size_t, size_t> &index, const Kernel::Quat &newRotation);
+  void setPositionsAndRotations(const std::vector<size_t> &componentIndices,
+                                const std::vector<Kernel::V3D> &newPositions,
+                                const std::vector<Kernel::Quat> &newRotations);
   void scaleComponent(const size_t componentIndex, const Kernel::V3D &newScaling);
   void scaleComponent(const std::pair<size_t, size_t> &index, const Kernel::V3D &newScaling);
   size_t parent(const size_t componentIndex) const;
@@ -125,6 +128,8 @@ public:
   const Geometry::IObject &shape(const size_t componentIndex) const;
 
   double solidAngle(const size_t componentIndex, const Geometry::SolidAngleParams &params) const;
+  std::vector<double> solidAngles(const std::vector<size_t> &componentIndices,
+                                  const Geometry::SolidAngleParams &params) const;
   BoundingBox boundingBox(const size_t componentIndex, const BoundingBox *reference = nullptr,
                           const bool excludeMonitors = false) const;
   Beamline::ComponentType componentType(const size_t componentIndex) const;
@@ -289,7 +289,7 @@ private:
    *  of quickly accessing if a component have a parameter/logfile associated
    * with it or not
    *  - instead of using the comparatively slow poco call getElementsByTagName()
-   * (or getChildElement)
+   * (or getChildElement). Sorted by address with no duplicates.
    */
   std::vector<Poco::XML::Element *> m_hasParameterElement;
   /// has m_hasParameterElement been set - used when public method
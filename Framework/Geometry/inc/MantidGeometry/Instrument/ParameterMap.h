@@ -194,6 +194,11 @@ public:
   /// Looks recursively upwards in the component tree for the first instance of
   /// a parameter with a specified type.
   std::shared_ptr<Parameter> getRecursiveByType(const IComponent *comp, const std::string &type) const;
+  /// Find a named parameter for every component at once, looking up the
+  /// component tree for each. The result is indexed by component index.
+  std::vector<std::shared_ptr<Parameter>> getRecursiveForAllComponents(const ComponentInfo &componentInfo,
+                                                                      const std::string &name,
+                                                                      const std::string &type = "") const;
 
   /** Get the values of a given parameter of all the components that have the
    * name: compName
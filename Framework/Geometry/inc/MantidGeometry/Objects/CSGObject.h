@@ -12,6 +12,7 @@
 #include "MantidGeometry/DllConfig.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
 #include "MantidGeometry/Objects/IObject.h"
+#include "MantidGeometry/Objects/SolidAngleTriangles.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/Rendering/ShapeInfo.h"
 
@@ -135,6 +136,11 @@ public:
   double triangulatedSolidAngle(const SolidAngleParams &params, const Kernel::V3D &scaleFactor) const;
   // solid angle via ray tracing
   double rayTraceSolidAngle(const Kernel::V3D &observer) const;
+  // The triangles the solid angle is summed over, to reuse for many observers
+  std::optional<SolidAngleTriangles> solidAngleTriangles(const SolidAngleParams &params) const;
+  // The triangles the solid angle of the scaled object is summed over
+  std::optional<SolidAngleTriangles> solidAngleTriangles(const SolidAngleParams &params,
+                                                         const Kernel::V3D &scaleFactor) const;
 
   /// Calculates the volume of this object.
   double volume() const override;
@@ -187,6 +193,10 @@ private:
 
   /// Calculate bounding box using Rule system
   void calcBoundingBoxByRule();
+  /// Derive the extent of the object from the Rule system
+  bool boundingBoxFromRules(double &xmax, double &ymax, double &zmax, double &xmin, double &ymin, double &zmin) const;
+  /// Calculate the box used to skip the tracks missing the object
+  void calcInterceptBoundingBox();
 
   /// Calculate bounding box using object's vertices
   void calcBoundingBoxByVertices();
@@ -204,6 +214,8 @@ private:
   std::unique_ptr<Rule> m_topRule;
   /// Object's bounding box
   BoundingBox m_boundingBox;
+  /// Box enclosing the surfaces, used to skip tracks missing the object; null if unknown
+  BoundingBox m_interceptBox;
   // -- DEPRECATED --
   mutable double AABBxMax,  ///< xmax of Axis aligned bounding box cache
       AABByMax,             ///< ymax of Axis aligned bounding box cache
@@ -231,6 +243,9 @@ private:
   /// for solid angle from triangulation
   const std::vector<uint32_t> &getTriangleFaces() const;
   const std::vector<double> &getTriangleVertices() const;
+  std::optional<SolidAngleTriangles> trianglesForSolidAngle(const SolidAngleParams &params) const;
+  std::optional<SolidAngleTriangles> scaledTriangulation(const Kernel::V3D &scaleFactor) const;
+  double solidAngleWithoutTriangles(const Kernel::V3D &observer) const;
   /// original shape xml used to generate this object.
   std::string m_shapeXML;
   /// Optional string identifier
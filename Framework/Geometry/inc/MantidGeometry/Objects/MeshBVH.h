@@ -0,0 +1,59 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+
+/** MeshBVH : A bounding volume hierarchy over the triangles of a mesh.
+
+  The triangles are grouped into a binary tree of axis-aligned boxes, so the
+  triangles a ray may cross are found by descending only into the boxes the ray
+  passes through instead of testing every triangle of the mesh.
+*/
+class MANTID_GEOMETRY_DLL MeshBVH {
+public:
+  MeshBVH(const std::vector<uint32_t> &triangles, const std::vector<Kernel::V3D> &vertices);
+
+  /// Find the triangles whose bounding boxes are crossed by a ray
+  void findCandidateTriangles(const Kernel::V3D &start, const Kernel::V3D &direction,
+                              std::vector<size_t> &candidates) const;
+
+  /// Number of boxes in the tree
+  size_t numberOfNodes() const { return m_nodes.size(); }
+
+  /// Largest number of triangles in a leaf box
+  static constexpr uint32_t MAX_TRIANGLES_PER_LEAF = 4;
+
+private:
+  struct Node {
+    std::array<double, 3> minPoint;
+    std::array<double, 3> maxPoint;
+    /// Internal node: index of the first child, the second follows it.
+    /// Leaf: position of its first triangle in m_order.
+    uint32_t first;
+    /// Number of triangles of a leaf, zero for an internal node
+    uint32_t count;
+  };
+
+  bool rayCrossesBox(const Node &node, const Kernel::V3D &start, const Kernel::V3D &direction) const;
+
+  /// Boxes of the tree, the root first
+  std::vector<Node> m_nodes;
+  /// Triangle indices ordered so that those of each leaf are contiguous
+  std::vector<uint32_t> m_order;
+};
+
+} // namespace Geometry
+} // namespace Mantid
@@ -12,12 +12,14 @@
 #include "BoundingBox.h"
 #include "MantidGeometry/DllConfig.h"
 #include "MantidGeometry/Objects/IObject.h"
+#include "MantidGeometry/Objects/MeshBVH.h"
 #include "MantidGeometry/Objects/Track.h"
 #include "MantidGeometry/Rendering/ShapeInfo.h"
 #include "MantidKernel/Material.h"
 #include "MantidKernel/Matrix.h"
 #include <map>
 #include <memory>
+#include <mutex>
 
 namespace Mantid {
 //----------------------------------------------------------------------
@@ -145,6 +147,11 @@ private:
                         std::vector<Kernel::V3D> &intersectionPoints,
                         std::vector<Mantid::Geometry::TrackDirection> &entryExitFlags) const;
 
+  /// Get the bounding volume hierarchy of the triangles, building it if needed
+  const MeshBVH &getBVH() const;
+  /// Discard the cached bounding box and hierarchy after the vertices have moved
+  void clearGeometryCaches();
+
   /// Get triangle
   bool getTriangle(const size_t index, Kernel::V3D &v1, Kernel::V3D &v2, Kernel::V3D &v3) const;
   /// Search object for valid point
@@ -153,6 +160,11 @@ private:
   /// Cache for object's bounding box
   mutable BoundingBox m_boundingBox;
 
+  /// Bounding volume hierarchy for ray tracing, built on first use
+  mutable std::unique_ptr<MeshBVH> m_bvh;
+  /// Guards the construction of m_bvh by concurrent callers
+  mutable std::unique_ptr<std::once_flag> m_bvhBuilt = std::make_unique<std::once_flag>();
+
   /// Tolerence distance
   const double M_TOLERANCE = 0.000001;
 
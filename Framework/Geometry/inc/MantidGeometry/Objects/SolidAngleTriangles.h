@@ -0,0 +1,59 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/DllConfig.h"
+#include "MantidKernel/V3D.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace Geometry {
+
+/** SolidAngleTriangles : The triangles the solid angle of a shape is summed
+  over.
+
+  The corners of the triangles are held as separate arrays of coordinates so
+  that the sum over the triangles runs as a tight loop the compiler can
+  vectorise. Building the triangles once per shape lets the solid angles of
+  the many detectors sharing a shape be calculated without triangulating the
+  shape again for each of them.
+*/
+class MANTID_GEOMETRY_DLL SolidAngleTriangles {
+public:
+  /// How the solid angles of the triangles are combined
+  enum class Sum {
+    /// Only the triangles facing the observer count
+    FacingObserver,
+    /// The average of the triangles facing towards and away from the observer,
+    /// for triangulations whose winding order is not consistent
+    Average
+  };
+
+  explicit SolidAngleTriangles(const Sum sum) : m_sum(sum) {}
+
+  static SolidAngleTriangles cuboid(const std::vector<Kernel::V3D> &vectors);
+  static SolidAngleTriangles cylinder(const Kernel::V3D &centre, const Kernel::V3D &axis, const double radius,
+                                      const double height, const int numberOfSlices);
+  static SolidAngleTriangles cone(const Kernel::V3D &centre, const Kernel::V3D &axis, const double radius,
+                                  const double height);
+
+  void addTriangle(const Kernel::V3D &a, const Kernel::V3D &b, const Kernel::V3D &c);
+  /// Number of triangles
+  size_t size() const { return m_ax.size(); }
+  double solidAngle(const Kernel::V3D &observer) const;
+
+private:
+  Sum m_sum;
+  /// Coordinates of the first, second and third corners of the triangles
+  std::vector<double> m_ax, m_ay, m_az;
+  std::vector<double> m_bx, m_by, m_bz;
+  std::vector<double> m_cx, m_cy, m_cz;
+};
+
+} // namespace Geometry
+} // namespace Mantid
@@ -9,13 +9,19 @@
 #include "MantidBeamline/ComponentType.h"
 #include "MantidGeometry/IComponent.h"
 #include "MantidGeometry/Objects/BoundingBox.h"
+#include "MantidGeometry/Objects/CSGObject.h"
 #include "MantidGeometry/Objects/IObject.h"
 #include "MantidKernel/EigenConversionHelpers.h"
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
 
 #include <Eigen/Geometry>
+#include <algorithm>
+#include <array>
 #include <exception>
 #include <iterator>
+#include <map>
+#include <optional>
 #include <string>
 
 namespace Mantid::Geometry {
@@ -242,6 +248,27 @@ void ComponentInfo::setRotation(const size_t componentIndex, const Kernel::Quat
   m_componentInfo->setRotation(componentIndex, Kernel::toQuaterniond(newRotation));
 }
 
+/**
+ * Sets the absolute positions and rotations of many components at once. See
+ * Beamline::ComponentInfo::setPositionsAndRotations.
+ * @param componentIndices : Component indices to update, without duplicates
+ * @param newPositions : Absolute positions to set, one per component index
+ * @param newRotations : Absolute rotations to set, one per component index
+ */
+void ComponentInfo::setPositionsAndRotations(const std::vector<size_t> &componentIndices,
+                                             const std::vector<Kernel::V3D> &newPositions,
+                                             const std::vector<Kernel::Quat> &newRotations) {
+  std::vector<Eigen::Vector3d> positions;
+  positions.reserve(newPositions.size());
+  std::transform(newPositions.cbegin(), newPositions.cend(), std::back_inserter(positions),
+                 [](const Kernel::V3D &pos) { return Kernel::toVector3d(pos); });
+  std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>> rotations;
+  rotations.reserve(newRotations.size());
+  std::transform(newRotations.cbegin(), newRotations.cend(), std::back_inserter(rotations),
+                 [](const Kernel::Quat &rot) { return Kernel::toQuaterniond(rot); });
+  m_componentInfo->setPositionsAndRotations(componentIndices, positions, rotations);
+}
+
 const IObject &ComponentInfo::shape(const size_t componentIndex) const { return *(*m_shapes)[componentIndex]; }
 
 Kernel::V3D ComponentInfo::scaleFactor(const size_t componentIndex) const {
@@ -272,6 +299,65 @@ double ComponentInfo::solidAngle(const size_t componentIndex, const Geometry::So
   }
 }
 
+/**
+ * Calculate the solid angles of many components seen from the same observer.
+ * The triangles the solid angle of a shape is summed over are built once for
+ * all the components sharing the shape and scale factor, e.g. the pixels of a
+ * bank, rather than once per component. The components are evaluated in
+ * parallel.
+ * @param componentIndices :: indices of the components
+ * @param params :: the observer and the number of cylinder slices
+ * @return the solid angle of each component, as given by solidAngle
+ */
+std::vector<double> ComponentInfo::solidAngles(const std::vector<size_t> &componentIndices,
+                                               const Geometry::SolidAngleParams &params) const {
+  struct ShapeTriangles {
+    std::optional<SolidAngleTriangles> triangles;
+    BoundingBox boundingBox;
+  };
+  // Built serially: a shape triangulates itself when first asked to
+  std::map<std::pair<const IObject *, std::array<double, 3>>, ShapeTriangles> uniqueShapes;
+  std::vector<const ShapeTriangles *> componentShapes(componentIndices.size());
+  for (size_t i = 0; i < componentIndices.size(); ++i) {
+    const auto componentIndex = componentIndices[i];
+    if (!hasValidShape(componentIndex))
+      throw Kernel::Exception::NullPointerException("ComponentInfo::solidAngles", "shape");
+    const auto &shapeAtIndex = shape(componentIndex);
+    const Kernel::V3D scaleFactorAtIndex = this->scaleFactor(componentIndex);
+    const auto key = std::make_pair(
+        &shapeAtIndex, std::array<double, 3>{{scaleFactorAtIndex.X(), scaleFactorAtIndex.Y(), scaleFactorAtIndex.Z()}});
+    auto shapeEntry = uniqueShapes.find(key);
+    if (shapeEntry == uniqueShapes.end()) {
+      ShapeTriangles shapeTriangles;
+      // Other shapes calculate their solid angles themselves
+      if (const auto *csgShape = dynamic_cast<const CSGObject *>(&shapeAtIndex)) {
+        if ((scaleFactorAtIndex - Kernel::V3D(1.0, 1.0, 1.0)).norm() < 1e-12)
+          shapeTriangles.triangles = csgShape->solidAngleTriangles(params);
+        else
+          shapeTriangles.triangles = csgShape->solidAngleTriangles(params, scaleFactorAtIndex);
+      }
+      shapeTriangles.boundingBox = shapeAtIndex.getBoundingBox();
+      shapeEntry = uniqueShapes.emplace(key, std::move(shapeTriangles)).first;
+    }
+    componentShapes[i] = &shapeEntry->second;
+  }
+
+  std::vector<double> result(componentIndices.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(componentIndices.size()); ++i) {
+    const auto componentIndex = componentIndices[i];
+    const auto &shapeTriangles = *componentShapes[i];
+    const Kernel::V3D relativeObserver = toShapeFrame(params.observer(), *m_componentInfo, componentIndex);
+    const auto &boundingBox = shapeTriangles.boundingBox;
+    // Observers on the surface of or inside a shape are left to the shape
+    if (shapeTriangles.triangles && !(boundingBox.isNonNull() && boundingBox.isPointInside(relativeObserver)))
+      result[i] = shapeTriangles.triangles->solidAngle(relativeObserver);
+    else
+      result[i] = solidAngle(componentIndex, params);
+  }
+  return result;
+}
+
 /**
  * Grow the bounding box on the basis that the component described by index is a
  * regular grid in a trapezoid, thus the bounding box can be fully described by
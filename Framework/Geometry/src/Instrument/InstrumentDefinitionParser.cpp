@@ -4,6 +4,7 @@
 //   NScD Oak Ridge National Laboratory, European Spallation Source,
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
@@ -443,6 +444,12 @@ void InstrumentDefinitionParser::createVectorOfElementsContainingAParameterEleme
     }
     pNode = it.nextNode();
   }
+  // An element is listed once for each of its parameters. Sort the list so
+  // setLogfile can binary search it: it is called at least once for every
+  // component, which for a large instrument means millions of searches.
+  std::sort(m_hasParameterElement.begin(), m_hasParameterElement.end());
+  m_hasParameterElement.erase(std::unique(m_hasParameterElement.begin(), m_hasParameterElement.end()),
+                              m_hasParameterElement.end());
 
   m_hasParameterElement_beenSet = true;
 }
@@ -2068,15 +2075,15 @@ void InstrumentDefinitionParser::setFacing(Geometry::IComponent *comp, const Poc
  */
 void InstrumentDefinitionParser::setLogfile(const Geometry::IComponent *comp, const Poco::XML::Element *pElem,
                                             InstrumentParameterCache &logfileCache, const std::string &requestedDate) {
-  const std::string filename = m_xmlFile->getFileFullPathStr();
-
   // The purpose below is to have a quicker way to judge if pElem contains a
   // parameter, see
   // defintion of m_hasParameterElement for more info
   if (m_hasParameterElement_beenSet)
-    if (m_hasParameterElement.end() == std::find(m_hasParameterElement.begin(), m_hasParameterElement.end(), pElem))
+    if (!std::binary_search(m_hasParameterElement.cbegin(), m_hasParameterElement.cend(), pElem))
       return;
 
+  const std::string filename = m_xmlFile->getFileFullPathStr();
+
   Poco::AutoPtr<NodeList> pNL_comp = pElem->childNodes(); // here get all child nodes
   unsigned long pNL_comp_length = pNL_comp->length();
 
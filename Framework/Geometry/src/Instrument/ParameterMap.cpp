@@ -880,6 +880,38 @@ Parameter_sptr ParameterMap::getRecursive(const IComponent *comp, const char *na
   return result;
 }
 
+/**
+ * Find a parameter by name for every component of an instrument, going up the
+ * component tree to higher parents as getRecursive does. Each component and
+ * parent is looked up once rather than once per descendant, so this is much
+ * cheaper than calling getRecursive for each detector. The parameters
+ * returned are a snapshot: they are not affected by later changes to the map.
+ * @param componentInfo :: The ComponentInfo of the instrument
+ * @param name :: Parameter name
+ * @param type :: An optional type string
+ * @returns the first matching parameter of each component, or a NULL shared
+ * pointer if there is none, indexed by component index. Detector indices are
+ * the same as component indices.
+ */
+std::vector<Parameter_sptr> ParameterMap::getRecursiveForAllComponents(const ComponentInfo &componentInfo,
+                                                                       const std::string &name,
+                                                                       const std::string &type) const {
+  checkIsNotMaskingParameter(name);
+  std::vector<Parameter_sptr> result(componentInfo.size());
+  if (m_map.empty())
+    return result;
+  // Parents always have a higher index than their children so visiting the
+  // components from the root down resolves each parent before its children
+  for (size_t i = componentInfo.size(); i-- > 0;) {
+    auto itr = positionOf(componentInfo.componentID(i), name.c_str(), type.c_str());
+    if (itr != m_map.end())
+      result[i] = std::atomic_load(&itr->second);
+    else if (componentInfo.hasParent(i))
+      result[i] = result[componentInfo.parent(i)];
+  }
+  return result;
+}
+
 /**
  * Return the value of a parameter as a string
  * @param comp :: Component to which parameter is related
@@ -16,6 +16,8 @@
 #include "MantidGeometry/Surfaces/Cone.h"
 #include "MantidGeometry/Surfaces/Cylinder.h"
 #include "MantidGeometry/Surfaces/LineIntersectVisit.h"
+#include "MantidGeometry/Surfaces/Plane.h"
+#include "MantidGeometry/Surfaces/Sphere.h"
 #include "MantidGeometry/Surfaces/Surface.h"
 #include "MantidKernel/Exception.h"
 #include "MantidKernel/Logger.h"
@@ -26,6 +28,7 @@
 #include "MantidKernel/Quat.h"
 #include "MantidKernel/RegexStrings.h"
 #include "MantidKernel/Strings.h"
+#include "MantidKernel/System.h"
 #include "MantidKernel/Tolerance.h"
 
 #include <boost/accumulators/accumulators.hpp>
@@ -34,6 +37,7 @@
 #include <boost/accumulators/statistics/stats.hpp>
 #include <memory>
 
+#include <algorithm>
 #include <array>
 #include <deque>
 #include <random>
@@ -49,313 +53,8 @@ namespace {
 /// A shift to add/subtract to a point to test if it is an entry/exit point
 constexpr double VALID_INTERCEPT_POINT_SHIFT{2.5e-05};
 
-/**
- * Find the solid angle of a triangle defined by vectors a,b,c from point
- *"observer"
- *
- * formula (Oosterom) O=2atan([a,b,c]/(abc+(a.b)c+(a.c)b+(b.c)a))
- *
- * @param a :: first point of triangle
- * @param b :: second point of triangle
- * @param c :: third point of triangle
- * @param observer :: point from which solid angle is required
- * @return :: solid angle of triangle in Steradians.
- */
-double triangleSolidAngle(const V3D &a, const V3D &b, const V3D &c, const V3D &observer) {
-  const V3D ao = a - observer;
-  const V3D bo = b - observer;
-  const V3D co = c - observer;
-  const double modao = ao.norm();
-  const double modbo = bo.norm();
-  const double modco = co.norm();
-  const double aobo = ao.scalar_prod(bo);
-  const double aoco = ao.scalar_prod(co);
-  const double boco = bo.scalar_prod(co);
-  const double scalTripProd = ao.scalar_prod(bo.cross_prod(co));
-  const double denom = modao * modbo * modco + modco * aobo + modbo * aoco + modao * boco;
-  if (denom != 0.0)
-    return 2.0 * atan2(scalTripProd, denom);
-  else
-    return 0.0; // not certain this is correct
-}
-
-/**
- * Calculate the solid angle for a cone using triangulation.
- * @param observer :: The observer's point
- * @param centre :: The centre vector
- * @param axis :: The axis vector
- * @param radius :: The radius
- * @param height :: The height
- * @returns The solid angle value
- */
-double coneSolidAngle(const V3D &observer, const Mantid::Kernel::V3D &centre, const Mantid::Kernel::V3D &axis,
-                      const double radius, const double height) {
-  // The cone is broken down into three pieces and then in turn broken down into
-  // triangles. Any triangle that has a normal facing away from the observer
-  // gives a negative solid angle and is excluded
-  // For simplicity the triangulation points are constructed such that the cone
-  // axis points up the +Z axis and then rotated into their final position
-
-  const V3D axis_direction = normalize(axis);
-  // Required rotation
-  constexpr V3D initial_axis(0., 0., 1.0);
-  const Quat transform(initial_axis, axis_direction);
-
-  // Do the base cap which is a point at the centre and nslices points around it
-  constexpr double angle_step = 2 * M_PI / Mantid::Geometry::Cone::g_NSLICES;
-  // Store the (x,y) points as they are used quite frequently
-  std::array<double, Mantid::Geometry::Cone::g_NSLICES> cos_table;
-  std::array<double, Mantid::Geometry::Cone::g_NSLICES> sin_table;
-
-  double solid_angle(0.0);
-  for (int sl = 0; sl < Mantid::Geometry::Cone::g_NSLICES; ++sl) {
-    int vertex = sl;
-    cos_table[vertex] = std::cos(angle_step * vertex);
-    sin_table[vertex] = std::sin(angle_step * vertex);
-    V3D pt2 = V3D(radius * cos_table[vertex], radius * sin_table[vertex], 0.0);
-
-    if (sl < Mantid::Geometry::Cone::g_NSLICES - 1) {
-      vertex = sl + 1;
-      cos_table[vertex] = std::cos(angle_step * vertex);
-      sin_table[vertex] = std::sin(angle_step * vertex);
-    } else
-      vertex = 0;
-
-    V3D pt3 = V3D(radius * cos_table[vertex], radius * sin_table[vertex], 0.0);
-
-    transform.rotate(pt2);
-    transform.rotate(pt3);
-    pt2 += centre;
-    pt3 += centre;
-
-    double sa = triangleSolidAngle(centre, pt2, pt3, observer);
-    if (sa > 0.0) {
-      solid_angle += sa;
-    }
-  }
-
-  // Now the main section
-  const double z_step = height / Cone::g_NSTACKS;
-  const double r_step = height / Cone::g_NSTACKS;
-  double z0(0.0), z1(z_step);
-  double r0(radius), r1(r0 - r_step);
-
-  for (int st = 1; st < Cone::g_NSTACKS; ++st) {
-    for (int sl = 0; sl < Cone::g_NSLICES; ++sl) {
-      int vertex = sl;
-      V3D pt1 = V3D(r0 * cos_table[vertex], r0 * sin_table[vertex], z0);
-      if (sl < Mantid::Geometry::Cone::g_NSLICES - 1)
-        vertex = sl + 1;
-      else
-        vertex = 0;
-      V3D pt3 = V3D(r0 * cos_table[vertex], r0 * sin_table[vertex], z0);
-
-      vertex = sl;
-      V3D pt2 = V3D(r1 * cos_table[vertex], r1 * sin_table[vertex], z1);
-      if (sl < Mantid::Geometry::Cone::g_NSLICES - 1)
-        vertex = sl + 1;
-      else
-        vertex = 0;
-      V3D pt4 = V3D(r1 * cos_table[vertex], r1 * sin_table[vertex], z1);
-      // Rotations
-      transform.rotate(pt1);
-      transform.rotate(pt3);
-      transform.rotate(pt2);
-      transform.rotate(pt4);
-
-      pt1 += centre;
-      pt2 += centre;
-      pt3 += centre;
-      pt4 += centre;
-      double sa = triangleSolidAngle(pt1, pt4, pt3, observer);
-      if (sa > 0.0) {
-        solid_angle += sa;
-      }
-      sa = triangleSolidAngle(pt1, pt2, pt4, observer);
-      if (sa > 0.0) {
-        solid_angle += sa;
-      }
-    }
-
-    z0 = z1;
-    r0 = r1;
-    z1 += z_step;
-    r1 -= r_step;
-  }
-
-  // Top section
-  V3D top_centre = V3D(0.0, 0.0, height) + centre;
-  transform.rotate(top_centre);
-  top_centre += centre;
-
-  for (int sl = 0; sl < Cone::g_NSLICES; ++sl) {
-    int vertex = sl;
-    V3D pt2 = V3D(r0 * cos_table[vertex], r0 * sin_table[vertex], height);
-
-    if (sl < Mantid::Geometry::Cone::g_NSLICES - 1)
-      vertex = sl + 1;
-    else
-      vertex = 0;
-    V3D pt3 = V3D(r0 * cos_table[vertex], r0 * sin_table[vertex], height);
-
-    // Rotate them to the correct axis orientation
-    transform.rotate(pt2);
-    transform.rotate(pt3);
-
-    pt2 += centre;
-    pt3 += centre;
-
-    double sa = triangleSolidAngle(top_centre, pt3, pt2, observer);
-    if (sa > 0.0) {
-      solid_angle += sa;
-    }
-  }
-  return solid_angle;
-}
-
-/**
- * Get the solid angle of a cuboid defined by 4 points. Simple use of triangle
- * based solid angle
- * calculation. Should work for parallel-piped as well.
- * @param observer :: point from which solid angle required
- * @param vectors :: vector of V3D - the values are the 4 points used to defined
- * the cuboid
- * @return :: solid angle of cuboid - good accuracy
- */
-double cuboidSolidAngle(const V3D &observer, const std::vector<V3D> &vectors) {
-  // Build bounding points, then set up map of 12 bounding
-  // triangles defining the 6 surfaces of the bounding box. Using a consistent
-  // ordering of points the "away facing" triangles give -ve contributions to
-  // the solid angle and hence are ignored.
-  std::vector<V3D> pts;
-  pts.reserve(8);
-  const V3D dx = vectors[1] - vectors[0];
-  const V3D dz = vectors[3] - vectors[0];
-  pts.emplace_back(vectors[2]);
-  pts.emplace_back(vectors[2] + dx);
-  pts.emplace_back(vectors[1]);
-  pts.emplace_back(vectors[0]);
-  pts.emplace_back(vectors[2] + dz);
-  pts.emplace_back(vectors[2] + dz + dx);
-  pts.emplace_back(vectors[1] + dz);
-  pts.emplace_back(vectors[0] + dz);
-
-  constexpr unsigned int ntriangles(12);
-  std::vector<std::vector<int>> triMap(ntriangles, std::vector<int>(3, 0));
-  triMap[0][0] = 1;
-  triMap[0][1] = 4;
-  triMap[0][2] = 3;
-  triMap[1][0] = 3;
-  triMap[1][1] = 2;
-  triMap[1][2] = 1;
-  triMap[2][0] = 5;
-  triMap[2][1] = 6;
-  triMap[2][2] = 7;
-  triMap[3][0] = 7;
-  triMap[3][1] = 8;
-  triMap[3][2] = 5;
-  triMap[4][0] = 1;
-  triMap[4][1] = 2;
-  triMap[4][2] = 6;
-  triMap[5][0] = 6;
-  triMap[5][1] = 5;
-  triMap[5][2] = 1;
-  triMap[6][0] = 2;
-  triMap[6][1] = 3;
-  triMap[6][2] = 7;
-  triMap[7][0] = 7;
-  triMap[7][1] = 6;
-  triMap[7][2] = 2;
-  triMap[8][0] = 3;
-  triMap[8][1] = 4;
-  triMap[8][2] = 8;
-  triMap[9][0] = 8;
-  triMap[9][1] = 7;
-  triMap[9][2] = 3;
-  triMap[10][0] = 1;
-  triMap[10][1] = 5;
-  triMap[10][2] = 8;
-  triMap[11][0] = 8;
-  triMap[11][1] = 4;
-  triMap[11][2] = 1;
-  double sangle = 0.0;
-  for (unsigned int i = 0; i < ntriangles; i++) {
-    const double sa = triangleSolidAngle(pts[triMap[i][0] - 1], pts[triMap[i][1] - 1], pts[triMap[i][2] - 1], observer);
-    if (sa > 0)
-      sangle += sa;
-  }
-  return sangle;
-}
-
-/**
- * Calculate the solid angle for a cylinder using triangulation EXCLUDING the
- * end caps.
- * @param observer :: The observer's point
- * @param centre :: The centre vector
- * @param axis :: The axis vector
- * @param radius :: The radius
- * @param height :: The height
- * @returns The solid angle value
- */
-double cylinderSolidAngle(const V3D &observer, const V3D &centre, const V3D &axis, const double radius,
-                          const double height, const int numberOfSlices) {
-  // The cylinder is triangulated along its axis EXCLUDING the end caps so that
-  // stacked cylinders give the correct value of solid angle (i.e shadowing is
-  // loosely taken into account by this method) Any triangle that has a normal
-  // facing away from the observer gives a negative solid angle and is excluded
-  // For simplicity the triangulation points are constructed such that the cone
-  // axis points up the +Z axis and then rotated into their final position
-
-  // Required rotation
-  constexpr V3D initial_axis(0., 0., 1.0);
-  const Quat transform(initial_axis, axis);
-
-  // Do the base cap which is a point at the centre and nslices points around it
-  const double angle_step = 2 * M_PI / static_cast<double>(numberOfSlices);
-
-  const double z_step = height / Cylinder::g_NSTACKS;
-  double z0(0.0), z1(z_step);
-  double solid_angle(0.0);
-  for (int st = 1; st <= Cylinder::g_NSTACKS; ++st) {
-    if (st == Cylinder::g_NSTACKS)
-      z1 = height;
-
-    for (int sl = 0; sl < numberOfSlices; ++sl) {
-      double x = radius * std::cos(angle_step * sl);
-      double y = radius * std::sin(angle_step * sl);
-      V3D pt1 = V3D(x, y, z0);
-      V3D pt2 = V3D(x, y, z1);
-      int vertex = (sl + 1) % numberOfSlices;
-      x = radius * std::cos(angle_step * vertex);
-      y = radius * std::sin(angle_step * vertex);
-      V3D pt3 = V3D(x, y, z0);
-      V3D pt4 = V3D(x, y, z1);
-      // Rotations
-      transform.rotate(pt1);
-      transform.rotate(pt3);
-      transform.rotate(pt2);
-      transform.rotate(pt4);
-
-      pt1 += centre;
-      pt2 += centre;
-      pt3 += centre;
-      pt4 += centre;
-
-      double sa = triangleSolidAngle(pt1, pt4, pt3, observer);
-      if (sa > 0.0) {
-        solid_angle += sa;
-      }
-      sa = triangleSolidAngle(pt1, pt2, pt4, observer);
-      if (sa > 0.0) {
-        solid_angle += sa;
-      }
-    }
-    z0 = z1;
-    z1 += z_step;
-  }
-
-  return solid_angle;
-}
+/// Objects with more triangles than this have their solid angle ray traced
+constexpr size_t MAX_TRIANGLES_FOR_SOLID_ANGLE{30000};
 
 /**
  * Get the solid angle of a sphere defined by centre and radius using an
@@ -845,6 +544,7 @@ int CSGObject::createSurfaceList(const int outFlag) {
       logger.debug() << (*vc)->getName() << '\n';
     }
   }
+  calcInterceptBoundingBox();
   return 1;
 }
 
@@ -1076,6 +776,13 @@ int CSGObject::interceptSurface(Geometry::Track &track) const {
   // Number of intersections original track
   int originalCount = track.count();
 
+  // A track missing the box around the surfaces cannot cross the shape. This
+  // saves testing every surface and walking the rules for the many tracks
+  // of a Monte Carlo simulation which miss a component.
+  if (m_interceptBox.isNonNull() && !m_interceptBox.doesLineIntersect(track)) {
+    return 0;
+  }
+
   // Loop over all the surfaces to get the intercepts, i.e. populating
   // points into LI
   LineIntersectVisit LI(track.startPoint(), track.direction());
@@ -1213,7 +920,7 @@ TrackDirection CSGObject::calcValidTypeBy3Points(const Kernel::V3D &prePt, const
  * shape.
  */
 double CSGObject::solidAngle(const SolidAngleParams &params) const {
-  if (this->numberOfTriangles() > 30000)
+  if (this->numberOfTriangles() > MAX_TRIANGLES_FOR_SOLID_ANGLE)
     return rayTraceSolidAngle(params.observer());
   return triangulatedSolidAngle(params);
 }
@@ -1346,6 +1053,34 @@ double CSGObject::rayTraceSolidAngle(const Kernel::V3D &observer) const {
   return sum;
 }
 
+/**
+ * The triangles solidAngle sums over, so that the solid angles of many
+ * components sharing the object can be calculated without building the
+ * triangles for each of them. The 2PI or 4PI of an observer on the surface or
+ * inside the object are not included.
+ * @param params :: number of cylinder slices, the observer is not used
+ * @return the triangles, or nothing if the solid angle is ray traced or
+ * calculated analytically
+ */
+std::optional<SolidAngleTriangles> CSGObject::solidAngleTriangles(const SolidAngleParams &params) const {
+  if (this->numberOfTriangles() > MAX_TRIANGLES_FOR_SOLID_ANGLE)
+    return std::nullopt;
+  return trianglesForSolidAngle(params);
+}
+
+/**
+ * The triangles solidAngle sums over for an object scaled by scaleFactor
+ * @param params :: number of cylinder slices, the observer is not used
+ * @param scaleFactor :: V3D giving scaling of the object
+ * @return the triangles, or nothing if the solid angle is ray traced or
+ * calculated analytically
+ */
+std::optional<SolidAngleTriangles> CSGObject::solidAngleTriangles(const SolidAngleParams &params,
+                                                                  const Kernel::V3D &scaleFactor) const {
+  UNUSED_ARG(params);
+  return scaledTriangulation(scaleFactor);
+}
+
 /**
  * Find solid angle of object from point "observer" using the
  * OC triangulation of the object, if it exists
@@ -1370,66 +1105,11 @@ double CSGObject::triangulatedSolidAngle(const SolidAngleParams &params) const {
     }
   }
 
-  // If the object is a simple shape use the special methods
-  double height(0.0), radius(0.0), innerRadius(0.0);
-  detail::ShapeInfo::GeometryShape type;
-  std::vector<Mantid::Kernel::V3D> geometry_vectors;
-  // Maximum of 4 vectors depending on the type
-  geometry_vectors.reserve(4);
-  this->GetObjectGeom(type, geometry_vectors, innerRadius, radius, height);
-  auto nTri = this->numberOfTriangles();
-
-  // Cylinders are by far the most frequently used
-  switch (type) {
-  case detail::ShapeInfo::GeometryShape::CUBOID:
-    return cuboidSolidAngle(observer, geometry_vectors);
-    break;
-  case detail::ShapeInfo::GeometryShape::SPHERE:
-    return sphereSolidAngle(observer, geometry_vectors, radius);
-    break;
-  case detail::ShapeInfo::GeometryShape::CYLINDER:
-    return cylinderSolidAngle(observer, geometry_vectors[0], geometry_vectors[1], radius, height,
-                              params.cylinderSlices());
-    break;
-  case detail::ShapeInfo::GeometryShape::CONE:
-    return coneSolidAngle(observer, geometry_vectors[0], geometry_vectors[1], radius, height);
-    break;
-  default:
-    if (nTri == 0) // Fall back to raytracing if there are no triangles
-    {
-      return rayTraceSolidAngle(observer);
-    } else { // Compute a generic shape that has been triangulated
-      const auto &vertices = this->getTriangleVertices();
-      const auto &faces = this->getTriangleFaces();
-      double sangle(0.0), sneg(0.0);
-      for (size_t i = 0; i < nTri; i++) {
-        int p1 = faces[i * 3], p2 = faces[i * 3 + 1], p3 = faces[i * 3 + 2];
-        V3D vp1 = V3D(vertices[3 * p1], vertices[3 * p1 + 1], vertices[3 * p1 + 2]);
-        V3D vp2 = V3D(vertices[3 * p2], vertices[3 * p2 + 1], vertices[3 * p2 + 2]);
-        V3D vp3 = V3D(vertices[3 * p3], vertices[3 * p3 + 1], vertices[3 * p3 + 2]);
-        double sa = triangleSolidAngle(vp1, vp2, vp3, observer);
-        if (sa > 0.0) {
-          sangle += sa;
-        } else {
-          sneg += sa;
-        }
-      }
-      /* We assume that objects are opaque to neutrons and that objects define
-       * closed surfaces which are convex. For such objects negative solid angle
-       * equals positive solid angle. This is true providing that the winding
-       * order is defined properly such that the contribution from each triangle
-       * w.r.t the observer gets counted to either the negative or positive
-       * contribution correctly. If that is done correctly then it would only be
-       * necessary to consider the positive contribution to the solid angle.
-       *
-       * The following provides a fix to situations where the winding order is
-       * incorrectly defined. It does not matter if the contribution is positive
-       * or negative since we take the average.
-       */
-      return 0.5 * (sangle - sneg);
-    }
-  }
+  if (const auto triangles = trianglesForSolidAngle(params))
+    return triangles->solidAngle(observer);
+  return solidAngleWithoutTriangles(observer);
 }
+
 /**
  * Find solid angle of object from point "observer" using the
  * OC triangulation of the object, if it exists. This method expects a
@@ -1448,63 +1128,102 @@ double CSGObject::triangulatedSolidAngle(const SolidAngleParams &params, const V
   // Hence catch these two (unlikely) cases.
   const auto &observer = params.observer();
   const BoundingBox &boundingBox = this->getBoundingBox();
-  double sx = scaleFactor[0], sy = scaleFactor[1], sz = scaleFactor[2];
-  const V3D sObserver = observer;
-  if (boundingBox.isNonNull() && boundingBox.isPointInside(sObserver)) {
-    if (isValid(sObserver)) {
-      if (isOnSide(sObserver))
+  if (boundingBox.isNonNull() && boundingBox.isPointInside(observer)) {
+    if (isValid(observer)) {
+      if (isOnSide(observer))
         return (2.0 * M_PI);
       else
         return (4.0 * M_PI);
     }
   }
 
-  auto nTri = this->numberOfTriangles();
-  //
-  // If triangulation is not available fall back to ray tracing method, unless
-  // object is a standard shape, currently Cuboid or Sphere. Should add Cylinder
-  // and Cone cases as well.
-  //
+  if (const auto triangles = scaledTriangulation(scaleFactor))
+    return triangles->solidAngle(observer);
+  return solidAngleWithoutTriangles(observer);
+}
+
+/**
+ * The triangles triangulatedSolidAngle sums over: those of the special
+ * methods for the simple shapes, else those of the OC triangulation
+ * @param params :: number of cylinder slices
+ * @return the triangles, or nothing for a sphere or an object without a
+ * triangulation
+ */
+std::optional<SolidAngleTriangles> CSGObject::trianglesForSolidAngle(const SolidAngleParams &params) const {
+  double height(0.0), radius(0.0), innerRadius(0.0);
+  detail::ShapeInfo::GeometryShape type;
+  std::vector<Mantid::Kernel::V3D> geometry_vectors;
+  // Maximum of 4 vectors depending on the type
+  geometry_vectors.reserve(4);
+  this->GetObjectGeom(type, geometry_vectors, innerRadius, radius, height);
+
+  // Cylinders are by far the most frequently used
+  switch (type) {
+  case detail::ShapeInfo::GeometryShape::CUBOID:
+    return SolidAngleTriangles::cuboid(geometry_vectors);
+  case detail::ShapeInfo::GeometryShape::SPHERE:
+    return std::nullopt;
+  case detail::ShapeInfo::GeometryShape::CYLINDER:
+    return SolidAngleTriangles::cylinder(geometry_vectors[0], geometry_vectors[1], radius, height,
+                                         params.cylinderSlices());
+  case detail::ShapeInfo::GeometryShape::CONE:
+    return SolidAngleTriangles::cone(geometry_vectors[0], geometry_vectors[1], radius, height);
+  default:
+    return scaledTriangulation(V3D(1.0, 1.0, 1.0));
+  }
+}
+
+/**
+ * The triangles of the OC triangulation of the object scaled by scaleFactor.
+ * Without a triangulation a cuboid uses its special method.
+ * @param scaleFactor :: V3D each component giving the scaling of the object
+ * @return the triangles, or nothing if there are none
+ */
+std::optional<SolidAngleTriangles> CSGObject::scaledTriangulation(const V3D &scaleFactor) const {
+  const auto nTri = this->numberOfTriangles();
   if (nTri == 0) {
     double height = 0.0, radius(0.0), innerRadius;
     detail::ShapeInfo::GeometryShape type;
     std::vector<Kernel::V3D> vectors;
     this->GetObjectGeom(type, vectors, innerRadius, radius, height);
-    switch (type) {
-    case detail::ShapeInfo::GeometryShape::CUBOID:
-      std::transform(vectors.begin(), vectors.end(), vectors.begin(),
-                     [scaleFactor](const V3D &v) { return v * scaleFactor; });
-      return cuboidSolidAngle(observer, vectors);
-      break;
-    case detail::ShapeInfo::GeometryShape::SPHERE:
-      return sphereSolidAngle(observer, vectors, radius);
-      break;
-    default:
-      break;
-    }
-
-    //
-    // No special case, do the ray trace.
-    //
-    return rayTraceSolidAngle(observer);
+    if (type != detail::ShapeInfo::GeometryShape::CUBOID)
+      return std::nullopt;
+    std::transform(vectors.begin(), vectors.end(), vectors.begin(),
+                   [scaleFactor](const V3D &v) { return v * scaleFactor; });
+    return SolidAngleTriangles::cuboid(vectors);
   }
+
+  const double sx = scaleFactor[0], sy = scaleFactor[1], sz = scaleFactor[2];
   const auto &vertices = this->getTriangleVertices();
   const auto &faces = this->getTriangleFaces();
-  double sangle(0.0), sneg(0.0);
+  /* The winding order of the OC triangles is not consistent, so the
+   * contributions facing towards and away from the observer are averaged. This
+   * is correct for opaque objects defining closed, convex surfaces.
+   */
+  SolidAngleTriangles triangles(SolidAngleTriangles::Sum::Average);
   for (size_t i = 0; i < nTri; i++) {
-    int p1 = faces[i * 3], p2 = faces[i * 3 + 1], p3 = faces[i * 3 + 2];
-    // would be more efficient to pre-multiply the vertices (copy of) by these
-    // factors beforehand
-    V3D vp1 = V3D(sx * vertices[3 * p1], sy * vertices[3 * p1 + 1], sz * vertices[3 * p1 + 2]);
-    V3D vp2 = V3D(sx * vertices[3 * p2], sy * vertices[3 * p2 + 1], sz * vertices[3 * p2 + 2]);
-    V3D vp3 = V3D(sx * vertices[3 * p3], sy * vertices[3 * p3 + 1], sz * vertices[3 * p3 + 2]);
-    double sa = triangleSolidAngle(vp1, vp2, vp3, observer);
-    if (sa > 0.0)
-      sangle += sa;
-    else
-      sneg += sa;
+    const auto p1 = 3 * faces[i * 3], p2 = 3 * faces[i * 3 + 1], p3 = 3 * faces[i * 3 + 2];
+    triangles.addTriangle(V3D(sx * vertices[p1], sy * vertices[p1 + 1], sz * vertices[p1 + 2]),
+                          V3D(sx * vertices[p2], sy * vertices[p2 + 1], sz * vertices[p2 + 2]),
+                          V3D(sx * vertices[p3], sy * vertices[p3 + 1], sz * vertices[p3 + 2]));
   }
-  return (0.5 * (sangle - sneg));
+  return triangles;
+}
+
+/**
+ * Solid angle of an object without triangles: analytic for a sphere, else ray
+ * traced
+ * @param observer :: point from which the solid angle is required
+ * @return the solid angle
+ */
+double CSGObject::solidAngleWithoutTriangles(const V3D &observer) const {
+  double height(0.0), radius(0.0), innerRadius(0.0);
+  detail::ShapeInfo::GeometryShape type;
+  std::vector<Kernel::V3D> vectors;
+  this->GetObjectGeom(type, vectors, innerRadius, radius, height);
+  if (type == detail::ShapeInfo::GeometryShape::SPHERE)
+    return sphereSolidAngle(observer, vectors, radius);
+  return rayTraceSolidAngle(observer);
 }
 
 /**
@@ -1706,22 +1425,66 @@ void CSGObject::calcBoundingBoxByRule() {
   if (!m_topRule)
     return;
 
+  double minX, minY, minZ, maxX, maxY, maxZ;
+  if (boundingBoxFromRules(maxX, maxY, maxZ, minX, minY, minZ)) {
+    // Values make sense, cache and return bounding box
+    defineBoundingBox(maxX, maxY, maxZ, minX, minY, minZ);
+  }
+}
+
+/**
+ * Derive the extent of the object from the Rule system.
+ * @param xmax :: Maximum value for the bounding box in x direction
+ * @param ymax :: Maximum value for the bounding box in y direction
+ * @param zmax :: Maximum value for the bounding box in z direction
+ * @param xmin :: Minimum value for the bounding box in x direction
+ * @param ymin :: Minimum value for the bounding box in y direction
+ * @param zmin :: Minimum value for the bounding box in z direction
+ * @return true if the Rule system produced a reasonable box
+ */
+bool CSGObject::boundingBoxFromRules(double &xmax, double &ymax, double &zmax, double &xmin, double &ymin,
+                                     double &zmin) const {
   // Set up some unreasonable values that will be refined
   const double huge(1e10);
   const double big(1e4);
-  double minX(-huge), minY(-huge), minZ(-huge);
-  double maxX(huge), maxY(huge), maxZ(huge);
+  xmin = ymin = zmin = -huge;
+  xmax = ymax = zmax = huge;
 
   // Try to use the Rule system to derive the box
-  m_topRule->getBoundingBox(maxX, maxY, maxZ, minX, minY, minZ);
+  m_topRule->getBoundingBox(xmax, ymax, zmax, xmin, ymin, zmin);
 
   // Check whether values are reasonable now. Rule system will fail to produce
   // a reasonable box if the shape is not axis-aligned.
-  if (minX > -big && maxX < big && minY > -big && maxY < big && minZ > -big && maxZ < big && minX <= maxX &&
-      minY <= maxY && minZ <= maxZ) {
-    // Values make sense, cache and return bounding box
-    defineBoundingBox(maxX, maxY, maxZ, minX, minY, minZ);
-  }
+  return xmin > -big && xmax < big && ymin > -big && ymax < big && zmin > -big && zmax < big && xmin <= xmax &&
+         ymin <= ymax && zmin <= zmax;
+}
+
+/**
+ * Calculate the box used by interceptSurface to skip the tracks which miss
+ * the object. Unlike the bounding box, which may be approximate or defined by
+ * the user, this box must enclose the whole shape, so it is only set when all
+ * the surfaces are planes, spheres or cylinders, whose boxes from the Rule
+ * system are reliable. It is slightly enlarged so that tracks grazing the
+ * shape are still traced.
+ */
+void CSGObject::calcInterceptBoundingBox() {
+  m_interceptBox = BoundingBox();
+  if (!m_topRule || m_surList.empty())
+    return;
+  const bool reliableSurfaces = std::all_of(m_surList.cbegin(), m_surList.cend(), [](const Surface *surface) {
+    return dynamic_cast<const Plane *>(surface) || dynamic_cast<const Sphere *>(surface) ||
+           dynamic_cast<const Cylinder *>(surface);
+  });
+  if (!reliableSurfaces)
+    return;
+
+  double minX, minY, minZ, maxX, maxY, maxZ;
+  if (!boundingBoxFromRules(maxX, maxY, maxZ, minX, minY, minZ))
+    return;
+  const double size = std::max({maxX - minX, maxY - minY, maxZ - minZ});
+  const double padding = std::max(1e-6 * size, Kernel::Tolerance);
+  m_interceptBox = BoundingBox(maxX + padding, maxY + padding, maxZ + padding, minX - padding, minY - padding,
+                               minZ - padding);
 }
 
 /**
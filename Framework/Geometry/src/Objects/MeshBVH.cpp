@@ -0,0 +1,166 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/MeshBVH.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace Mantid::Geometry {
+
+namespace {
+/// Boxes are enlarged by this fraction of the size of the mesh so that rays
+/// grazing an edge, or starting on the surface, still find the triangle
+constexpr double RELATIVE_PADDING = 1e-6;
+} // namespace
+
+/**
+ * Build the hierarchy by splitting the triangles in two at the median of their
+ * centres along the longest side of the box of the centres, until a box holds
+ * no more than MAX_TRIANGLES_PER_LEAF triangles.
+ * @param triangles :: indices of the three vertices of each triangle
+ * @param vertices :: vertices of the mesh
+ */
+MeshBVH::MeshBVH(const std::vector<uint32_t> &triangles, const std::vector<Kernel::V3D> &vertices) {
+  const size_t nTriangles = triangles.size() / 3;
+  if (nTriangles == 0)
+    return;
+
+  // Bounds and centre of each triangle
+  std::vector<std::array<double, 3>> minPoints(nTriangles), maxPoints(nTriangles), centres(nTriangles);
+  std::array<double, 3> meshMin, meshMax;
+  meshMin.fill(std::numeric_limits<double>::max());
+  meshMax.fill(std::numeric_limits<double>::lowest());
+  for (size_t i = 0; i < nTriangles; ++i) {
+    const auto &v1 = vertices[triangles[3 * i]];
+    const auto &v2 = vertices[triangles[3 * i + 1]];
+    const auto &v3 = vertices[triangles[3 * i + 2]];
+    for (size_t a = 0; a < 3; ++a) {
+      minPoints[i][a] = std::min({v1[a], v2[a], v3[a]});
+      maxPoints[i][a] = std::max({v1[a], v2[a], v3[a]});
+      centres[i][a] = 0.5 * (minPoints[i][a] + maxPoints[i][a]);
+      meshMin[a] = std::min(meshMin[a], minPoints[i][a]);
+      meshMax[a] = std::max(meshMax[a], maxPoints[i][a]);
+    }
+  }
+  double meshSize(0);
+  for (size_t a = 0; a < 3; ++a)
+    meshSize = std::max(meshSize, meshMax[a] - meshMin[a]);
+  const double padding = std::max(RELATIVE_PADDING * meshSize, std::numeric_limits<double>::min());
+
+  m_order.resize(nTriangles);
+  std::iota(m_order.begin(), m_order.end(), 0);
+  m_nodes.reserve(2 * nTriangles / MAX_TRIANGLES_PER_LEAF + 1);
+  // While building, the node holds the range of m_order it covers
+  m_nodes.emplace_back(Node{{}, {}, 0, static_cast<uint32_t>(nTriangles)});
+  std::vector<size_t> toSplit{0};
+  while (!toSplit.empty()) {
+    const size_t index = toSplit.back();
+    toSplit.pop_back();
+    const uint32_t begin = m_nodes[index].first;
+    const uint32_t end = begin + m_nodes[index].count;
+
+    std::array<double, 3> boxMin, boxMax, centreMin, centreMax;
+    boxMin.fill(std::numeric_limits<double>::max());
+    boxMax.fill(std::numeric_limits<double>::lowest());
+    centreMin = boxMin;
+    centreMax = boxMax;
+    for (uint32_t i = begin; i < end; ++i) {
+      const uint32_t triangle = m_order[i];
+      for (size_t a = 0; a < 3; ++a) {
+        boxMin[a] = std::min(boxMin[a], minPoints[triangle][a]);
+        boxMax[a] = std::max(boxMax[a], maxPoints[triangle][a]);
+        centreMin[a] = std::min(centreMin[a], centres[triangle][a]);
+        centreMax[a] = std::max(centreMax[a], centres[triangle][a]);
+      }
+    }
+    for (size_t a = 0; a < 3; ++a) {
+      m_nodes[index].minPoint[a] = boxMin[a] - padding;
+      m_nodes[index].maxPoint[a] = boxMax[a] + padding;
+    }
+
+    size_t axis = 0;
+    for (size_t a = 1; a < 3; ++a) {
+      if (centreMax[a] - centreMin[a] > centreMax[axis] - centreMin[axis])
+        axis = a;
+    }
+    // Leaves: few triangles, or triangles which cannot be told apart by their centres
+    if (end - begin <= MAX_TRIANGLES_PER_LEAF || centreMax[axis] <= centreMin[axis])
+      continue;
+
+    const uint32_t middle = begin + (end - begin) / 2;
+    std::nth_element(
+        m_order.begin() + begin, m_order.begin() + middle, m_order.begin() + end,
+        [&centres, axis](const uint32_t a, const uint32_t b) { return centres[a][axis] < centres[b][axis]; });
+    const auto firstChild = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.emplace_back(Node{{}, {}, begin, middle - begin});
+    m_nodes.emplace_back(Node{{}, {}, middle, end - middle});
+    m_nodes[index].first = firstChild;
+    m_nodes[index].count = 0;
+    toSplit.emplace_back(firstChild);
+    toSplit.emplace_back(firstChild + 1);
+  }
+}
+
+/**
+ * Find the triangles whose bounding boxes are crossed by a ray. Only these
+ * triangles can be intersected by the ray.
+ * @param start :: start point of the ray
+ * @param direction :: direction of the ray
+ * @param candidates :: the indices of the triangles are appended to this, in
+ * no particular order
+ */
+void MeshBVH::findCandidateTriangles(const Kernel::V3D &start, const Kernel::V3D &direction,
+                                     std::vector<size_t> &candidates) const {
+  if (m_nodes.empty())
+    return;
+  std::vector<uint32_t> toVisit{0};
+  while (!toVisit.empty()) {
+    const Node &node = m_nodes[toVisit.back()];
+    toVisit.pop_back();
+    if (!rayCrossesBox(node, start, direction))
+      continue;
+    if (node.count == 0) {
+      toVisit.emplace_back(node.first);
+      toVisit.emplace_back(node.first + 1);
+    } else {
+      candidates.insert(candidates.end(), m_order.cbegin() + node.first, m_order.cbegin() + node.first + node.count);
+    }
+  }
+}
+
+/**
+ * Slab test of a ray against the box of a node
+ * @param node :: node of the tree
+ * @param start :: start point of the ray
+ * @param direction :: direction of the ray
+ * @return true if the ray passes through the box
+ */
+bool MeshBVH::rayCrossesBox(const Node &node, const Kernel::V3D &start, const Kernel::V3D &direction) const {
+  double tNear = std::numeric_limits<double>::lowest();
+  double tFar = std::numeric_limits<double>::max();
+  for (size_t a = 0; a < 3; ++a) {
+    if (direction[a] == 0.0) {
+      if (start[a] < node.minPoint[a] || start[a] > node.maxPoint[a])
+        return false;
+      continue;
+    }
+    const double inverse = 1.0 / direction[a];
+    double t1 = (node.minPoint[a] - start[a]) * inverse;
+    double t2 = (node.maxPoint[a] - start[a]) * inverse;
+    if (t1 > t2)
+      std::swap(t1, t2);
+    tNear = std::max(tNear, t1);
+    tFar = std::min(tFar, t2);
+    if (tNear > tFar)
+      return false;
+  }
+  return tFar >= 0.0;
+}
+
+} // namespace Mantid::Geometry
@@ -174,9 +174,14 @@ int MeshObject::interceptSurface(Geometry::Track &UT) const {
  * @throws std::runtime_error if no intersection was found
  */
 double MeshObject::distance(const Track &track) const {
+  std::vector<size_t> candidates;
+  getBVH().findCandidateTriangles(track.startPoint(), track.direction(), candidates);
+  std::sort(candidates.begin(), candidates.end());
+
   Kernel::V3D vertex1, vertex2, vertex3, intersection;
   TrackDirection unused;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+  for (const auto i : candidates) {
+    getTriangle(i, vertex1, vertex2, vertex3);
     if (MeshObjectCommon::rayIntersectsTriangle(track.startPoint(), track.direction(), vertex1, vertex2, vertex3,
                                                 intersection, unused)) {
       return track.startPoint().distance(intersection);
@@ -199,9 +204,16 @@ void MeshObject::getIntersections(const Kernel::V3D &start, const Kernel::V3D &d
                                   std::vector<Kernel::V3D> &intersectionPoints,
                                   std::vector<TrackDirection> &entryExitFlags) const {
 
+  // Only the triangles whose bounding boxes the ray crosses can be intersected.
+  // Test them in the order of the mesh so the points come out in that order.
+  std::vector<size_t> candidates;
+  getBVH().findCandidateTriangles(start, direction, candidates);
+  std::sort(candidates.begin(), candidates.end());
+
   Kernel::V3D vertex1, vertex2, vertex3, intersection;
   TrackDirection entryExit;
-  for (size_t i = 0; getTriangle(i, vertex1, vertex2, vertex3); ++i) {
+  for (const auto i : candidates) {
+    getTriangle(i, vertex1, vertex2, vertex3);
     if (MeshObjectCommon::rayIntersectsTriangle(start, direction, vertex1, vertex2, vertex3, intersection, entryExit)) {
       intersectionPoints.emplace_back(intersection);
       entryExitFlags.emplace_back(entryExit);
@@ -210,6 +222,26 @@ void MeshObject::getIntersections(const Kernel::V3D &start, const Kernel::V3D &d
   // still need to deal with edge cases
 }
 
+/**
+ * Get the bounding volume hierarchy of the triangles. It is built on the first
+ * call, which may come from several threads at once.
+ * @returns the hierarchy for the current vertices
+ */
+const MeshBVH &MeshObject::getBVH() const {
+  std::call_once(*m_bvhBuilt, [this]() { m_bvh = std::make_unique<MeshBVH>(m_triangles, m_vertices); });
+  return *m_bvh;
+}
+
+/**
+ * Discard the cached bounding box and bounding volume hierarchy so that they
+ * are rebuilt for the new vertex positions when next needed
+ */
+void MeshObject::clearGeometryCaches() {
+  m_boundingBox = BoundingBox();
+  m_bvh.reset();
+  m_bvhBuilt = std::make_unique<std::once_flag>();
+}
+
 /*
  * Get a triangle - useful for iterating over triangles
  * @param index :: Index of triangle in MeshObject
@@ -476,6 +508,7 @@ std::shared_ptr<GeometryHandler> MeshObject::getGeometryHandler() const {
 void MeshObject::rotate(const Kernel::Matrix<double> &rotationMatrix) {
   std::for_each(m_vertices.begin(), m_vertices.end(),
                 [&rotationMatrix](auto &vertex) { vertex.rotate(rotationMatrix); });
+  clearGeometryCaches();
 }
 
 /**
@@ -485,6 +518,7 @@ void MeshObject::rotate(const Kernel::Matrix<double> &rotationMatrix) {
 void MeshObject::translate(const Kernel::V3D &translationVector) {
   std::transform(m_vertices.cbegin(), m_vertices.cend(), m_vertices.begin(),
                  [&translationVector](const auto &vertex) { return vertex + translationVector; });
+  clearGeometryCaches();
 }
 
 /**
@@ -494,6 +528,7 @@ void MeshObject::translate(const Kernel::V3D &translationVector) {
 void MeshObject::scale(const double scaleFactor) {
   std::transform(m_vertices.cbegin(), m_vertices.cend(), m_vertices.begin(),
                  [&scaleFactor](const auto &vertex) { return vertex * scaleFactor; });
+  clearGeometryCaches();
 }
 
 /**
@@ -519,6 +554,7 @@ void MeshObject::multiply(const Kernel::Matrix<double> &matrix) {
     Kernel::V3D newvertex(vertexout[0], vertexout[1], vertexout[2]);
     vertex = newvertex;
   }
+  clearGeometryCaches();
 }
 
 /**
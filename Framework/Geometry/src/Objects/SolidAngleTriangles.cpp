@@ -0,0 +1,255 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidGeometry/Objects/SolidAngleTriangles.h"
+#include "MantidGeometry/Surfaces/Cone.h"
+#include "MantidGeometry/Surfaces/Cylinder.h"
+#include "MantidKernel/Quat.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace Mantid::Geometry {
+using Kernel::Quat;
+using Kernel::V3D;
+
+namespace {
+/**
+ * Find the solid angle of a triangle from the vectors from the observer to its
+ * corners using the formula of Oosterom
+ * O=2atan([a,b,c]/(abc+(a.b)c+(a.c)b+(b.c)a))
+ * @return :: solid angle of triangle in Steradians, negative if the corners
+ * are ordered clockwise as seen by the observer
+ */
+inline double triangleSolidAngle(const double aox, const double aoy, const double aoz, const double box,
+                                 const double boy, const double boz, const double cox, const double coy,
+                                 const double coz) {
+  const double modao = std::sqrt(aox * aox + aoy * aoy + aoz * aoz);
+  const double modbo = std::sqrt(box * box + boy * boy + boz * boz);
+  const double modco = std::sqrt(cox * cox + coy * coy + coz * coz);
+  const double aobo = aox * box + aoy * boy + aoz * boz;
+  const double aoco = aox * cox + aoy * coy + aoz * coz;
+  const double boco = box * cox + boy * coy + boz * coz;
+  const double scalTripProd =
+      aox * (boy * coz - boz * coy) + aoy * (boz * cox - box * coz) + aoz * (box * coy - boy * cox);
+  const double denom = modao * modbo * modco + modco * aobo + modbo * aoco + modao * boco;
+  return denom != 0.0 ? 2.0 * std::atan2(scalTripProd, denom) : 0.0;
+}
+} // namespace
+
+/**
+ * The 12 triangles on the faces of a cuboid, ordered so that those facing the
+ * observer have a positive solid angle
+ * @param vectors :: the 4 points defining the cuboid
+ * @return the triangles of the cuboid
+ */
+SolidAngleTriangles SolidAngleTriangles::cuboid(const std::vector<V3D> &vectors) {
+  const V3D dx = vectors[1] - vectors[0];
+  const V3D dz = vectors[3] - vectors[0];
+  const std::array<V3D, 8> pts{vectors[2],      vectors[2] + dx,      vectors[1],      vectors[0],
+                               vectors[2] + dz, vectors[2] + dz + dx, vectors[1] + dz, vectors[0] + dz};
+  constexpr std::array<std::array<size_t, 3>, 12> triMap{{{1, 4, 3},
+                                                          {3, 2, 1},
+                                                          {5, 6, 7},
+                                                          {7, 8, 5},
+                                                          {1, 2, 6},
+                                                          {6, 5, 1},
+                                                          {2, 3, 7},
+                                                          {7, 6, 2},
+                                                          {3, 4, 8},
+                                                          {8, 7, 3},
+                                                          {1, 5, 8},
+                                                          {8, 4, 1}}};
+  SolidAngleTriangles triangles(Sum::FacingObserver);
+  for (const auto &corners : triMap)
+    triangles.addTriangle(pts[corners[0] - 1], pts[corners[1] - 1], pts[corners[2] - 1]);
+  return triangles;
+}
+
+/**
+ * The triangles on the side of a cylinder, EXCLUDING the end caps so that
+ * stacked cylinders give the correct value of solid angle (i.e shadowing is
+ * loosely taken into account).
+ * @param centre :: The centre of the base
+ * @param axis :: The axis vector
+ * @param radius :: The radius
+ * @param height :: The height
+ * @param numberOfSlices :: The number of slices around the axis
+ * @return the triangles of the cylinder
+ */
+SolidAngleTriangles SolidAngleTriangles::cylinder(const V3D &centre, const V3D &axis, const double radius,
+                                                  const double height, const int numberOfSlices) {
+  // The triangulation points are constructed such that the cylinder axis
+  // points up the +Z axis and then rotated into their final position
+  constexpr V3D initial_axis(0., 0., 1.0);
+  const Quat transform(initial_axis, axis);
+  const double angle_step = 2 * M_PI / static_cast<double>(numberOfSlices);
+  const double z_step = height / Cylinder::g_NSTACKS;
+
+  SolidAngleTriangles triangles(Sum::FacingObserver);
+  double z0(0.0), z1(z_step);
+  for (int st = 1; st <= Cylinder::g_NSTACKS; ++st) {
+    if (st == Cylinder::g_NSTACKS)
+      z1 = height;
+
+    for (int sl = 0; sl < numberOfSlices; ++sl) {
+      double x = radius * std::cos(angle_step * sl);
+      double y = radius * std::sin(angle_step * sl);
+      V3D pt1 = V3D(x, y, z0);
+      V3D pt2 = V3D(x, y, z1);
+      int vertex = (sl + 1) % numberOfSlices;
+      x = radius * std::cos(angle_step * vertex);
+      y = radius * std::sin(angle_step * vertex);
+      V3D pt3 = V3D(x, y, z0);
+      V3D pt4 = V3D(x, y, z1);
+      // Rotations
+      transform.rotate(pt1);
+      transform.rotate(pt3);
+      transform.rotate(pt2);
+      transform.rotate(pt4);
+
+      pt1 += centre;
+      pt2 += centre;
+      pt3 += centre;
+      pt4 += centre;
+
+      triangles.addTriangle(pt1, pt4, pt3);
+      triangles.addTriangle(pt1, pt2, pt4);
+    }
+    z0 = z1;
+    z1 += z_step;
+  }
+  return triangles;
+}
+
+/**
+ * The triangles of a cone, made of its base cap, its side and its top
+ * @param centre :: The centre of the base
+ * @param axis :: The axis vector
+ * @param radius :: The radius
+ * @param height :: The height
+ * @return the triangles of the cone
+ */
+SolidAngleTriangles SolidAngleTriangles::cone(const V3D &centre, const V3D &axis, const double radius,
+                                              const double height) {
+  // The triangulation points are constructed such that the cone axis points
+  // up the +Z axis and then rotated into their final position
+  const V3D axis_direction = normalize(axis);
+  constexpr V3D initial_axis(0., 0., 1.0);
+  const Quat transform(initial_axis, axis_direction);
+
+  // Store the (x,y) points as they are used quite frequently
+  constexpr double angle_step = 2 * M_PI / Cone::g_NSLICES;
+  std::array<double, Cone::g_NSLICES> cos_table;
+  std::array<double, Cone::g_NSLICES> sin_table;
+  for (int sl = 0; sl < Cone::g_NSLICES; ++sl) {
+    cos_table[sl] = std::cos(angle_step * sl);
+    sin_table[sl] = std::sin(angle_step * sl);
+  }
+
+  SolidAngleTriangles triangles(Sum::FacingObserver);
+  // The base cap is a point at the centre and nslices points around it
+  for (int sl = 0; sl < Cone::g_NSLICES; ++sl) {
+    const int next = (sl + 1) % Cone::g_NSLICES;
+    V3D pt2 = V3D(radius * cos_table[sl], radius * sin_table[sl], 0.0);
+    V3D pt3 = V3D(radius * cos_table[next], radius * sin_table[next], 0.0);
+    transform.rotate(pt2);
+    transform.rotate(pt3);
+    triangles.addTriangle(centre, pt2 + centre, pt3 + centre);
+  }
+
+  // Now the main section
+  const double z_step = height / Cone::g_NSTACKS;
+  const double r_step = height / Cone::g_NSTACKS;
+  double z0(0.0), z1(z_step);
+  double r0(radius), r1(r0 - r_step);
+  for (int st = 1; st < Cone::g_NSTACKS; ++st) {
+    for (int sl = 0; sl < Cone::g_NSLICES; ++sl) {
+      const int next = (sl + 1) % Cone::g_NSLICES;
+      V3D pt1 = V3D(r0 * cos_table[sl], r0 * sin_table[sl], z0);
+      V3D pt3 = V3D(r0 * cos_table[next], r0 * sin_table[next], z0);
+      V3D pt2 = V3D(r1 * cos_table[sl], r1 * sin_table[sl], z1);
+      V3D pt4 = V3D(r1 * cos_table[next], r1 * sin_table[next], z1);
+      // Rotations
+      transform.rotate(pt1);
+      transform.rotate(pt3);
+      transform.rotate(pt2);
+      transform.rotate(pt4);
+
+      pt1 += centre;
+      pt2 += centre;
+      pt3 += centre;
+      pt4 += centre;
+      triangles.addTriangle(pt1, pt4, pt3);
+      triangles.addTriangle(pt1, pt2, pt4);
+    }
+    z0 = z1;
+    r0 = r1;
+    z1 += z_step;
+    r1 -= r_step;
+  }
+
+  // Top section
+  V3D top_centre = V3D(0.0, 0.0, height) + centre;
+  transform.rotate(top_centre);
+  top_centre += centre;
+  for (int sl = 0; sl < Cone::g_NSLICES; ++sl) {
+    const int next = (sl + 1) % Cone::g_NSLICES;
+    V3D pt2 = V3D(r0 * cos_table[sl], r0 * sin_table[sl], height);
+    V3D pt3 = V3D(r0 * cos_table[next], r0 * sin_table[next], height);
+    // Rotate them to the correct axis orientation
+    transform.rotate(pt2);
+    transform.rotate(pt3);
+    triangles.addTriangle(top_centre, pt3 + centre, pt2 + centre);
+  }
+  return triangles;
+}
+
+/**
+ * Append a triangle
+ * @param a :: first corner
+ * @param b :: second corner
+ * @param c :: third corner
+ */
+void SolidAngleTriangles::addTriangle(const V3D &a, const V3D &b, const V3D &c) {
+  m_ax.emplace_back(a.X());
+  m_ay.emplace_back(a.Y());
+  m_az.emplace_back(a.Z());
+  m_bx.emplace_back(b.X());
+  m_by.emplace_back(b.Y());
+  m_bz.emplace_back(b.Z());
+  m_cx.emplace_back(c.X());
+  m_cy.emplace_back(c.Y());
+  m_cz.emplace_back(c.Z());
+}
+
+/**
+ * Sum the solid angles of the triangles
+ * @param observer :: point from which the solid angle is required, in the
+ * frame of the triangles
+ * @return the solid angle in steradians
+ */
+double SolidAngleTriangles::solidAngle(const V3D &observer) const {
+  const double ox = observer.X();
+  const double oy = observer.Y();
+  const double oz = observer.Z();
+  const bool facingOnly = m_sum == Sum::FacingObserver;
+  const size_t nTriangles = size();
+  double sangle(0.0);
+  for (size_t i = 0; i < nTriangles; ++i) {
+    const double sa = triangleSolidAngle(m_ax[i] - ox, m_ay[i] - oy, m_az[i] - oz, m_bx[i] - ox, m_by[i] - oy,
+                                         m_bz[i] - oz, m_cx[i] - ox, m_cy[i] - oy, m_cz[i] - oz);
+    sangle += facingOnly ? std::max(sa, 0.0) : std::abs(sa);
+  }
+  /* For the average we assume that objects are opaque to neutrons and define
+   * closed surfaces which are convex. For such objects negative solid angle
+   * equals positive solid angle, whichever way the triangles are wound.
+   */
+  return facingOnly ? sangle : 0.5 * sangle;
+}
+
+} // namespace Mantid::Geometry
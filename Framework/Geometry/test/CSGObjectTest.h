@@ -360,6 +360,34 @@ public:
     checkTrackIntercept(geom_obj, track, expectedResults);
   }
 
+  void testInterceptSurfaceMissesOnlyTracksOutsideShape() {
+    // Tracks which are skipped without testing the surfaces must not pass
+    // through the shape
+    const std::vector<std::shared_ptr<CSGObject>> shapes{
+        ComponentCreationHelper::createSphere(0.5),
+        ComponentCreationHelper::createHollowShell(0.3, 0.5),
+        ComponentCreationHelper::createCuboid(0.2, 0.4, 0.1, M_PI / 5., V3D{1, 1, 0}),
+        ComponentCreationHelper::createCappedCylinder(0.3, 0.8, V3D{0.1, -0.4, 0.}, V3D{1., 1., 1.}, "cyl"),
+        ComponentCreationHelper::createHollowCylinder(0.2, 0.3, 0.8, V3D{0., -0.4, 0.}, V3D{0., 1., 1.}, "hol-cyl")};
+    Mantid::Kernel::MersenneTwister rng(7);
+    for (const auto &shape : shapes) {
+      size_t misses(0);
+      for (size_t i = 0; i < 500; ++i) {
+        const V3D start(2 * rng.nextValue() - 1, 2 * rng.nextValue() - 1, 2 * rng.nextValue() - 1);
+        V3D direction(rng.nextValue() - 0.5, rng.nextValue() - 0.5, rng.nextValue() - 0.5);
+        direction.normalize();
+        Track track(start, direction);
+        if (shape->interceptSurface(track) > 0)
+          continue;
+        ++misses;
+        for (double distance = 0.; distance < 3.; distance += 0.005) {
+          TS_ASSERT(!shape->isValid(start + direction * distance));
+        }
+      }
+      TS_ASSERT_LESS_THAN(0, misses);
+    }
+  }
+
   void checkTrackIntercept(Track &track, const std::vector<Link> &expectedResults) {
     size_t index = 0;
     for (Track::LType::const_iterator it = track.cbegin(); it != track.cend(); ++it) {
@@ -2165,7 +2193,9 @@ public:
         m_cylinder(ComponentCreationHelper::createCappedCylinder(0.1, 0.4, V3D{0., 0., 0.}, V3D{0., 1., 0.}, "cyl")),
         m_rotatedCuboid(ComponentCreationHelper::createCuboid(0.01, 0.12, 0.12, M_PI / 4., V3D{0, 0, 1})),
         m_sphere(ComponentCreationHelper::createSphere(0.1)),
-        m_sphericalShell(ComponentCreationHelper::createHollowShell(0.009, 0.01)) {}
+        m_sphericalShell(ComponentCreationHelper::createHollowShell(0.009, 0.01)),
+        m_hollowCylinder(ComponentCreationHelper::createHollowCylinder(0.01, 0.012, 0.04, V3D{0., -0.02, 0.},
+                                                                       V3D{0., 1., 0.}, "hol-cyl")) {}
 
   void test_generatePointInside_Cuboid_With_ActiveRegion() {
     constexpr size_t maxAttempts{500};
@@ -2209,6 +2239,17 @@ public:
     }
   }
 
+  void test_interceptSurface_mostly_missing_HollowCylinder() {
+    // as for the components of a sample environment: most tracks miss each one
+    const V3D start(0., 0., -1.);
+    for (size_t i = 0; i < m_npoints; ++i) {
+      V3D direction(m_rng.nextValue() - 0.5, m_rng.nextValue() - 0.5, 1.);
+      direction.normalize();
+      Track track(start, direction);
+      m_hollowCylinder->interceptSurface(track);
+    }
+  }
+
 private:
   static constexpr size_t m_npoints{1000000};
   Mantid::Kernel::MersenneTwister m_rng;
@@ -2218,4 +2259,5 @@ private:
   IObject_sptr m_rotatedCuboid;
   IObject_sptr m_sphere;
   IObject_sptr m_sphericalShell;
+  IObject_sptr m_hollowCylinder;
 };
@@ -251,6 +251,43 @@ public:
     TS_ASSERT_DELTA(info.solidAngle(0, V3D(10, 1.7, 0)), 1.840302, satol);
   }
 
+  void test_solidAngles_matches_solidAngle() {
+    // Banks of cylindrical and of cuboid pixels, the pixels of a bank sharing a shape
+    for (const auto &instrument : {ComponentCreationHelper::createTestInstrumentCylindrical(2),
+                                   ComponentCreationHelper::createTestInstrumentRectangular(2, 4)}) {
+      auto wrappers = InstrumentVisitor::makeWrappers(*instrument);
+      auto &componentInfo = *std::get<0>(wrappers);
+      const auto &detectorInfo = *std::get<1>(wrappers);
+      // A scaled pixel needs triangles of its own
+      componentInfo.setScaleFactor(1, V3D(1.0, 2.0, 1.0));
+
+      std::vector<size_t> detectorIndices;
+      for (size_t i = 0; i < detectorInfo.size(); ++i) {
+        if (componentInfo.hasValidShape(i))
+          detectorIndices.emplace_back(i);
+      }
+      // An observer close to the detectors, and one inside the first pixel
+      for (const auto &observer : {V3D(0.1, -0.2, 0.3), componentInfo.position(detectorIndices.front())}) {
+        const SolidAngleParams params(observer);
+        const auto solidAngles = componentInfo.solidAngles(detectorIndices, params);
+        TS_ASSERT_EQUALS(solidAngles.size(), detectorIndices.size());
+        for (size_t i = 0; i < detectorIndices.size(); ++i)
+          TS_ASSERT_DELTA(solidAngles[i], componentInfo.solidAngle(detectorIndices[i], params), 1e-12);
+      }
+    }
+  }
+
+  void test_solidAngles_throws_without_shape() {
+    auto internalInfo = makeSingleBeamlineComponentInfo();
+    Mantid::Geometry::ObjComponent comp1("component1", createCappedCylinder());
+    auto componentIds = std::make_shared<std::vector<Mantid::Geometry::ComponentID>>(
+        std::vector<Mantid::Geometry::ComponentID>{&comp1});
+    auto shapes = std::make_shared<std::vector<std::shared_ptr<const Geometry::IObject>>>(1);
+    ComponentInfo info(std::move(internalInfo), componentIds, makeComponentIDMap(componentIds), shapes);
+
+    TS_ASSERT_THROWS(info.solidAngles({0}, V3D(10, 0, 0)), Mantid::Kernel::Exception::NullPointerException &);
+  }
+
   void test_boundingBox_single_component() {
 
     const double radius = 2;
@@ -1027,6 +1027,40 @@ public:
                      122888); // Sanity check
   }
 
+  void test_load_many_pixels_with_many_parameterised_components() {
+    // Every pixel checks whether its component and location elements hold
+    // <parameter>s, against a list of all the elements which do
+    const int nBanks(400), nPixels(250);
+    std::string contents = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+                           "<instrument name=\"ManyParameters\" valid-from=\"1900-01-31 23:59:59\" "
+                           "valid-to=\"2100-01-31 23:59:59\" last-modified=\"2012-10-05 11:00:00\">"
+                           "<defaults/>"
+                           "<component type=\"source\"><location z=\"-10.0\"/></component>"
+                           "<type name=\"source\" is=\"Source\"/>"
+                           "<component type=\"sample-position\"><location/></component>"
+                           "<type name=\"sample-position\" is=\"SamplePos\"/>"
+                           "<type name=\"pixel\" is=\"detector\">"
+                           "<sphere id=\"shape\"><centre x=\"0.0\" y=\"0.0\" z=\"0.0\"/><radius val=\"0.001\"/>"
+                           "</sphere></type>";
+    for (int bank = 0; bank < nBanks; ++bank) {
+      const auto name = "bank" + std::to_string(bank);
+      contents += "<component type=\"" + name + "\" idlist=\"" + name + "\"><location y=\"" +
+                  std::to_string(0.01 * bank) + "\" z=\"5.0\"/><parameter name=\"offset\"><value val=\"" +
+                  std::to_string(bank) + "\"/></parameter></component>";
+      contents += "<type name=\"" + name + "\"><component type=\"pixel\"><locations n-elements=\"" +
+                  std::to_string(nPixels) +
+                  "\" x=\"0.0\" x-end=\"0.5\"/><parameter name=\"gain\"><value val=\"1.0\"/></parameter>"
+                  "</component></type>";
+      contents += "<idlist idname=\"" + name + "\"><id start=\"" + std::to_string(bank * nPixels + 1) +
+                  "\" end=\"" + std::to_string((bank + 1) * nPixels) + "\"/></idlist>";
+    }
+    contents += "</instrument>";
+
+    InstrumentDefinitionParser parser("ManyParameters_Definition.xml", "dummy", contents);
+    auto instrument = parser.parseXML(nullptr);
+    TS_ASSERT_EQUALS(extractDetectorInfo(*instrument)->size(), nBanks * nPixels);
+  }
+
 private:
   const std::string m_instrumentDirectoryPath;
 
@@ -0,0 +1,103 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidGeometry/Objects/MeshBVH.h"
+#include "MantidGeometry/Objects/MeshObjectCommon.h"
+#include "MantidKernel/MersenneTwister.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+
+using Mantid::Geometry::MeshBVH;
+using Mantid::Geometry::TrackDirection;
+using Mantid::Kernel::V3D;
+
+class MeshBVHTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MeshBVHTest *createSuite() { return new MeshBVHTest(); }
+  static void destroySuite(MeshBVHTest *suite) { delete suite; }
+
+  void test_empty_mesh_has_no_candidates() {
+    MeshBVH bvh({}, {});
+    std::vector<size_t> candidates;
+    bvh.findCandidateTriangles(V3D(0, 0, 0), V3D(1, 0, 0), candidates);
+    TS_ASSERT(candidates.empty());
+    TS_ASSERT_EQUALS(bvh.numberOfNodes(), 0);
+  }
+
+  void test_single_triangle() {
+    const std::vector<V3D> vertices{V3D(0, 0, 0), V3D(1, 0, 0), V3D(0, 1, 0)};
+    MeshBVH bvh({0, 1, 2}, vertices);
+    TS_ASSERT_EQUALS(bvh.numberOfNodes(), 1);
+
+    std::vector<size_t> candidates;
+    bvh.findCandidateTriangles(V3D(0.2, 0.2, -1), V3D(0, 0, 1), candidates);
+    TS_ASSERT_EQUALS(candidates, std::vector<size_t>{0});
+
+    candidates.clear();
+    // pointing away from the triangle
+    bvh.findCandidateTriangles(V3D(0.2, 0.2, -1), V3D(0, 0, -1), candidates);
+    TS_ASSERT(candidates.empty());
+
+    candidates.clear();
+    // starting on the triangle
+    bvh.findCandidateTriangles(V3D(0.2, 0.2, 0), V3D(0, 0, -1), candidates);
+    TS_ASSERT_EQUALS(candidates, std::vector<size_t>{0});
+  }
+
+  void test_candidates_include_every_intersected_triangle() {
+    std::vector<uint32_t> triangles;
+    std::vector<V3D> vertices;
+    makeRandomTriangles(2000, triangles, vertices);
+    MeshBVH bvh(triangles, vertices);
+    TS_ASSERT_LESS_THAN(1, bvh.numberOfNodes());
+
+    Mantid::Kernel::MersenneTwister rng(12345);
+    size_t totalCandidates(0);
+    const size_t nRays(200);
+    for (size_t ray = 0; ray < nRays; ++ray) {
+      const V3D start(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      V3D direction(rng.nextValue() - 0.5, rng.nextValue() - 0.5, rng.nextValue() - 0.5);
+      direction.normalize();
+
+      std::vector<size_t> candidates;
+      bvh.findCandidateTriangles(start, direction, candidates);
+      std::sort(candidates.begin(), candidates.end());
+      totalCandidates += candidates.size();
+
+      V3D intersection;
+      TrackDirection entryExit;
+      for (size_t i = 0; i < triangles.size() / 3; ++i) {
+        if (Mantid::Geometry::MeshObjectCommon::rayIntersectsTriangle(
+                start, direction, vertices[triangles[3 * i]], vertices[triangles[3 * i + 1]],
+                vertices[triangles[3 * i + 2]], intersection, entryExit)) {
+          TS_ASSERT(std::binary_search(candidates.cbegin(), candidates.cend(), i));
+        }
+      }
+    }
+    // The point of the hierarchy: a ray only sees a fraction of the triangles
+    TS_ASSERT_LESS_THAN(totalCandidates, nRays * triangles.size() / 6);
+  }
+
+private:
+  /// Small triangles scattered through the unit cube
+  void makeRandomTriangles(const size_t nTriangles, std::vector<uint32_t> &triangles, std::vector<V3D> &vertices) {
+    Mantid::Kernel::MersenneTwister rng(1);
+    for (size_t i = 0; i < nTriangles; ++i) {
+      const V3D centre(rng.nextValue(), rng.nextValue(), rng.nextValue());
+      for (uint32_t corner = 0; corner < 3; ++corner) {
+        vertices.emplace_back(centre +
+                              V3D(rng.nextValue() - 0.5, rng.nextValue() - 0.5, rng.nextValue() - 0.5) * 0.05);
+        triangles.emplace_back(static_cast<uint32_t>(vertices.size() - 1));
+      }
+    }
+  }
+};
@@ -172,6 +172,47 @@ std::unique_ptr<MeshObject> createLShape() {
       std::make_unique<MeshObject>(std::move(triangles), std::move(vertices), Mantid::Kernel::Material());
   return retVal;
 }
+
+std::unique_ptr<MeshObject> createCan(const double innerRadius, const double outerRadius, const double height,
+                                      const uint32_t nSegments, const uint32_t nLayers) {
+  /**
+   * Create a hollow cylinder about the z axis, from z = 0 to height, like the
+   * tail of a cryostat. The walls are split into nSegments around the axis and
+   * nLayers along it. No vertex lies on the x or y axes.
+   */
+  std::vector<V3D> vertices;
+  for (const double radius : {outerRadius, innerRadius}) {
+    for (uint32_t j = 0; j <= nLayers; ++j) {
+      const double z = height * j / nLayers;
+      for (uint32_t k = 0; k < nSegments; ++k) {
+        const double angle = 2.0 * M_PI * (k + 0.5) / nSegments;
+        vertices.emplace_back(V3D(radius * std::cos(angle), radius * std::sin(angle), z));
+      }
+    }
+  }
+  const uint32_t innerStart = (nLayers + 1) * nSegments;
+  auto outer = [nSegments](uint32_t k, uint32_t j) { return j * nSegments + k % nSegments; };
+  auto inner = [nSegments, innerStart](uint32_t k, uint32_t j) { return innerStart + j * nSegments + k % nSegments; };
+
+  std::vector<uint32_t> triangles;
+  for (uint32_t k = 0; k < nSegments; ++k) {
+    for (uint32_t j = 0; j < nLayers; ++j) {
+      // outer wall facing away from the axis
+      triangles.insert(triangles.end(), {outer(k, j), outer(k + 1, j), outer(k + 1, j + 1)});
+      triangles.insert(triangles.end(), {outer(k, j), outer(k + 1, j + 1), outer(k, j + 1)});
+      // inner wall facing the axis
+      triangles.insert(triangles.end(), {inner(k, j), inner(k + 1, j + 1), inner(k + 1, j)});
+      triangles.insert(triangles.end(), {inner(k, j), inner(k, j + 1), inner(k + 1, j + 1)});
+    }
+    // top and bottom rings
+    triangles.insert(triangles.end(), {outer(k, nLayers), outer(k + 1, nLayers), inner(k + 1, nLayers)});
+    triangles.insert(triangles.end(), {outer(k, nLayers), inner(k + 1, nLayers), inner(k, nLayers)});
+    triangles.insert(triangles.end(), {outer(k, 0), inner(k + 1, 0), outer(k + 1, 0)});
+    triangles.insert(triangles.end(), {outer(k, 0), inner(k, 0), inner(k + 1, 0)});
+  }
+
+  return std::make_unique<MeshObject>(std::move(triangles), std::move(vertices), Mantid::Kernel::Material());
+}
 } // namespace
 
 class MeshObjectTest : public CxxTest::TestSuite {
@@ -366,6 +407,39 @@ public:
     checkTrackIntercept(std::move(geom_obj), track, expectedResults);
   }
 
+  void testInterceptLargeCan() {
+    // 2000 segments around the axis: the walls are within 1e-6 of round
+    auto can = createCan(0.04, 0.05, 0.2, 2000, 25);
+    TS_ASSERT_EQUALS(can->numberOfTriangles(), 2000 * (4 * 25 + 4));
+    Track track(V3D(-1.0, 0.0, 0.1), V3D(1, 0, 0));
+
+    TS_ASSERT_EQUALS(can->interceptSurface(track), 2);
+    TS_ASSERT_EQUALS(track.count(), 2);
+    auto link = track.cbegin();
+    TS_ASSERT_DELTA(link->entryPoint.X(), -0.05, 1e-6);
+    TS_ASSERT_DELTA(link->exitPoint.X(), -0.04, 1e-6);
+    ++link;
+    TS_ASSERT_DELTA(link->entryPoint.X(), 0.04, 1e-6);
+    TS_ASSERT_DELTA(link->exitPoint.X(), 0.05, 1e-6);
+
+    TS_ASSERT(can->isValid(V3D(0.045, 0.0, 0.1)));
+    TS_ASSERT(!can->isValid(V3D(0.0, 0.0, 0.1)));
+    TS_ASSERT_DELTA(can->distance(track), 0.95, 1e-6);
+  }
+
+  void testInterceptAfterTranslation() {
+    auto geom_obj = createCube(4.0);
+    // build the cached bounding box and ray tracing structures before moving the mesh
+    Track before(V3D(1, -8, 1), V3D(0, 1, 0));
+    TS_ASSERT_EQUALS(geom_obj->interceptSurface(before), 1);
+
+    geom_obj->translate(V3D(2, 0, 0));
+    Track track(V3D(5, -8, 1), V3D(0, 1, 0));
+    std::vector<Link> expectedResults;
+    expectedResults.emplace_back(Link(V3D(5, 0, 1), V3D(5, 4, 1), 12.0, *geom_obj));
+    checkTrackIntercept(std::move(geom_obj), track, expectedResults);
+  }
+
   void testDistanceWithIntersectionReturnsResult() {
     auto geom_obj = createCube(3);
     V3D dir(0., 1., 0.);
@@ -912,7 +986,8 @@ public:
   static void destroySuite(MeshObjectTestPerformance *suite) { delete suite; }
 
   MeshObjectTestPerformance()
-      : rng(200000), octahedron(createOctahedron()), lShape(createLShape()), smallCube(createCube(0.2)) {
+      : rng(200000), octahedron(createOctahedron()), lShape(createLShape()), smallCube(createCube(0.2)),
+        can(createCan(0.04, 0.05, 0.2, 2000, 25)) {
     testPoints = create_test_points();
     testRays = create_test_rays();
     translation = create_translation_vector();
@@ -963,6 +1038,24 @@ public:
     }
   }
 
+  void test_interceptSurface_large_mesh() {
+    const size_t number(100000);
+    for (size_t i = 0; i < number; ++i) {
+      Track track(can->getBoundingBox().centrePoint() + testPoints[i % testPoints.size()] * 0.01,
+                  testRays[i % testRays.size()].direction());
+      can->interceptSurface(track);
+    }
+  }
+
+  void test_generatePointInside_large_mesh() {
+    const size_t npoints(10000);
+    const size_t maxAttempts(500);
+    std::optional<V3D> point;
+    for (size_t i = 0; i < npoints; ++i) {
+      point = can->generatePointInObject(rng, maxAttempts);
+    }
+  }
+
   void test_solid_angle() {
     const size_t number(10000);
     for (size_t i = 0; i < number; ++i) {
@@ -1087,6 +1180,7 @@ private:
   std::unique_ptr<MeshObject> octahedron;
   std::unique_ptr<MeshObject> lShape;
   std::unique_ptr<MeshObject> smallCube;
+  std::unique_ptr<MeshObject> can;
   std::vector<V3D> testPoints;
   std::vector<Track> testRays;
   V3D translation;
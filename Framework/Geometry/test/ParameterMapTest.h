@@ -9,7 +9,10 @@
 #include "MantidBeamline/ComponentInfo.h"
 #include "MantidBeamline/DetectorInfo.h"
 #include "MantidFrameworkTestHelpers/ComponentCreationHelper.h"
+#include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/Detector.h"
+#include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/InstrumentVisitor.h"
 #include "MantidGeometry/Instrument/Parameter.h"
 #include "MantidGeometry/Instrument/ParameterFactory.h"
 #include "MantidGeometry/Instrument/ParameterMap.h"
@@ -17,11 +20,13 @@
 #include <cxxtest/TestSuite.h>
 
 #include <boost/function.hpp>
+#include <algorithm>
 #include <memory>
 
 using Mantid::Geometry::IComponent;
 using Mantid::Geometry::IComponent_sptr;
 using Mantid::Geometry::Instrument_sptr;
+using Mantid::Geometry::InstrumentVisitor;
 using Mantid::Geometry::Parameter_sptr;
 using Mantid::Geometry::ParameterMap;
 using Mantid::Geometry::ParameterMap_sptr;
@@ -435,6 +440,40 @@ public:
     TS_ASSERT_EQUALS(fetched->value<int>(), value2);
   }
 
+  void test_getRecursiveForAllComponents_matches_getRecursive() {
+    const std::string name("tubeParam");
+    auto wrappers = InstrumentVisitor::makeWrappers(*m_testInstrument);
+    const auto &componentInfo = *wrappers.first;
+    const auto &detectorInfo = *wrappers.second;
+    ParameterMap pmap;
+    pmap.addDouble(m_testInstrument.get(), name, 1.0);
+    const auto bankIndex = componentInfo.indexOfAny("bank1");
+    pmap.addDouble(componentInfo.componentID(bankIndex), name, 2.0);
+    pmap.addDouble(componentInfo.componentID(0), name, 3.0);
+
+    const auto params = pmap.getRecursiveForAllComponents(componentInfo, name);
+    TS_ASSERT_EQUALS(params.size(), componentInfo.size());
+    TS_ASSERT_EQUALS(params[componentInfo.root()]->value<double>(), 1.0);
+    TS_ASSERT_EQUALS(params[bankIndex]->value<double>(), 2.0);
+    TS_ASSERT_EQUALS(params[0]->value<double>(), 3.0);
+    for (size_t i = 0; i < detectorInfo.size(); ++i) {
+      TS_ASSERT_EQUALS(params[i], pmap.getRecursive(componentInfo.componentID(i), name));
+    }
+    // the parameters returned do not change with the map
+    pmap.addDouble(componentInfo.componentID(0), name, 4.0);
+    TS_ASSERT_EQUALS(params[0]->value<double>(), 3.0);
+  }
+
+  void test_getRecursiveForAllComponents_without_parameter() {
+    auto wrappers = InstrumentVisitor::makeWrappers(*m_testInstrument);
+    const auto &componentInfo = *wrappers.first;
+    ParameterMap pmap;
+    pmap.addDouble(m_testInstrument.get(), "other", 1.0);
+    const auto params = pmap.getRecursiveForAllComponents(componentInfo, "missing");
+    TS_ASSERT_EQUALS(params.size(), componentInfo.size());
+    TS_ASSERT(std::none_of(params.cbegin(), params.cend(), [](const auto &param) { return param; }));
+  }
+
   void testClearByName_Only_Removes_Named_Parameter() {
     ParameterMap pmap;
     pmap.addDouble(m_testInstrument.get(), "first", 5.4);
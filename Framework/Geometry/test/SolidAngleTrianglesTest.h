@@ -0,0 +1,73 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidFrameworkTestHelpers/ComponentCreationHelper.h"
+#include "MantidGeometry/Objects/CSGObject.h"
+#include "MantidGeometry/Objects/SolidAngleTriangles.h"
+#include "MantidGeometry/Surfaces/Cylinder.h"
+
+#include <cxxtest/TestSuite.h>
+
+using Mantid::Geometry::SolidAngleParams;
+using Mantid::Geometry::SolidAngleTriangles;
+using Mantid::Kernel::V3D;
+
+class SolidAngleTrianglesTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static SolidAngleTrianglesTest *createSuite() { return new SolidAngleTrianglesTest(); }
+  static void destroySuite(SolidAngleTrianglesTest *suite) { delete suite; }
+
+  void test_triangle_facing_observer() {
+    SolidAngleTriangles triangles(SolidAngleTriangles::Sum::FacingObserver);
+    triangles.addTriangle(V3D(0, 0, 0), V3D(1, 0, 0), V3D(0, 1, 0));
+    TS_ASSERT_EQUALS(triangles.size(), 1);
+    // Far away the solid angle is the area over the distance squared
+    TS_ASSERT_DELTA(triangles.solidAngle(V3D(0, 0, -1e3)), 0.5e-6, 1e-12);
+    // Seen from behind
+    TS_ASSERT_EQUALS(triangles.solidAngle(V3D(0, 0, 1e3)), 0.0);
+    // In the plane of the triangle
+    TS_ASSERT_EQUALS(triangles.solidAngle(V3D(2, 2, 0)), 0.0);
+  }
+
+  void test_average_does_not_depend_on_winding_order() {
+    SolidAngleTriangles forward(SolidAngleTriangles::Sum::Average);
+    forward.addTriangle(V3D(0, 0, 0), V3D(1, 0, 0), V3D(0, 1, 0));
+    SolidAngleTriangles backward(SolidAngleTriangles::Sum::Average);
+    backward.addTriangle(V3D(0, 0, 0), V3D(0, 1, 0), V3D(1, 0, 0));
+    const V3D observer(0.2, 0.3, 2.0);
+    TS_ASSERT_DELTA(forward.solidAngle(observer), backward.solidAngle(observer), 1e-15);
+    TS_ASSERT_LESS_THAN(0.0, forward.solidAngle(observer));
+  }
+
+  void test_cuboid_matches_shape() {
+    // A unit cube centred on the origin
+    const auto shape = ComponentCreationHelper::createCuboid(0.5);
+    const SolidAngleParams params(V3D(0, 0, 1000.0));
+    const auto triangles = shape->solidAngleTriangles(params);
+    TS_ASSERT(triangles);
+    TS_ASSERT_EQUALS(triangles->size(), 12);
+    TS_ASSERT_DELTA(triangles->solidAngle(params.observer()), 1e-6, 1e-9);
+    TS_ASSERT_DELTA(triangles->solidAngle(params.observer()), shape->solidAngle(params), 1e-15);
+  }
+
+  void test_cylinder_matches_shape() {
+    const auto shape = ComponentCreationHelper::createCappedCylinder(0.5, 1.5, V3D(0, 0, 0), V3D(0, 1, 0), "tube");
+    const SolidAngleParams params(V3D(0.3, 0.2, 4.0), 16);
+    const auto triangles = shape->solidAngleTriangles(params);
+    TS_ASSERT(triangles);
+    TS_ASSERT_EQUALS(triangles->size(), 2 * 16 * Mantid::Geometry::Cylinder::g_NSTACKS);
+    TS_ASSERT_DELTA(triangles->solidAngle(params.observer()), shape->solidAngle(params), 1e-12);
+  }
+
+  void test_sphere_has_no_triangles() {
+    const auto shape = ComponentCreationHelper::createSphere(0.5);
+    TS_ASSERT(!shape->solidAngleTriangles(SolidAngleParams(V3D(0, 0, 4))));
+  }
+};
@@ -0,0 +1,400 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDBoxBase.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <exception>
+#include <vector>
+
+namespace Mantid {
+namespace MDAlgorithms {
+
+/**
+ * Integrates or centroids the events of an MDEventWorkspace within many spheres
+ * (or spherical shells) in a single traversal of the box tree.
+ *
+ * Integrating peaks one at a time walks the tree from the top for each peak and
+ * scans the events of every leaf box touched by the peak, so neighbouring peaks
+ * read the same boxes again. Here all the spheres are pushed down the tree
+ * together: each box keeps the list of spheres that may touch it and every leaf
+ * box is visited, and its events read, only once. The spheres are first put in
+ * buckets by the bounding box of each sphere on the grid of the top box, so
+ * each top level child, processed in parallel, only tests its nearby spheres.
+ *
+ * The results are those of MDBoxBase::integrateSphere and
+ * MDBoxBase::centroidSphere with a plain CoordTransformDistance using all
+ * dimensions, including the treatment of boxes entirely inside a sphere and of
+ * the one percent background correction, which is applied per leaf box.
+ *
+ * @tparam MDE :: the type of MDEvent in the workspace
+ * @tparam nd :: the number of dimensions
+ */
+template <typename MDE, size_t nd> class BatchSphereIntegrator {
+  using BoxBase = DataObjects::MDBoxBase<MDE, nd>;
+  using Box = DataObjects::MDBox<MDE, nd>;
+
+public:
+  /// What is accumulated for each sphere
+  enum class Mode { Integrate, Centroid };
+
+  /// Accumulated signal of one sphere
+  struct Result {
+    signal_t signal{0};
+    signal_t errorSquared{0};
+    /// signal-weighted sum of the event coordinates; Mode::Centroid only
+    std::array<coord_t, nd> centroid{};
+  };
+
+  explicit BatchSphereIntegrator(const Mode mode = Mode::Integrate, const bool useOnePercentBackgroundCorrection = true)
+      : m_mode(mode), m_useOnePercentBackgroundCorrection(useOnePercentBackgroundCorrection) {}
+
+  /**
+   * Add a sphere (or a spherical shell if innerRadiusSquared > 0) to process
+   * @param center :: array of nd coordinates of the centre
+   * @param radiusSquared :: events closer than this (squared) distance are included
+   * @param innerRadiusSquared :: events must be further than this (squared) distance
+   * @return the index of the result of this sphere
+   */
+  size_t addSphere(const coord_t *center, const coord_t radiusSquared, const coord_t innerRadiusSquared = 0) {
+    Sphere sphere;
+    std::copy(center, center + nd, sphere.center.begin());
+    sphere.radiusSquared = radiusSquared;
+    sphere.innerRadiusSquared = innerRadiusSquared;
+    m_spheres.emplace_back(sphere);
+    return m_spheres.size() - 1;
+  }
+
+  /// @return the number of spheres added
+  size_t size() const { return m_spheres.size(); }
+
+  /**
+   * Accumulate the events of the tree below root into all the spheres
+   * @param root :: the top box of the workspace
+   * @param parallel :: process the children of the top box in parallel
+   */
+  void run(BoxBase *root, const bool parallel = true) {
+    m_results.assign(m_spheres.size(), Result());
+    if (m_spheres.empty() || !root)
+      return;
+
+    std::vector<size_t> all(m_spheres.size());
+    for (size_t i = 0; i < all.size(); ++i)
+      all[i] = i;
+
+    if (root->isLeaf()) {
+      processLeaf(root, all, m_results);
+      return;
+    }
+    // Bucket the spheres by the children of the top box they overlap, then
+    // select and process the subtrees independently, each thread accumulating
+    // into its own results
+    std::vector<std::vector<size_t>> buckets;
+    const bool bucketed = bucketSpheres(root, buckets);
+
+    const int nChildren = static_cast<int>(root->getNumChildren());
+    std::vector<std::vector<Result>> threadResults(parallel ? PARALLEL_GET_MAX_THREADS : 1);
+    std::exception_ptr error;
+    PARALLEL_FOR_IF(parallel)
+    for (int i = 0; i < nChildren; ++i) {
+      try {
+        auto &results = threadResults[PARALLEL_THREAD_NUMBER];
+        if (results.empty())
+          results.resize(m_spheres.size());
+        const auto &candidates = bucketed ? buckets[i] : all;
+        if (candidates.empty())
+          continue;
+        auto child = static_cast<BoxBase *>(root->getChild(i));
+        std::vector<size_t> selected;
+        selectSpheres(child, candidates, results, selected);
+        if (!selected.empty())
+          processBox(child, selected, results);
+      } catch (...) {
+        PARALLEL_CRITICAL(BatchSphereIntegrator_run)
+        if (!error)
+          error = std::current_exception();
+      }
+    }
+    if (error)
+      std::rethrow_exception(error);
+    for (const auto &results : threadResults) {
+      if (results.empty())
+        continue;
+      for (size_t i = 0; i < m_results.size(); ++i) {
+        m_results[i].signal += results[i].signal;
+        m_results[i].errorSquared += results[i].errorSquared;
+        for (size_t d = 0; d < nd; ++d)
+          m_results[i].centroid[d] += results[i].centroid[d];
+      }
+    }
+  }
+
+  /// @return the result of the sphere with the given index; valid after run()
+  const Result &result(const size_t index) const { return m_results[index]; }
+
+private:
+  struct Sphere {
+    std::array<coord_t, nd> center;
+    coord_t radiusSquared;
+    coord_t innerRadiusSquared;
+  };
+
+  /// squared distance from the centre of a sphere to a point
+  static coord_t distanceSquared(const Sphere &sphere, const coord_t *point) {
+    coord_t sum(0);
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t diff = point[d] - sphere.center[d];
+      sum += diff * diff;
+    }
+    return sum;
+  }
+
+  /// whether a point at the given squared distance from the centre lies in a sphere (or shell)
+  static bool contains(const Sphere &sphere, const coord_t distSq) {
+    return distSq < sphere.radiusSquared && (sphere.innerRadiusSquared == 0 || distSq > sphere.innerRadiusSquared);
+  }
+
+  /// Process a box and its subtree for the given spheres
+  void processBox(BoxBase *box, const std::vector<size_t> &spheres, std::vector<Result> &results) const {
+    if (box->isLeaf()) {
+      processLeaf(box, spheres, results);
+      return;
+    }
+    std::vector<std::vector<size_t>> childSpheres;
+    std::vector<BoxBase *> children;
+    selectChildren(box, spheres, results, children, childSpheres);
+    for (size_t i = 0; i < children.size(); ++i)
+      processBox(children[i], childSpheres[i], results);
+  }
+
+  /**
+   * Sort the spheres into buckets, one per child of the top grid box, holding
+   * the spheres whose bounding box overlaps that child. Spheres entirely
+   * outside the workspace are dropped.
+   * @return false if the children do not form a regular grid, in which case
+   * every child must be offered all the spheres
+   */
+  bool bucketSpheres(BoxBase *root, std::vector<std::vector<size_t>> &buckets) const {
+    const size_t nChildren = root->getNumChildren();
+    std::array<double, nd> rootMin, cellSize;
+    std::array<size_t, nd> nCells;
+    size_t nTotal(1);
+    const auto first = root->getChild(0);
+    for (size_t d = 0; d < nd; ++d) {
+      rootMin[d] = static_cast<double>(root->getExtents(d).getMin());
+      cellSize[d] = static_cast<double>(first->getExtents(d).getSize());
+      if (cellSize[d] <= 0)
+        return false;
+      nCells[d] = static_cast<size_t>(std::lround(static_cast<double>(root->getExtents(d).getSize()) / cellSize[d]));
+      nTotal *= nCells[d];
+    }
+    if (nTotal != nChildren)
+      return false;
+
+    // the children are usually ordered with the first dimension fastest, but
+    // map them from their extents rather than rely on it
+    std::vector<size_t> cellToChild(nTotal, nChildren);
+    for (size_t c = 0; c < nChildren; ++c) {
+      const auto child = root->getChild(c);
+      size_t cell(0), stride(1);
+      for (size_t d = 0; d < nd; ++d) {
+        const auto index =
+            std::lround((static_cast<double>(child->getExtents(d).getMin()) - rootMin[d]) / cellSize[d]);
+        if (index < 0 || static_cast<size_t>(index) >= nCells[d])
+          return false;
+        cell += static_cast<size_t>(index) * stride;
+        stride *= nCells[d];
+      }
+      if (cellToChild[cell] != nChildren)
+        return false;
+      cellToChild[cell] = c;
+    }
+
+    buckets.assign(nChildren, std::vector<size_t>());
+    std::array<size_t, nd> low, high, index;
+    for (size_t i = 0; i < m_spheres.size(); ++i) {
+      const auto &sphere = m_spheres[i];
+      const double radius = std::sqrt(static_cast<double>(sphere.radiusSquared));
+      bool outside(false);
+      for (size_t d = 0; d < nd && !outside; ++d) {
+        const double center = static_cast<double>(sphere.center[d]) - rootMin[d];
+        // widened a little so rounding cannot miss a neighbouring child
+        const double lowCell = std::floor((center - radius) / cellSize[d] - 1e-4);
+        const double highCell = std::floor((center + radius) / cellSize[d] + 1e-4);
+        const auto lastCell = static_cast<double>(nCells[d] - 1);
+        outside = highCell < 0 || lowCell > lastCell;
+        low[d] = static_cast<size_t>(std::max(lowCell, 0.0));
+        high[d] = static_cast<size_t>(std::min(highCell, lastCell));
+      }
+      if (outside)
+        continue;
+      // visit every cell of the bounding box, the first dimension fastest
+      index = low;
+      while (true) {
+        size_t cell(0), stride(1);
+        for (size_t d = 0; d < nd; ++d) {
+          cell += index[d] * stride;
+          stride *= nCells[d];
+        }
+        buckets[cellToChild[cell]].emplace_back(i);
+        size_t d(0);
+        for (; d < nd; ++d) {
+          if (index[d] < high[d]) {
+            ++index[d];
+            break;
+          }
+          index[d] = low[d];
+        }
+        if (d == nd)
+          break;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * For each child of a grid box, find the spheres which need its events. The
+   * signal of children entirely inside a sphere is added directly when integrating.
+   */
+  void selectChildren(BoxBase *box, const std::vector<size_t> &spheres, std::vector<Result> &results,
+                      std::vector<BoxBase *> &children, std::vector<std::vector<size_t>> &childSpheres) const {
+    const size_t nChildren = box->getNumChildren();
+    children.reserve(nChildren);
+    childSpheres.reserve(nChildren);
+    std::vector<size_t> selected;
+    for (size_t c = 0; c < nChildren; ++c) {
+      auto child = static_cast<BoxBase *>(box->getChild(c));
+      selectSpheres(child, spheres, results, selected);
+      if (!selected.empty()) {
+        children.emplace_back(child);
+        childSpheres.emplace_back(selected);
+      }
+    }
+  }
+
+  /**
+   * Find which of the given spheres need the events of a box. The signal of a
+   * box entirely inside a sphere is added directly when integrating.
+   */
+  void selectSpheres(BoxBase *child, const std::vector<size_t> &spheres, std::vector<Result> &results,
+                     std::vector<size_t> &selected) const {
+    constexpr size_t maxVertices = size_t(1) << nd;
+    coord_t boxCenter[nd];
+    child->getCenter(boxCenter);
+    coord_t minimum[nd], maximum[nd];
+    double diagonalSquared(0);
+    for (size_t d = 0; d < nd; ++d) {
+      minimum[d] = child->getExtents(d).getMin();
+      maximum[d] = child->getExtents(d).getMax();
+      diagonalSquared += static_cast<double>(child->getExtents(d).getSize() * child->getExtents(d).getSize());
+    }
+    const double boxRadius = std::sqrt(diagonalSquared);
+
+    selected.clear();
+    for (const auto index : spheres) {
+      const auto &sphere = m_spheres[index];
+      if (m_mode == Mode::Centroid) {
+        // the test used by MDGridBox::centroidSphere
+        if (distanceSquared(sphere, boxCenter) < static_cast<coord_t>(diagonalSquared) * 0.72 + sphere.radiusSquared)
+          selected.emplace_back(index);
+        continue;
+      }
+      size_t verticesContained(0);
+      for (size_t vertex = 0; vertex < maxVertices; ++vertex) {
+        coord_t vertexCoord[nd];
+        for (size_t d = 0; d < nd; ++d)
+          vertexCoord[d] = (vertex & (size_t(1) << d)) ? maximum[d] : minimum[d];
+        if (contains(sphere, distanceSquared(sphere, vertexCoord)))
+          ++verticesContained;
+      }
+      if (verticesContained == maxVertices) {
+        // the whole box is inside: use its integrated signal
+        results[index].signal += child->getSignal();
+        results[index].errorSquared += child->getErrorSquared();
+        continue;
+      }
+      if (verticesContained == 0) {
+        const double distance = std::sqrt(static_cast<double>(distanceSquared(sphere, boxCenter)));
+        // box completely isolated from the sphere
+        if (distance - std::sqrt(sphere.radiusSquared) > boxRadius)
+          continue;
+        // box inside the hole of a shell
+        const double innerRadius = std::sqrt(sphere.innerRadiusSquared);
+        if (innerRadius > 0 && distance + boxRadius < innerRadius)
+          continue;
+      }
+      selected.emplace_back(index);
+    }
+  }
+
+  /// Read the events of a leaf box once and add them to all the given spheres
+  void processLeaf(BoxBase *node, const std::vector<size_t> &spheres, std::vector<Result> &results) const {
+    const auto box = dynamic_cast<Box *>(node);
+    if (!box || spheres.empty())
+      return;
+    // If the box is cached to disk, this retrieves it
+    const std::vector<MDE> &events = box->getConstEvents();
+
+    // shells with the background correction need the sorted signals of this box
+    using valAndErrorPair = std::pair<signal_t, signal_t>;
+    const bool integrating = m_mode == Mode::Integrate;
+    std::vector<std::vector<valAndErrorPair>> shellValues(spheres.size());
+
+    for (const auto &event : events) {
+      const coord_t *center = event.getCenter();
+      for (size_t k = 0; k < spheres.size(); ++k) {
+        const auto &sphere = m_spheres[spheres[k]];
+        if (!contains(sphere, distanceSquared(sphere, center)))
+          continue;
+        auto &result = results[spheres[k]];
+        if (!integrating) {
+          const auto eventSignal = static_cast<coord_t>(event.getSignal());
+          result.signal += eventSignal;
+          for (size_t d = 0; d < nd; ++d)
+            result.centroid[d] += center[d] * eventSignal;
+        } else if (sphere.innerRadiusSquared != 0 && m_useOnePercentBackgroundCorrection) {
+          shellValues[k].emplace_back(static_cast<signal_t>(event.getSignal()),
+                                      static_cast<signal_t>(event.getErrorSquared()));
+        } else {
+          result.signal += static_cast<signal_t>(event.getSignal());
+          result.errorSquared += static_cast<signal_t>(event.getErrorSquared());
+        }
+      }
+    }
+
+    for (size_t k = 0; k < spheres.size(); ++k) {
+      auto &vals = shellValues[k];
+      if (vals.empty())
+        continue;
+      std::sort(vals.begin(), vals.end(),
+                [](const valAndErrorPair &a, const valAndErrorPair &b) { return a.first < b.first; });
+      // Remove top 1% of background
+      const auto endIndex = static_cast<size_t>(0.99 * static_cast<double>(vals.size()));
+      auto &result = results[spheres[k]];
+      for (size_t i = 0; i < endIndex; ++i) {
+        result.signal += vals[i].first;
+        result.errorSquared += vals[i].second;
+      }
+    }
+    // it is constant access, so the events can be dropped if necessary
+    if (auto saveable = box->getISaveable())
+      saveable->setBusy(false);
+  }
+
+  const Mode m_mode;
+  const bool m_useOnePercentBackgroundCorrection;
+  std::vector<Sphere> m_spheres;
+  std::vector<Result> m_results;
+};
+
+} // namespace MDAlgorithms
+} // namespace Mantid
@@ -56,6 +56,11 @@ private:
 
   uint64_t loadEventsFromSubBoxes(API::IMDNode *TargetBox);
 
+  /// Memory shared by the read-ahead buffers of all input files
+  static constexpr size_t READ_AHEAD_BUFFER_BYTES = 512 * 1024 * 1024;
+  /// Lower limit on the number of events read at once from an input file
+  static constexpr size_t MIN_READ_AHEAD_EVENTS = 10000;
+
   // the class which flatten the box structure and deal with it
   DataObjects::MDBoxFlatTree m_BoxStruct;
   // the vector of box structures for contributing files components
@@ -37,6 +37,8 @@ public:
    * the dimensions are known.
    */
   void initDimensions() override;
+  /// Evaluate the function on all boxes of an MD domain
+  void function(const API::FunctionDomain &domain, API::FunctionValues &values) const override;
 
 protected:
   /// Calculate the function value at a point r in the MD workspace
@@ -54,12 +56,19 @@ protected:
   void setFormula();
 
 private:
+  /// Evaluate the formula for the first n points in the bulk buffers
+  void evaluateBulk(API::FunctionValues &values, size_t start, size_t n) const;
+
   /// Expression parser
   mu::Parser m_parser;
   ///
   mutable std::vector<double> m_vars;
   std::vector<std::string> m_varNames;
   std::string m_formula;
+  /// Expression parser for evaluating many points at once
+  mutable mu::Parser m_bulkParser;
+  /// Values of m_bulkParser's variables: the dimensions followed by the parameters
+  mutable std::vector<double> m_bulkValues;
 };
 
 } // namespace MDAlgorithms
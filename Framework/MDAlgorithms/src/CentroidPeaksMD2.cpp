@@ -13,6 +13,7 @@
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/System.h"
+#include "MantidMDAlgorithms/BatchSphereIntegrator.h"
 #include "MantidMDAlgorithms/IntegratePeaksMD.h"
 
 namespace Mantid::MDAlgorithms {
@@ -69,80 +70,83 @@ template <typename MDE, size_t nd> void CentroidPeaksMD2::integrate(typename MDE
   /// Radius to use around peaks
   double PeakRadius = getProperty("PeakRadius");
 
-    PRAGMA_OMP(parallel for schedule(dynamic, 10) )
-    for (int i = 0; i < int(peakWS->getNumberPeaks()); ++i) {
-      // Get a direct ref to that peak.
-      IPeak &p = peakWS->getPeak(i);
-      Peak *peak = dynamic_cast<Peak *>(&p);
-      double detectorDistance = 0.;
-      if (peak)
-        detectorDistance = p.getL2();
-
-      // Get the peak center as a position in the dimensions of the workspace
-      V3D pos;
-      if (CoordinatesToUse == 1) //"Q (lab frame)"
-        pos = p.getQLabFrame();
-      else if (CoordinatesToUse == 2) //"Q (sample frame)"
-        pos = p.getQSampleFrame();
-      else if (CoordinatesToUse == 3) //"HKL"
-        pos = p.getHKL();
-
-      // Build the sphere transformation
-      bool dimensionsUsed[nd];
-      coord_t center[nd];
-      for (size_t d = 0; d < nd; ++d) {
-        dimensionsUsed[d] = true; // Use all dimensions
-        center[d] = static_cast<coord_t>(pos[d]);
-      }
-      CoordTransformDistance sphere(nd, center, dimensionsUsed);
-
-      // Initialize the centroid to 0.0
-      signal_t signal = 0;
-      coord_t centroid[nd];
+  // Get the peak centers as positions in the dimensions of the workspace
+  const int nPeaks = peakWS->getNumberPeaks();
+  std::vector<V3D> positions(nPeaks);
+  using SphereIntegrator = BatchSphereIntegrator<MDE, nd>;
+  SphereIntegrator sphereIntegrator(SphereIntegrator::Mode::Centroid);
+  for (int i = 0; i < nPeaks; ++i) {
+    const IPeak &p = peakWS->getPeak(i);
+    if (CoordinatesToUse == 1) //"Q (lab frame)"
+      positions[i] = p.getQLabFrame();
+    else if (CoordinatesToUse == 2) //"Q (sample frame)"
+      positions[i] = p.getQSampleFrame();
+    else if (CoordinatesToUse == 3) //"HKL"
+      positions[i] = p.getHKL();
+
+    coord_t center[nd];
+    for (size_t d = 0; d < nd; ++d)
+      center[d] = static_cast<coord_t>(positions[i][d]);
+    sphereIntegrator.addSphere(center, static_cast<coord_t>(PeakRadius * PeakRadius));
+  }
+
+  // Perform centroid of all the peaks in one pass over the boxes
+  sphereIntegrator.run(ws->getBox(), Kernel::threadSafe(*ws));
+
+  PRAGMA_OMP(parallel for schedule(dynamic, 10) )
+  for (int i = 0; i < nPeaks; ++i) {
+    // Get a direct ref to that peak.
+    IPeak &p = peakWS->getPeak(i);
+    Peak *peak = dynamic_cast<Peak *>(&p);
+    double detectorDistance = 0.;
+    if (peak)
+      detectorDistance = p.getL2();
+
+    const V3D &pos = positions[i];
+    const auto &result = sphereIntegrator.result(i);
+    const signal_t signal = result.signal;
+    coord_t centroid[nd];
+    for (size_t d = 0; d < nd; d++)
+      centroid[d] = result.centroid[d];
+
+    // Normalize by signal
+    if (signal != 0.0) {
       for (size_t d = 0; d < nd; d++)
-        centroid[d] = 0.0;
-
-      // Perform centroid
-      ws->getBox()->centroidSphere(sphere, static_cast<coord_t>(PeakRadius * PeakRadius), centroid, signal);
-
-      // Normalize by signal
-      if (signal != 0.0) {
-        for (size_t d = 0; d < nd; d++)
-          centroid[d] /= static_cast<coord_t>(signal);
-
-        V3D vecCentroid(centroid[0], centroid[1], centroid[2]);
-        p.setBinCount(static_cast<double>(signal));
-
-        // Save it back in the peak object, in the dimension specified.
-        try {
-          if (CoordinatesToUse == 1) //"Q (lab frame)"
-          {
-            p.setQLabFrame(vecCentroid, detectorDistance);
-            if (peak)
-              peak->findDetector();
-          } else if (CoordinatesToUse == 2) //"Q (sample frame)"
-          {
-            p.setQSampleFrame(vecCentroid, detectorDistance);
-            if (peak)
-              peak->findDetector();
-          } else if (CoordinatesToUse == 3) //"HKL"
-          {
-            p.setHKL(vecCentroid);
-          }
-        } catch (std::exception &e) {
-          g_log.warning() << "Error setting Q or HKL\n";
-          g_log.warning() << e.what() << '\n';
+        centroid[d] /= static_cast<coord_t>(signal);
+
+      V3D vecCentroid(centroid[0], centroid[1], centroid[2]);
+      p.setBinCount(static_cast<double>(signal));
+
+      // Save it back in the peak object, in the dimension specified.
+      try {
+        if (CoordinatesToUse == 1) //"Q (lab frame)"
+        {
+          p.setQLabFrame(vecCentroid, detectorDistance);
+          if (peak)
+            peak->findDetector();
+        } else if (CoordinatesToUse == 2) //"Q (sample frame)"
+        {
+          p.setQSampleFrame(vecCentroid, detectorDistance);
+          if (peak)
+            peak->findDetector();
+        } else if (CoordinatesToUse == 3) //"HKL"
+        {
+          p.setHKL(vecCentroid);
         }
-
-        g_log.information() << "Peak " << i << " at " << pos << ": signal " << signal << ", centroid " << vecCentroid
-                            << " in " << CoordinatesToUse << '\n';
-      } else {
-        g_log.information() << "Peak " << i << " at " << pos << " had no signal, and could not be centroided.\n";
+      } catch (std::exception &e) {
+        g_log.warning() << "Error setting Q or HKL\n";
+        g_log.warning() << e.what() << '\n';
       }
+
+      g_log.information() << "Peak " << i << " at " << pos << ": signal " << signal << ", centroid " << vecCentroid
+                          << " in " << CoordinatesToUse << '\n';
+    } else {
+      g_log.information() << "Peak " << i << " at " << pos << " had no signal, and could not be centroided.\n";
     }
+  }
 
-    // Save the output
-    setProperty("OutputWorkspace", peakWS);
+  // Save the output
+  setProperty("OutputWorkspace", peakWS);
 }
 
 //----------------------------------------------------------------------------------------------
@@ -37,11 +37,13 @@
 #include "MantidKernel/System.h"
 #include "MantidKernel/Utils.h"
 #include "MantidKernel/VisibleWhenProperty.h"
+#include "MantidMDAlgorithms/BatchSphereIntegrator.h"
 #include "MantidMDAlgorithms/GSLFunctions.h"
 #include "MantidMDAlgorithms/MDBoxMaskFunction.h"
 
 #include "boost/math/distributions.hpp"
 
+#include <array>
 #include <cmath>
 #include <fstream>
 #include <gsl/gsl_integration.h>
@@ -458,10 +460,69 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
   // volume of PeakRadius sphere
   double volumeRadius = 4.0 / 3.0 * M_PI * std::pow(PeakRadius[0], 3);
 
+  // Get the peak center as a position in the dimensions of the workspace
+  const auto getPeakCenter = [CoordinatesToUse](const IPeak &p) {
+    V3D pos;
+    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
+      pos = p.getQLabFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
+      pos = p.getQSampleFrame();
+    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
+      pos = p.getHKL();
+    return pos;
+  };
+  // Radii of the peak sphere and of the background shell of a peak
+  const auto getSphereRadii = [&](const coord_t *center) {
+    // modulus of Q
+    coord_t lenQpeak = 0.0;
+    if (adaptiveQMultiplier != 0.0) {
+      for (size_t d = 0; d < nd; ++d) {
+        lenQpeak += center[d] * center[d];
+      }
+      lenQpeak = std::sqrt(lenQpeak);
+    }
+    return std::array<double, 3>{
+        adaptiveQMultiplier * lenQpeak + *std::max_element(PeakRadius.begin(), PeakRadius.end()),
+        adaptiveQBackgroundMultiplier * lenQpeak +
+            *std::max_element(BackgroundInnerRadius.begin(), BackgroundInnerRadius.end()),
+        adaptiveQBackgroundMultiplier * lenQpeak +
+            *std::max_element(BackgroundOuterRadius.begin(), BackgroundOuterRadius.end())};
+  };
+
   // Initialize progress reporting
   int nPeaks = peakWS->getNumberPeaks();
   Progress progress(this, 0., 1., nPeaks);
   bool doParallel = cylinderBool ? false : Kernel::threadSafe(*ws, *peakWS);
+
+  // Spheres which are not reshaped into ellipsoids are integrated for all the peaks
+  // together, in a single pass over the box tree, so that the events of boxes shared
+  // by neighbouring peaks are read once.
+  const bool batchSpheres = !cylinderBool && !isEllipse;
+  using SphereIntegrator = BatchSphereIntegrator<MDE, nd>;
+  SphereIntegrator sphereIntegrator(SphereIntegrator::Mode::Integrate, useOnePercentBackgroundCorrection);
+  std::vector<size_t> peakSphereIndex, backgroundSphereIndex;
+  if (batchSpheres) {
+    peakSphereIndex.resize(nPeaks);
+    backgroundSphereIndex.resize(nPeaks);
+    for (int i = 0; i < nPeaks; ++i) {
+      const IPeak &p = peakWS->getPeak(i);
+      if (!integrateEdge &&
+          calculateDistanceToEdge(p.getQLabFrame()) < std::max(BackgroundOuterRadius[0], PeakRadius[0]))
+        continue;
+      const V3D pos = getPeakCenter(p);
+      coord_t center[nd];
+      for (size_t d = 0; d < nd; ++d)
+        center[d] = static_cast<coord_t>(pos[d]);
+      const auto radii = getSphereRadii(center);
+      if (radii[0] <= 0.0)
+        continue;
+      peakSphereIndex[i] = sphereIntegrator.addSphere(center, static_cast<coord_t>(radii[0] * radii[0]));
+      if (BackgroundOuterRadius[0] > PeakRadius[0])
+        backgroundSphereIndex[i] = sphereIntegrator.addSphere(center, static_cast<coord_t>(pow(radii[2], 2)),
+                                                              static_cast<coord_t>(pow(radii[1], 2)));
+    }
+    sphereIntegrator.run(ws->getBox(), doParallel);
+  }
   PARALLEL_FOR_IF(doParallel)
   for (int i = 0; i < nPeaks; ++i) {
     PARALLEL_START_INTERRUPT_REGION
@@ -471,13 +532,7 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
     IPeak &p = peakWS->getPeak(i);
 
     // Get the peak center as a position in the dimensions of the workspace
-    V3D pos;
-    if (CoordinatesToUse == Mantid::Kernel::QLab) //"Q (lab frame)"
-      pos = p.getQLabFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::QSample) //"Q (sample frame)"
-      pos = p.getQSampleFrame();
-    else if (CoordinatesToUse == Mantid::Kernel::HKL) //"HKL"
-      pos = p.getHKL();
+    V3D pos = getPeakCenter(p);
 
     // Do not integrate if sphere is off edge of detector
 
@@ -508,16 +563,8 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
     signal_t bgErrorSquared = 0;
     double background_total = 0.0;
     if (!cylinderBool) {
-      // modulus of Q
-      coord_t lenQpeak = 0.0;
-      if (adaptiveQMultiplier != 0.0) {
-        lenQpeak = 0.0;
-        for (size_t d = 0; d < nd; ++d) {
-          lenQpeak += center[d] * center[d];
-        }
-        lenQpeak = std::sqrt(lenQpeak);
-      }
-      double adaptiveRadius = adaptiveQMultiplier * lenQpeak + *std::max_element(PeakRadius.begin(), PeakRadius.end());
+      const auto radii = getSphereRadii(center);
+      double adaptiveRadius = radii[0];
       if (adaptiveRadius <= 0.0) {
         g_log.error() << "Error: Radius for integration sphere of peak " << i << " is negative =  " << adaptiveRadius
                       << '\n';
@@ -530,10 +577,8 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
         continue;
       }
       PeakRadiusVector[i] = adaptiveRadius;
-      BackgroundInnerRadiusVector[i] = adaptiveQBackgroundMultiplier * lenQpeak +
-                                       *std::max_element(BackgroundInnerRadius.begin(), BackgroundInnerRadius.end());
-      BackgroundOuterRadiusVector[i] = adaptiveQBackgroundMultiplier * lenQpeak +
-                                       *std::max_element(BackgroundOuterRadius.begin(), BackgroundOuterRadius.end());
+      BackgroundInnerRadiusVector[i] = radii[1];
+      BackgroundOuterRadiusVector[i] = radii[2];
       // define the radius squared for a sphere intially
       CoordTransformDistance getRadiusSq(nd, center, dimensionsUsed);
       // set spherical shape
@@ -546,9 +591,15 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
       // Integrate spherical background shell if specified
       if (BackgroundOuterRadius[0] > PeakRadius[0]) {
         // Get the total signal inside background shell
-        ws->getBox()->integrateSphere(
-            getRadiusSq, static_cast<coord_t>(pow(BackgroundOuterRadiusVector[i], 2)), bgSignal, bgErrorSquared,
-            static_cast<coord_t>(pow(BackgroundInnerRadiusVector[i], 2)), useOnePercentBackgroundCorrection);
+        if (batchSpheres) {
+          const auto &background = sphereIntegrator.result(backgroundSphereIndex[i]);
+          bgSignal = background.signal;
+          bgErrorSquared = background.errorSquared;
+        } else {
+          ws->getBox()->integrateSphere(
+              getRadiusSq, static_cast<coord_t>(pow(BackgroundOuterRadiusVector[i], 2)), bgSignal, bgErrorSquared,
+              static_cast<coord_t>(pow(BackgroundInnerRadiusVector[i], 2)), useOnePercentBackgroundCorrection);
+        }
         // correct bg signal by Vpeak/Vshell (same for sphere and ellipse)
         bgSignal *= scaleFactor;
         bgErrorSquared *= scaleFactor * scaleFactor;
@@ -685,9 +736,15 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
           p.setPeakShape(ellipsoidShape);
         }
       }
-      ws->getBox()->integrateSphere(getRadiusSq, static_cast<coord_t>(PeakRadiusVector[i] * PeakRadiusVector[i]),
-                                    signal, errorSquared, 0.0 /* innerRadiusSquared */,
-                                    useOnePercentBackgroundCorrection);
+      if (batchSpheres) {
+        const auto &peakSphere = sphereIntegrator.result(peakSphereIndex[i]);
+        signal = peakSphere.signal;
+        errorSquared = peakSphere.errorSquared;
+      } else {
+        ws->getBox()->integrateSphere(getRadiusSq, static_cast<coord_t>(PeakRadiusVector[i] * PeakRadiusVector[i]),
+                                      signal, errorSquared, 0.0 /* innerRadiusSquared */,
+                                      useOnePercentBackgroundCorrection);
+      }
       //
     } else {
       CoordTransformDistance cylinder(nd, center, dimensionsUsed, 2);
@@ -81,6 +81,12 @@ void MergeMDFiles::loadBoxData() {
   m_fileComponentsStructure.resize(m_Filenames.size());
   m_EventLoader.assign(m_Filenames.size(), nullptr);
 
+  // The events of each input file are stored in the order in which the boxes are
+  // merged, so each file is streamed through a read-ahead buffer instead of being
+  // accessed with one small read per box. The buffers share a fixed memory budget.
+  const size_t readAheadEvents =
+      std::max(size_t(MIN_READ_AHEAD_EVENTS), READ_AHEAD_BUFFER_BYTES / (m_Filenames.size() * m_OutIWS->sizeofEvent()));
+
   try {
     for (size_t i = 0; i < m_Filenames.size(); i++) {
       // load box structure and the experimental info from each target
@@ -109,9 +115,11 @@ void MergeMDFiles::loadBoxData() {
       auto bc = std::shared_ptr<API::BoxController>(new API::BoxController(static_cast<size_t>(m_nDims)));
       bc->fromXMLString(m_fileComponentsStructure[i].getBCXMLdescr());
 
-      m_EventLoader[i] = new BoxControllerNeXusIO(bc.get());
-      m_EventLoader[i]->setDataType(sizeof(coord_t), m_MDEventType);
-      m_EventLoader[i]->openFile(m_Filenames[i], "r");
+      auto loader = new BoxControllerNeXusIO(bc.get());
+      m_EventLoader[i] = loader;
+      loader->setDataType(sizeof(coord_t), m_MDEventType);
+      loader->setReadAheadSize(readAheadEvents);
+      loader->openFile(m_Filenames[i], "r");
     }
   } catch (...) {
     // Close all open files in case of error
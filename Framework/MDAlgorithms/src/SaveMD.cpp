@@ -71,6 +71,11 @@ void SaveMD::init() {
                   "This saves it to a file AND makes the workspace into a "
                   "file-backed one.");
   setPropertySettings("MakeFileBacked", std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+  declareProperty("CompressEvents", false,
+                  "Only for MDEventWorkspaces: compress the event data in the file. "
+                  "The file is smaller, at the cost of slower saving. It remains "
+                  "readable by LoadMD, including with FileBackEnd.");
+  setPropertySettings("CompressEvents", std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -149,8 +154,9 @@ template <typename MDE, size_t nd> void SaveMD::doSaveEvents(typename MDEventWor
     // the boxes file positions are unknown and we need to calculate it.
     BoxFlatStruct.initFlatStructure(ws, filename);
     // create saver class
-    auto Saver = std::shared_ptr<API::IBoxControllerIO>(new DataObjects::BoxControllerNeXusIO(bc.get()));
+    auto Saver = std::make_shared<DataObjects::BoxControllerNeXusIO>(bc.get());
     Saver->setDataType(sizeof(coord_t), MDE::getTypeName());
+    Saver->setCompression(getProperty("CompressEvents"));
     if (makeFileBackend) {
       // store saver with box controller
       bc->setFileBacked(Saver, filename);
@@ -60,6 +60,11 @@ void SaveMD2::init() {
                   "This saves it to a file AND makes the workspace into a "
                   "file-backed one.");
   setPropertySettings("MakeFileBacked", std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
+  declareProperty("CompressEvents", false,
+                  "Only for MDEventWorkspaces: compress the event data in the file. "
+                  "The file is smaller, at the cost of slower saving. It remains "
+                  "readable by LoadMD, including with FileBackEnd.");
+  setPropertySettings("CompressEvents", std::make_unique<EnabledWhenProperty>("UpdateFileBackEnd", IS_EQUAL_TO, "0"));
   declareProperty("SaveHistory", true, "Option to not save the Mantid history in the file. Only for MDHisto");
   declareProperty("SaveInstrument", true, "Option to not save the instrument in the file. Only for MDHisto");
   declareProperty("SaveSample", true, "Option to not save the sample in the file. Only for MDHisto");
@@ -202,6 +207,7 @@ void SaveMD2::exec() {
     saveMDv1->setProperty<std::string>("Filename", getProperty("Filename"));
     saveMDv1->setProperty<bool>("UpdateFileBackEnd", getProperty("UpdateFileBackEnd"));
     saveMDv1->setProperty<bool>("MakeFileBacked", getProperty("MakeFileBacked"));
+    saveMDv1->setProperty<bool>("CompressEvents", getProperty("CompressEvents"));
     saveMDv1->execute();
   } else if (histoWS) {
     this->doSaveHisto(histoWS);
@@ -5,11 +5,9 @@
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidMDAlgorithms/SmoothMD.h"
-#include "MantidAPI/FrameworkManager.h"
 #include "MantidAPI/IMDHistoWorkspace.h"
-#include "MantidAPI/IMDIterator.h"
 #include "MantidAPI/Progress.h"
-#include "MantidDataObjects/MDHistoWorkspaceIterator.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
 #include "MantidKernel/ArrayBoundedValidator.h"
 #include "MantidKernel/ArrayProperty.h"
 #include "MantidKernel/CompositeValidator.h"
@@ -19,6 +17,7 @@
 #include "MantidKernel/PropertyWithValue.h"
 
 #include <algorithm>
+#include <array>
 #include <boost/tuple/tuple.hpp>
 #include <limits>
 #include <map>
@@ -63,6 +62,115 @@ SmoothFunctionMap makeFunctionMap(Mantid::MDAlgorithms::SmoothMD *instance) {
   return {{"Hat", std::bind(&Mantid::MDAlgorithms::SmoothMD::hatSmooth, instance, _1, _2, _3)},
           {"Gaussian", std::bind(&Mantid::MDAlgorithms::SmoothMD::gaussianSmooth, instance, _1, _2, _3)}};
 }
+
+/**
+ * @return the number of bins along each dimension of a workspace
+ */
+std::vector<size_t> binsPerDimension(const IMDHistoWorkspace &ws) {
+  std::vector<size_t> nBins(ws.getNumDims());
+  for (size_t d = 0; d < nBins.size(); ++d)
+    nBins[d] = ws.getDimension(d)->getNBins();
+  return nBins;
+}
+
+/**
+ * Flag the bins which take part in the smoothing. Masked bins and bins where
+ * nothing was measured (zero in the weighting workspace) are ignored, both as
+ * centres and as neighbours.
+ * @param toSmooth : Workspace to smooth
+ * @param weightingWS : Weighting workspace (optional)
+ * @return a flag for each bin
+ */
+std::vector<bool> findValidBins(const IMDHistoWorkspace &toSmooth, const IMDHistoWorkspace_sptr &weightingWS) {
+  const auto nPoints = static_cast<size_t>(toSmooth.getNPoints());
+  std::vector<bool> valid(nPoints, true);
+  if (const auto histo = dynamic_cast<const MDHistoWorkspace *>(&toSmooth)) {
+    const bool *masks = histo->getMaskArray();
+    for (size_t i = 0; i < nPoints; ++i)
+      valid[i] = !masks[i];
+  }
+  if (weightingWS) {
+    for (size_t i = 0; i < nPoints; ++i)
+      valid[i] = valid[i] && weightingWS->getSignalAt(i) != 0;
+  }
+  return valid;
+}
+
+/**
+ * Convolve the values of a workspace-shaped array with a 1D kernel along one
+ * dimension. The kernel is cut off at the edges of the workspace and is not
+ * renormalised there: the caller convolves the validity of the bins in the
+ * same way to obtain the normalisation.
+ * @param values : values of each bin, in the linear order of the workspace
+ * @param nBins : number of bins along each dimension
+ * @param dimension : index of the dimension to convolve along
+ * @param kernel : symmetric kernel with an odd number of elements
+ */
+void convolveAlongDimension(std::vector<double> &values, const std::vector<size_t> &nBins, const size_t dimension,
+                            const KernelVector &kernel) {
+  size_t stride = 1;
+  for (size_t d = 0; d < dimension; ++d)
+    stride *= nBins[d];
+  const size_t length = nBins[dimension];
+  const auto nLines = static_cast<int>(values.size() / length);
+  const auto halfWidth = kernel.size() / 2;
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int line = 0; line < nLines; ++line) { // NOLINT
+    // Index of the first bin of this line of bins along the dimension
+    const size_t start = (line % stride) + (line / stride) * stride * length;
+    std::vector<double> lineValues(length);
+    for (size_t i = 0; i < length; ++i)
+      lineValues[i] = values[start + i * stride];
+    for (size_t i = 0; i < length; ++i) {
+      const size_t low = i > halfWidth ? i - halfWidth : 0;
+      const size_t high = std::min(length, i + halfWidth + 1);
+      double sum = 0;
+      for (size_t j = low; j < high; ++j)
+        sum += lineValues[j] * kernel[j + halfWidth - i];
+      values[start + i * stride] = sum;
+    }
+  }
+}
+
+/**
+ * Smooth the valid bins of a workspace with a separable kernel. The smoothing
+ * is the same as with the full multidimensional kernel, renormalised over the
+ * valid bins it covers.
+ * @param toSmooth : Workspace to smooth
+ * @param valid : flag of the bins to use
+ * @param kernels : 1D kernel for each dimension
+ * @param reportProgress : called after each dimension
+ * @return for each bin, the weighted sums of the signal and of the squared error
+ * and the sum of the weights
+ */
+std::array<std::vector<double>, 3> separableSmooth(const IMDHistoWorkspace &toSmooth, const std::vector<bool> &valid,
+                                                   const std::vector<KernelVector> &kernels,
+                                                   const std::function<void()> &reportProgress) {
+  const auto nBins = binsPerDimension(toSmooth);
+  const size_t nPoints = valid.size();
+  std::vector<double> sumSignal(nPoints, 0.0), sumSqError(nPoints, 0.0), sumWeights(nPoints, 0.0);
+  const signal_t *signal = toSmooth.getSignalArray();
+  const signal_t *errorSquared = toSmooth.getErrorSquaredArray();
+  for (size_t i = 0; i < nPoints; ++i) {
+    if (valid[i]) {
+      sumSignal[i] = signal[i];
+      sumSqError[i] = errorSquared[i];
+      sumWeights[i] = 1.0;
+    }
+  }
+
+  for (size_t dimension = 0; dimension < nBins.size(); ++dimension) {
+    const KernelVector &kernel = kernels[dimension];
+    KernelVector kernelSquared(kernel.size());
+    std::transform(kernel.cbegin(), kernel.cend(), kernelSquared.begin(), [](const double k) { return k * k; });
+    convolveAlongDimension(sumSignal, nBins, dimension, kernel);
+    convolveAlongDimension(sumSqError, nBins, dimension, kernelSquared);
+    convolveAlongDimension(sumWeights, nBins, dimension, kernel);
+    reportProgress();
+  }
+  return {std::move(sumSignal), std::move(sumSqError), std::move(sumWeights)};
+}
 } // namespace
 
 namespace Mantid::MDAlgorithms {
@@ -155,6 +263,9 @@ const std::string SmoothMD::summary() const { return "Smooth an MDHistoWorkspace
 /**
  * Hat function smoothing. All weights even. Hat function boundaries beyond
  * width.
+ * The hat is separable, so the sums over it are carried out as 1D sums along
+ * each dimension in turn: the cost grows with the sum of the widths rather
+ * than their product.
  * @param toSmooth : Workspace to smooth
  * @param widthVector : Width vector
  * @param weightingWS : Weighting workspace (optional)
@@ -162,81 +273,38 @@ const std::string SmoothMD::summary() const { return "Smooth an MDHistoWorkspace
  */
 IMDHistoWorkspace_sptr SmoothMD::hatSmooth(const IMDHistoWorkspace_const_sptr &toSmooth, const WidthVector &widthVector,
                                            const IMDHistoWorkspace_sptr &weightingWS) {
-
-  const bool useWeights = (weightingWS != nullptr);
-  uint64_t nPoints = toSmooth->getNPoints();
-  Progress progress(this, 0.0, 1.0, size_t(double(nPoints) * 1.1));
+  const size_t nd = toSmooth->getNumDims();
+  Progress progress(this, 0.0, 1.0, nd + 1);
   // Create the output workspace.
   IMDHistoWorkspace_sptr outWS(toSmooth->clone());
-  progress.reportIncrement(size_t(double(nPoints) * 0.1)); // Report ~10% progress
-
-  const int nThreads = Mantid::API::FrameworkManager::Instance().getNumOMPThreads(); // NThreads to Request
-
-  auto iterators = toSmooth->createIterators(nThreads, nullptr);
-
-  PARALLEL_FOR_NO_WSP_CHECK()
-  for (int it = 0; it < int(iterators.size()); ++it) { // NOLINT
-
-    PARALLEL_START_INTERRUPT_REGION
-    auto iterator = dynamic_cast<MDHistoWorkspaceIterator *>(iterators[it].get());
-
-    if (!iterator) {
-      throw std::logic_error("Failed to cast IMDIterator to MDHistoWorkspaceIterator");
-    }
-
-    do {
-      // Gets all vertex-touching neighbours
-      size_t iteratorIndex = iterator->getLinearIndex();
-
-      if (useWeights) {
-
-        // Check that we could measure here.
-        if (weightingWS->getSignalAt(iteratorIndex) == 0) {
-
-          outWS->setSignalAt(iteratorIndex, std::numeric_limits<double>::quiet_NaN());
-          outWS->setErrorSquaredAt(iteratorIndex, std::numeric_limits<double>::quiet_NaN());
-
-          continue; // Skip we couldn't measure here.
-        }
-      }
-
-      // Explicitly cast the doubles to int
-      // We've already checked in the validator that the doubles we have are odd
-      // integer values and well below max int
-      std::vector<int> widthVectorInt;
-      widthVectorInt.resize(widthVector.size());
-      std::transform(widthVector.cbegin(), widthVector.cend(), widthVectorInt.begin(),
-                     [](double w) -> int { return static_cast<int>(w); });
-
-      std::vector<size_t> neighbourIndexes = iterator->findNeighbourIndexesByWidth(widthVectorInt);
-
-      size_t nNeighbours = neighbourIndexes.size();
-      double sumSignal = iterator->getSignal();
-      double sumSqError = iterator->getError();
-      for (auto neighbourIndex : neighbourIndexes) {
-        if (useWeights) {
-          if (weightingWS->getSignalAt(neighbourIndex) == 0) {
-            // Nothing measured here. We cannot use that neighbouring point.
-            nNeighbours -= 1;
-            continue;
-          }
-        }
-        sumSignal += toSmooth->getSignalAt(neighbourIndex);
-        double error = toSmooth->getErrorAt(neighbourIndex);
-        sumSqError += (error * error);
-      }
-
+  const auto valid = findValidBins(*toSmooth, weightingWS);
+  progress.report();
+
+  // We've already checked in the validator that the widths are odd integers
+  std::vector<KernelVector> hats;
+  hats.reserve(nd);
+  std::transform(widthVector.cbegin(), widthVector.cbegin() + nd, std::back_inserter(hats),
+                 [](const double width) { return KernelVector(static_cast<size_t>(width), 1.0); });
+
+  const auto sums = separableSmooth(*toSmooth, valid, hats, [&progress]() { progress.report(); });
+  const auto &sumSignal = sums[0];
+  const auto &sumSqError = sums[1];
+  const auto &nNeighbours = sums[2];
+
+  signal_t *outSignal = outWS->mutableSignalArray();
+  signal_t *outErrorSquared = outWS->mutableErrorSquaredArray();
+  for (size_t i = 0; i < valid.size(); ++i) {
+    if (valid[i]) {
       // Calculate the mean
-      outWS->setSignalAt(iteratorIndex, sumSignal / double(nNeighbours + 1));
+      outSignal[i] = sumSignal[i] / nNeighbours[i];
       // Calculate the sample variance
-      outWS->setErrorSquaredAt(iteratorIndex, sumSqError / double(nNeighbours + 1));
-
-      progress.report();
-
-    } while (iterator->next());
-    PARALLEL_END_INTERRUPT_REGION
+      outErrorSquared[i] = sumSqError[i] / nNeighbours[i];
+    } else if (weightingWS && weightingWS->getSignalAt(i) == 0) {
+      // We couldn't measure here.
+      outSignal[i] = std::numeric_limits<double>::quiet_NaN();
+      outErrorSquared[i] = std::numeric_limits<double>::quiet_NaN();
+    }
   }
-  PARALLEL_CHECK_INTERRUPT_REGION
 
   return outWS;
 }
@@ -255,94 +323,39 @@ IMDHistoWorkspace_sptr SmoothMD::hatSmooth(const IMDHistoWorkspace_const_sptr &t
 IMDHistoWorkspace_sptr SmoothMD::gaussianSmooth(const IMDHistoWorkspace_const_sptr &toSmooth,
                                                 const WidthVector &widthVector,
                                                 const IMDHistoWorkspace_sptr &weightingWS) {
-  const bool useWeights = weightingWS.get() != 0;
-  uint64_t nPoints = toSmooth->getNPoints();
-  Progress progress(this, 0.0, 1.0, size_t(double(nPoints) * 1.1));
+  const size_t nd = toSmooth->getNumDims();
+  Progress progress(this, 0.0, 1.0, nd + 1);
   // Create the output workspace
   IMDHistoWorkspace_sptr outWS(toSmooth->clone().release());
-  // Create a temporary workspace
-  IMDHistoWorkspace_sptr tempWS(toSmooth->clone().release());
-  // Report ~10% progress
-  progress.reportIncrement(size_t(double(nPoints) * 0.1));
+  const auto valid = findValidBins(*toSmooth, weightingWS);
+  progress.report();
 
   // Create a kernel for each dimension and
   std::vector<KernelVector> gaussian_kernels;
-  gaussian_kernels.reserve(widthVector.size());
-  std::transform(widthVector.cbegin(), widthVector.cend(), std::back_inserter(gaussian_kernels),
+  gaussian_kernels.reserve(nd);
+  std::transform(widthVector.cbegin(), widthVector.cbegin() + nd, std::back_inserter(gaussian_kernels),
                  [](const auto width) { return gaussianKernel(width); });
 
-  const int nThreads = Mantid::API::FrameworkManager::Instance().getNumOMPThreads(); // NThreads to Request
-
-  auto write_ws = tempWS;
-  for (size_t dimension_number = 0; dimension_number < widthVector.size(); ++dimension_number) {
-
-    auto iterators = toSmooth->createIterators(nThreads, nullptr);
-
-    // Alternately write to each workspace
-    IMDHistoWorkspace_sptr read_ws;
-    if (dimension_number % 2 == 0) {
-      read_ws = outWS;
-      write_ws = tempWS;
-    } else {
-      read_ws = tempWS;
-      write_ws = outWS;
+  const auto sums = separableSmooth(*toSmooth, valid, gaussian_kernels, [&progress]() { progress.report(); });
+  const auto &sumSignal = sums[0];
+  const auto &sumSqError = sums[1];
+  const auto &sumKernel = sums[2];
+
+  signal_t *outSignal = outWS->mutableSignalArray();
+  signal_t *outErrorSquared = outWS->mutableErrorSquaredArray();
+  for (size_t i = 0; i < valid.size(); ++i) {
+    if (valid[i]) {
+      // Renormalise the kernel over the valid bins it covers
+      outSignal[i] = sumSignal[i] / sumKernel[i];
+      outErrorSquared[i] = sumSqError[i] / (sumKernel[i] * sumKernel[i]);
+    } else if (weightingWS && weightingWS->getSignalAt(i) == 0) {
+      // We couldn't measure here.
+      outSignal[i] = std::numeric_limits<double>::quiet_NaN();
+      outErrorSquared[i] = std::numeric_limits<double>::quiet_NaN();
     }
-
-    PARALLEL_FOR_NO_WSP_CHECK()
-    for (int it = 0; it < int(iterators.size()); ++it) { // NOLINT
-
-      PARALLEL_START_INTERRUPT_REGION
-      auto iterator = dynamic_cast<MDHistoWorkspaceIterator *>(iterators[it].get());
-      if (!iterator) {
-        throw std::logic_error("Failed to cast IMDIterator to MDHistoWorkspaceIterator");
-      }
-
-      do {
-
-        // Gets linear index at current position
-        size_t iteratorIndex = iterator->getLinearIndex();
-
-        if (useWeights) {
-
-          // Check that we could measure here.
-          if (weightingWS->getSignalAt(iteratorIndex) == 0) {
-
-            write_ws->setSignalAt(iteratorIndex, std::numeric_limits<double>::quiet_NaN());
-            write_ws->setErrorSquaredAt(iteratorIndex, std::numeric_limits<double>::quiet_NaN());
-
-            continue; // Skip we couldn't measure here.
-          }
-        }
-
-        std::pair<std::vector<size_t>, std::vector<bool>> indexesAndValidity = iterator->findNeighbourIndexesByWidth1D(
-            static_cast<int>(gaussian_kernels[dimension_number].size()), static_cast<int>(dimension_number));
-        std::vector<size_t> neighbourIndexes = std::get<0>(indexesAndValidity);
-        std::vector<bool> indexValidity = std::get<1>(indexesAndValidity);
-        auto normalised_kernel = renormaliseKernel(gaussian_kernels[dimension_number], indexValidity);
-
-        // Convolve signal with kernel
-        double sumSignal = 0;
-        double sumSquareError = 0;
-        double error = 0;
-        for (size_t i = 0; i < neighbourIndexes.size(); ++i) {
-          if (indexValidity[i]) {
-            sumSignal += read_ws->getSignalAt(neighbourIndexes[i]) * normalised_kernel[i];
-            error = read_ws->getErrorAt(neighbourIndexes[i]) * normalised_kernel[i];
-            sumSquareError += error * error;
-          }
-
-          write_ws->setSignalAt(iteratorIndex, sumSignal);
-          write_ws->setErrorSquaredAt(iteratorIndex, sumSquareError);
-        }
-        progress.report();
-
-      } while (iterator->next());
-      PARALLEL_END_INTERRUPT_REGION
-    }
-    PARALLEL_CHECK_INTERRUPT_REGION
   }
 
-  return write_ws;
+  return outWS;
 }
 
 //----------------------------------------------------------------------------------------------
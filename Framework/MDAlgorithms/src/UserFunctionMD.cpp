@@ -8,13 +8,22 @@
 // Includes
 //----------------------------------------------------------------------
 #include "MantidMDAlgorithms/UserFunctionMD.h"
+#include "MantidAPI/FunctionDomainMD.h"
 #include "MantidAPI/FunctionFactory.h"
+#include "MantidAPI/FunctionValues.h"
 #include "MantidKernel/MultiThreaded.h"
 
 #include <boost/tokenizer.hpp>
 
+#include <algorithm>
+
 namespace Mantid::MDAlgorithms {
 
+namespace {
+/// Maximum number of points evaluated by one call to muParser in bulk mode
+constexpr size_t BULK_SIZE = 1024;
+} // namespace
+
 // Subscribe the function into the factory.
 DECLARE_FUNCTION(UserFunctionMD)
 
@@ -97,6 +106,75 @@ double UserFunctionMD::functionMD(const API::IMDIterator &r) const {
   }
   return val;
 }
+
+/**
+ * Evaluate the function on all boxes of an MD domain. The box centres are
+ * collected into blocks that muParser evaluates in bulk mode.
+ * @param domain :: An MD domain.
+ * @param values :: The computed values.
+ */
+void UserFunctionMD::function(const API::FunctionDomain &domain, API::FunctionValues &values) const {
+  const auto *dmd = dynamic_cast<const API::FunctionDomainMD *>(&domain);
+  if (!dmd) {
+    throw std::invalid_argument("Unexpected domain in UserFunctionMD");
+  }
+  if (m_bulkValues.empty()) {
+    // The formula hasn't been set up yet
+    IFunctionMD::function(domain, values);
+    return;
+  }
+
+  // The bulk buffers are shared, so filling them and evaluating the formula
+  // must not interleave with another call
+  std::string error;
+  PARALLEL_CRITICAL(function) {
+    try {
+      // The parameters are the same for all points
+      const size_t nVars = m_vars.size();
+      for (size_t i = 0; i < nParams(); ++i) {
+        auto parameterValues = m_bulkValues.begin() + (nVars + i) * BULK_SIZE;
+        std::fill(parameterValues, parameterValues + BULK_SIZE, getParameter(i));
+      }
+
+      const size_t nDims = std::min(m_dimensions.size(), nVars);
+      size_t start = 0;
+      size_t n = 0;
+      dmd->reset();
+      for (const API::IMDIterator *r = dmd->getNextIterator(); r != nullptr; r = dmd->getNextIterator()) {
+        this->reportProgress("Evaluating function for box " + std::to_string(start + n + 1));
+        Kernel::VMD center = r->getCenter();
+        for (size_t i = 0; i < nDims; ++i) {
+          m_bulkValues[i * BULK_SIZE + n] = center[i];
+        }
+        if (++n == BULK_SIZE) {
+          evaluateBulk(values, start, n);
+          start += n;
+          n = 0;
+        }
+      }
+      if (n > 0) {
+        evaluateBulk(values, start, n);
+      }
+    } catch (mu::Parser::exception_type &e) {
+      error = "Failed to evaluate formula " + e.GetExpr() + ": " + e.GetMsg();
+    }
+  }
+  if (!error.empty()) {
+    throw std::runtime_error(error);
+  }
+}
+
+/**
+ * Evaluate the formula for the first n points in the bulk buffers. The
+ * caller must hold the function critical section.
+ * @param values :: The computed values.
+ * @param start :: Index in values of the first point.
+ * @param n :: Number of points to evaluate.
+ */
+void UserFunctionMD::evaluateBulk(API::FunctionValues &values, size_t start, size_t n) const {
+  m_bulkParser.Eval(values.getPointerToCalculated(start), static_cast<int>(n));
+}
+
 /** Static callback function used by MuParser to initialize variables implicitly
 @param varName :: The name of a new variable
 @param pufun :: Pointer to the function
@@ -145,6 +223,17 @@ void UserFunctionMD::setFormula() {
   }
 
   m_parser.SetExpr(m_formula);
+
+  // In bulk mode muParser reads each variable from an array of BULK_SIZE values
+  m_bulkValues.assign((m_vars.size() + nParams()) * BULK_SIZE, 0.0);
+  m_bulkParser.ClearVar();
+  for (size_t i = 0; i < m_vars.size(); ++i) {
+    m_bulkParser.DefineVar(m_varNames[i], &m_bulkValues[i * BULK_SIZE]);
+  }
+  for (size_t i = 0; i < nParams(); i++) {
+    m_bulkParser.DefineVar(parameterName(i), &m_bulkValues[(m_vars.size() + i) * BULK_SIZE]);
+  }
+  m_bulkParser.SetExpr(m_formula);
 }
 
 } // namespace Mantid::MDAlgorithms
@@ -0,0 +1,180 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2024 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidDataObjects/CoordTransformDistance.h"
+#include "MantidDataObjects/MDEventFactory.h"
+#include "MantidFrameworkTestHelpers/MDEventsTestHelper.h"
+#include "MantidMDAlgorithms/BatchSphereIntegrator.h"
+
+#include <cxxtest/TestSuite.h>
+
+using namespace Mantid;
+using namespace Mantid::DataObjects;
+using Mantid::MDAlgorithms::BatchSphereIntegrator;
+
+class BatchSphereIntegratorTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static BatchSphereIntegratorTest *createSuite() { return new BatchSphereIntegratorTest(); }
+  static void destroySuite(BatchSphereIntegratorTest *suite) { delete suite; }
+
+  BatchSphereIntegratorTest() {
+    m_ws = MDEventsTestHelper::makeFakeMDEventWorkspace("BatchSphereIntegratorTest_ws", 50000);
+    // overlapping spheres, spheres containing whole boxes, spheres off the edge of the workspace
+    m_centers = {{5.0f, 5.0f, 5.0f}, {5.3f, 5.1f, 4.9f}, {1.0f, 1.0f, 1.0f},
+                 {0.0f, 5.0f, 5.0f}, {9.9f, 9.9f, 0.1f}, {-3.0f, 5.0f, 5.0f}};
+    m_radii = {0.3f, 1.0f, 2.5f};
+  }
+
+  ~BatchSphereIntegratorTest() override { AnalysisDataService::Instance().remove("BatchSphereIntegratorTest_ws"); }
+
+  void test_no_spheres() {
+    BatchSphereIntegrator<MDLeanEvent<3>, 3> integrator;
+    TS_ASSERT_EQUALS(integrator.size(), 0);
+    TS_ASSERT_THROWS_NOTHING(integrator.run(m_ws->getBox()));
+  }
+
+  void test_integrate_spheres_matches_integrateSphere() { do_test_integrate(false, true); }
+
+  void test_integrate_spheres_matches_integrateSphere_serial() { do_test_integrate(false, false); }
+
+  void test_integrate_shells_matches_integrateSphere() { do_test_integrate(true, true); }
+
+  void test_integrate_shells_without_background_correction() { do_test_integrate(true, true, false); }
+
+  void test_event_at_the_centre_is_included() {
+    // one event of signal 1 at the centre of each of the 10x10x10 boxes
+    auto ws = MDEventsTestHelper::makeMDEW<3>(10, 0.0, 10.0, 1);
+    const coord_t center[3] = {2.5f, 3.5f, 4.5f};
+    using Integrator = BatchSphereIntegrator<MDLeanEvent<3>, 3>;
+    for (const auto mode : {Integrator::Mode::Integrate, Integrator::Mode::Centroid}) {
+      Integrator integrator(mode);
+      const auto index = integrator.addSphere(center, 0.09f);
+      integrator.run(ws->getBox());
+      TS_ASSERT_DELTA(integrator.result(index).signal, 1.0, 1e-6);
+    }
+
+    CoordTransformDistance sphere(3, center, m_dimensionsUsed);
+    signal_t signal(0), errorSquared(0);
+    ws->getBox()->integrateSphere(sphere, 0.09f, signal, errorSquared);
+    TS_ASSERT_DELTA(signal, 1.0, 1e-6);
+  }
+
+  void test_centroid_matches_centroidSphere() {
+    using Integrator = BatchSphereIntegrator<MDLeanEvent<3>, 3>;
+    Integrator integrator(Integrator::Mode::Centroid);
+    std::vector<size_t> indices;
+    for (const auto &center : m_centers)
+      for (const auto radius : m_radii)
+        indices.emplace_back(integrator.addSphere(center.data(), radius * radius));
+    integrator.run(m_ws->getBox());
+
+    size_t i(0);
+    for (auto center : m_centers) {
+      for (const auto radius : m_radii) {
+        CoordTransformDistance sphere(3, center.data(), m_dimensionsUsed);
+        signal_t signal(0);
+        coord_t centroid[3] = {0, 0, 0};
+        m_ws->getBox()->centroidSphere(sphere, radius * radius, centroid, signal);
+
+        const auto &result = integrator.result(indices[i++]);
+        TS_ASSERT_DELTA(result.signal, signal, 1e-3);
+        for (size_t d = 0; d < 3; ++d)
+          TS_ASSERT_DELTA(result.centroid[d], centroid[d], 1e-2);
+      }
+    }
+  }
+
+private:
+  void do_test_integrate(const bool shells, const bool parallel, const bool backgroundCorrection = true) {
+    using Integrator = BatchSphereIntegrator<MDLeanEvent<3>, 3>;
+    Integrator integrator(Integrator::Mode::Integrate, backgroundCorrection);
+    std::vector<size_t> indices;
+    for (const auto &center : m_centers) {
+      for (const auto radius : m_radii) {
+        const coord_t innerRadiusSq = shells ? 0.25f * radius * radius : 0.f;
+        indices.emplace_back(integrator.addSphere(center.data(), radius * radius, innerRadiusSq));
+      }
+    }
+    TS_ASSERT_EQUALS(integrator.size(), m_centers.size() * m_radii.size());
+    integrator.run(m_ws->getBox(), parallel);
+
+    size_t i(0);
+    for (auto center : m_centers) {
+      for (const auto radius : m_radii) {
+        const coord_t innerRadiusSq = shells ? 0.25f * radius * radius : 0.f;
+        CoordTransformDistance sphere(3, center.data(), m_dimensionsUsed);
+        signal_t signal(0), errorSquared(0);
+        m_ws->getBox()->integrateSphere(sphere, radius * radius, signal, errorSquared, innerRadiusSq,
+                                        backgroundCorrection);
+
+        const auto &result = integrator.result(indices[i++]);
+        TS_ASSERT_DELTA(result.signal, signal, 1e-6);
+        TS_ASSERT_DELTA(result.errorSquared, errorSquared, 1e-6);
+      }
+    }
+  }
+
+  MDEventWorkspace3Lean::sptr m_ws;
+  std::vector<std::array<coord_t, 3>> m_centers;
+  std::vector<coord_t> m_radii;
+  bool m_dimensionsUsed[3] = {true, true, true};
+};
+
+class BatchSphereIntegratorTestPerformance : public CxxTest::TestSuite {
+public:
+  static BatchSphereIntegratorTestPerformance *createSuite() { return new BatchSphereIntegratorTestPerformance(); }
+  static void destroySuite(BatchSphereIntegratorTestPerformance *suite) { delete suite; }
+
+  BatchSphereIntegratorTestPerformance() {
+    m_ws = MDEventsTestHelper::makeFakeMDEventWorkspace("BatchSphereIntegratorTestPerformance_ws", 2000000);
+  }
+
+  ~BatchSphereIntegratorTestPerformance() override {
+    AnalysisDataService::Instance().remove("BatchSphereIntegratorTestPerformance_ws");
+  }
+
+  void test_integrate_many_neighbouring_spheres() {
+    using Integrator = BatchSphereIntegrator<MDLeanEvent<3>, 3>;
+    Integrator integrator;
+    // a dense lattice of peaks, as for satellite peaks
+    for (int i = 0; i < 40; ++i)
+      for (int j = 0; j < 40; ++j)
+        for (int k = 0; k < 40; ++k) {
+          const coord_t center[3] = {0.25f * static_cast<coord_t>(i), 0.25f * static_cast<coord_t>(j),
+                                     0.25f * static_cast<coord_t>(k)};
+          integrator.addSphere(center, 0.04f, 0.f);
+        }
+    integrator.run(m_ws->getBox());
+    TS_ASSERT_EQUALS(integrator.size(), 64000);
+  }
+
+  void test_integrate_many_spheres_spread_over_the_workspace() { do_test_spread_spheres(true); }
+
+  void test_integrate_many_spheres_spread_over_the_workspace_serial() { do_test_spread_spheres(false); }
+
+private:
+  /// small spheres over the whole workspace, each overlapping only a few of the top boxes
+  void do_test_spread_spheres(const bool parallel) {
+    using Integrator = BatchSphereIntegrator<MDLeanEvent<3>, 3>;
+    Integrator integrator;
+    for (int i = 0; i < 50; ++i)
+      for (int j = 0; j < 50; ++j)
+        for (int k = 0; k < 50; ++k) {
+          const coord_t center[3] = {0.2f * static_cast<coord_t>(i) + 0.05f, 0.2f * static_cast<coord_t>(j) + 0.05f,
+                                     0.2f * static_cast<coord_t>(k) + 0.05f};
+          integrator.addSphere(center, 0.01f, 0.f);
+        }
+    integrator.run(m_ws->getBox(), parallel);
+    TS_ASSERT_EQUALS(integrator.size(), 125000);
+  }
+
+  MDEventWorkspace3Lean::sptr m_ws;
+};
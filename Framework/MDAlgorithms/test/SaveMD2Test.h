@@ -308,6 +308,54 @@ public:
     }
   }
 
+  void test_saveCompressedEvents_loads_file_backed() {
+    const std::string wsName("SaveMD2Test_compressedWS");
+    auto ws = MDEventsTestHelper::makeAnyMDEW<MDEvent<3>, 3>(10, 0., 10., 2, wsName);
+
+    const std::string saveFilename = "SaveMD2Test_compressed.nxs";
+    SaveMD2 saveAlg;
+    TS_ASSERT_THROWS_NOTHING(saveAlg.initialize())
+    TS_ASSERT_THROWS_NOTHING(saveAlg.setPropertyValue("InputWorkspace", wsName));
+    TS_ASSERT_THROWS_NOTHING(saveAlg.setPropertyValue("Filename", saveFilename));
+    TS_ASSERT_THROWS_NOTHING(saveAlg.setProperty("CompressEvents", true));
+    saveAlg.execute();
+    TS_ASSERT(saveAlg.isExecuted());
+
+    const std::string loadedWSName("SaveMD2Test_compressedLoadedWS");
+    LoadMD loadAlg;
+    TS_ASSERT_THROWS_NOTHING(loadAlg.initialize())
+    TS_ASSERT_THROWS_NOTHING(loadAlg.setPropertyValue("Filename", saveFilename));
+    TS_ASSERT_THROWS_NOTHING(loadAlg.setProperty("FileBackEnd", true));
+    TS_ASSERT_THROWS_NOTHING(loadAlg.setPropertyValue("OutputWorkspace", loadedWSName));
+    TS_ASSERT_THROWS_NOTHING(loadAlg.execute(););
+    TS_ASSERT(loadAlg.isExecuted());
+
+    IMDEventWorkspace_sptr iws;
+    TS_ASSERT_THROWS_NOTHING(iws = AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(loadedWSName));
+    TS_ASSERT(iws);
+    if (!iws)
+      return;
+    TS_ASSERT(iws->isFileBacked());
+    TS_ASSERT_EQUALS(iws->getNPoints(), ws->getNPoints());
+
+    // Pulling the events into memory reads every box back through the compressed dataset
+    auto loaded = std::dynamic_pointer_cast<MDEventWorkspace3>(iws);
+    TS_ASSERT(loaded);
+    if (!loaded)
+      return;
+    loaded->clearFileBacked(true);
+    loaded->refreshCache();
+    TS_ASSERT_EQUALS(loaded->getNPoints(), ws->getNPoints());
+    TS_ASSERT_DELTA(loaded->getBox()->getSignal(), ws->getBox()->getSignal(), 1e-6);
+
+    AnalysisDataService::Instance().remove(loadedWSName);
+    AnalysisDataService::Instance().remove(wsName);
+    const std::string this_filename = saveAlg.getProperty("Filename");
+    if (Poco::File(this_filename).exists()) {
+      Poco::File(this_filename).remove();
+    }
+  }
+
   /** Run SaveMD with the MDHistoWorkspace */
   void doTestHisto(const MDHistoWorkspace_sptr &ws) {
     std::string filename = "SaveMD2TestHisto.nxs";
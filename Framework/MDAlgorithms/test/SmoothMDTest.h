@@ -361,6 +361,58 @@ public:
     TSM_ASSERT("Last index should have a smoothed Value of NaN", std::isnan(out->getSignalAt(9)));
   }
 
+  void test_smooth_gaussian_with_normalization_guidance() {
+    const size_t nd = 1;
+    MDHistoWorkspace_sptr toSmooth = MDEventsTestHelper::makeFakeMDHistoWorkspace(2.0 /*signal value*/, nd, 10);
+    toSmooth->setSignalAt(9, 100.0);
+
+    MDHistoWorkspace_sptr normWs = MDEventsTestHelper::makeFakeMDHistoWorkspace(1.0 /*signal value*/, nd, 10);
+    normWs->setSignalAt(9, 0);
+
+    SmoothMD alg;
+    alg.setChild(true);
+    alg.initialize();
+    WidthVector widthVector(1, 3);
+    alg.setProperty("WidthVector", widthVector);
+    alg.setProperty("InputWorkspace", toSmooth);
+    alg.setProperty("InputNormalizationWorkspace", normWs);
+    alg.setProperty("Function", "Gaussian");
+    alg.setPropertyValue("OutputWorkspace", "dummy");
+    alg.execute();
+    IMDHistoWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+
+    for (size_t i = 0; i < 9; ++i) {
+      TSM_ASSERT_DELTA("Unmeasured bin should be ignored by its neighbours", out->getSignalAt(i), 2.0, 1e-10);
+    }
+    TSM_ASSERT("Last index should have a smoothed Value of NaN", std::isnan(out->getSignalAt(9)));
+  }
+
+  void test_masked_bins_are_ignored() {
+    MDHistoWorkspace_sptr toSmooth = MDEventsTestHelper::makeFakeMDHistoWorkspace(2.0 /*signal*/, 2, 5);
+    toSmooth->setMDMaskAt(12, true);
+
+    for (const std::string function : {"Hat", "Gaussian"}) {
+      SmoothMD alg;
+      alg.setChild(true);
+      alg.initialize();
+      WidthVector widthVector(1, 3);
+      alg.setProperty("WidthVector", widthVector);
+      alg.setProperty("InputWorkspace", toSmooth);
+      alg.setProperty("Function", function);
+      alg.setPropertyValue("OutputWorkspace", "dummy");
+      alg.execute();
+      IMDHistoWorkspace_sptr out = alg.getProperty("OutputWorkspace");
+
+      for (size_t i = 0; i < out->getNPoints(); ++i) {
+        if (i == 12) {
+          TSM_ASSERT("Masked bin should keep its masked value", std::isnan(out->getSignalAt(i)));
+        } else {
+          TSM_ASSERT_DELTA("Masked bin should be ignored by its neighbours", out->getSignalAt(i), 2.0, 1e-10);
+        }
+      }
+    }
+  }
+
   void test_gaussian_kernel_sigma_1() {
     // FWHM of 2.355 equivalent to sigma=1
     const std::vector<double> kernel = Mantid::MDAlgorithms::gaussianKernel(2.355);
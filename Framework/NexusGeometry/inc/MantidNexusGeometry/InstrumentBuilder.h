@@ -14,6 +14,7 @@
 #include <Eigen/Geometry>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Mantid {
 namespace Geometry {
@@ -44,6 +45,10 @@ public:
   /// Adds detector to the last registered bank
   void addDetectorToLastBank(const std::string &detName, detid_t detId, const Eigen::Vector3d &relativeOffset,
                              std::shared_ptr<const Mantid::Geometry::IObject> shape);
+  /// Adds detectors sharing a shape to the last registered bank
+  void addDetectorsToLastBank(const std::string &bankName, const std::vector<detid_t> &detIds,
+                              const Eigen::Matrix<double, 3, Eigen::Dynamic> &relativeOffsets,
+                              const std::shared_ptr<const Mantid::Geometry::IObject> &shape);
   /// Adds detector to instrument
   void addMonitor(const std::string &detName, detid_t detId, const Eigen::Vector3d &position,
                   std::shared_ptr<const Mantid::Geometry::IObject> &shape);
@@ -94,6 +94,37 @@ void InstrumentBuilder::addDetectorToLastBank(const std::string &detName, detid_
   m_instrument->markAsDetectorIncomplete(detector);
 }
 
+/** Add the pixels of a bank, which all have the same shape, to the last
+registered bank in one go
+@param bankName Bank name, the detectors are named bankName_i
+@param detIds Detector IDs of the pixels
+@param relativeOffsets Offsets of the pixels from the bank, one column per
+pixel
+@param shape Shape of each pixel
+*/
+void InstrumentBuilder::addDetectorsToLastBank(const std::string &bankName, const std::vector<detid_t> &detIds,
+                                               const Eigen::Matrix<double, 3, Eigen::Dynamic> &relativeOffsets,
+                                               const std::shared_ptr<const Geometry::IObject> &shape) {
+  if (!m_lastBank)
+    throw std::runtime_error("No bank to add the detectors to");
+  if (static_cast<size_t>(relativeOffsets.cols()) < detIds.size())
+    throw std::runtime_error("Fewer pixel offsets than detectors in bank " + bankName);
+  auto *parent = const_cast<Geometry::IComponent *>(m_lastBank->getBaseComponent());
+  // Reuse the name buffer rather than building each name from scratch
+  std::string name = bankName + "_";
+  const auto prefixLength = name.size();
+  for (size_t i = 0; i < detIds.size(); ++i) {
+    name.resize(prefixLength);
+    name += std::to_string(i);
+    auto *detector = new Geometry::Detector(name, detIds[i], parent);
+    const Eigen::Vector3d relativeOffset = relativeOffsets.col(static_cast<Eigen::Index>(i));
+    detector->translate(Mantid::Kernel::toV3D(relativeOffset));
+    detector->setShape(shape);
+    m_lastBank->add(detector);
+    m_instrument->markAsDetectorIncomplete(detector);
+  }
+}
+
 /// Adds detector to instrument
 void InstrumentBuilder::addDetectorToInstrument(const std::string &detName, detid_t detId,
                                                 const Eigen::Vector3d &position,
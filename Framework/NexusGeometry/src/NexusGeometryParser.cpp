@@ -10,6 +10,7 @@
 #include "MantidGeometry/Rendering/GeometryHandler.h"
 #include "MantidGeometry/Rendering/ShapeInfo.h"
 #include "MantidKernel/ChecksumHelper.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidNexusGeometry/AbstractLogger.h"
 #include "MantidNexusGeometry/H5ForwardCompatibility.h"
 #include "MantidNexusGeometry/Hdf5Version.h"
@@ -21,11 +22,16 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 #include <H5Cpp.h>
+#include <algorithm>
+#include <boost/functional/hash.hpp>
 #include <boost/regex.hpp>
+#include <cmath>
+#include <exception>
 #include <numeric>
 #include <sstream>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 
 namespace Mantid::NexusGeometry {
 using namespace H5;
@@ -86,6 +92,56 @@ template <typename ValueType> std::vector<ValueType> extractVector(const DataSet
   return values;
 }
 
+/// Grid spacing (m) that the vertices of pixel shapes are rounded to
+constexpr double PIXEL_VERTEX_GRID = 1e-9;
+
+/**
+ * Round a vertex coordinate to the nearest multiple of PIXEL_VERTEX_GRID.
+ * Coordinates that round to the same value differ by less than 1 nm, but two
+ * coordinates less than 1 nm apart can still round to neighbouring values if
+ * they straddle a half-nanometre boundary. Such pixels get separate shapes,
+ * which is wasteful but never wrong.
+ */
+int64_t quantiseCoordinate(const double coordinate) { return std::llround(coordinate / PIXEL_VERTEX_GRID); }
+
+/**
+ * Hash the mesh of a pixel moved to the origin. The face indices are hashed
+ * relative to the first, as only their differences determine the triangles.
+ */
+size_t hashPixelMesh(const std::vector<Eigen::Vector3d> &vertices, const std::vector<uint32_t> &faceIndices,
+                     const std::vector<uint32_t> &windingOrder) {
+  size_t seed = 0;
+  for (const auto &vertex : vertices) {
+    boost::hash_combine(seed, quantiseCoordinate(vertex[0]));
+    boost::hash_combine(seed, quantiseCoordinate(vertex[1]));
+    boost::hash_combine(seed, quantiseCoordinate(vertex[2]));
+  }
+  for (const auto faceIndex : faceIndices)
+    boost::hash_combine(seed, faceIndex - faceIndices.front());
+  boost::hash_range(seed, windingOrder.cbegin(), windingOrder.cend());
+  return seed;
+}
+
+/// Whether the meshes of two pixels moved to the origin give the same shape
+bool samePixelMesh(const std::vector<Eigen::Vector3d> &vertices1, const std::vector<uint32_t> &faceIndices1,
+                   const std::vector<uint32_t> &windingOrder1, const std::vector<Eigen::Vector3d> &vertices2,
+                   const std::vector<uint32_t> &faceIndices2, const std::vector<uint32_t> &windingOrder2) {
+  if (vertices1.size() != vertices2.size() || faceIndices1.size() != faceIndices2.size() ||
+      windingOrder1 != windingOrder2)
+    return false;
+  for (size_t i = 0; i < faceIndices1.size(); ++i) {
+    if (faceIndices1[i] - faceIndices1.front() != faceIndices2[i] - faceIndices2.front())
+      return false;
+  }
+  for (size_t i = 0; i < vertices1.size(); ++i) {
+    for (int j = 0; j < 3; ++j) {
+      if (quantiseCoordinate(vertices1[i][j]) != quantiseCoordinate(vertices2[i][j]))
+        return false;
+    }
+  }
+  return true;
+}
+
 /**
  * Parser as local class. Makes logging (side-effect) easier.
  */
@@ -585,10 +641,11 @@ private:
       calculatePixelCentre = false;
     }
 
-    for (size_t i = 0; i < numDets; ++i) {
+    std::vector<Eigen::Vector3d> centres(numDets);
+    std::vector<size_t> hashes(numDets);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t i = 0; i < static_cast<int64_t>(numDets); ++i) {
       auto &detVerts = detFaceVerts[i];
-      const auto &singleDetIndices = detFaceIndices[i];
-      const auto &detWinding = detWindingOrder[i];
 
       Eigen::Vector3d centre;
       if (calculatePixelCentre) {
@@ -603,9 +660,53 @@ private:
 
       // translate shape to origin for shape coordinates
       std::for_each(detVerts.begin(), detVerts.end(), [&centre](Eigen::Vector3d &val) { val -= centre; });
+      centres[i] = centre;
+      hashes[i] = hashPixelMesh(detVerts, detFaceIndices[i], detWindingOrder[i]);
+    }
+
+    // Pixels of the same shape have the same vertices once moved to the
+    // origin, so only one shape is created for each distinct mesh. Vertices
+    // match when their coordinates round to the same nanometre (see
+    // quantiseCoordinate)
+    std::vector<size_t> shapeIndices(numDets);
+    std::vector<size_t> firstPixelOfShape;
+    std::unordered_multimap<size_t, size_t> shapesByHash;
+    for (size_t i = 0; i < numDets; ++i) {
+      const auto candidates = shapesByHash.equal_range(hashes[i]);
+      const auto match = std::find_if(candidates.first, candidates.second, [&](const auto &candidate) {
+        const auto j = firstPixelOfShape[candidate.second];
+        return samePixelMesh(detFaceVerts[i], detFaceIndices[i], detWindingOrder[i], detFaceVerts[j],
+                             detFaceIndices[j], detWindingOrder[j]);
+      });
+      if (match != candidates.second) {
+        shapeIndices[i] = match->second;
+      } else {
+        shapeIndices[i] = firstPixelOfShape.size();
+        shapesByHash.emplace(hashes[i], firstPixelOfShape.size());
+        firstPixelOfShape.emplace_back(i);
+      }
+    }
 
-      auto shape = NexusShapeFactory::createFromOFFMesh(singleDetIndices, detWinding, detVerts);
-      builder.addDetectorToLastBank(name + "_" + std::to_string(i), detIds[i], centre, std::move(shape));
+    std::vector<std::shared_ptr<const Geometry::IObject>> shapes(firstPixelOfShape.size());
+    std::exception_ptr shapeError;
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int64_t s = 0; s < static_cast<int64_t>(shapes.size()); ++s) {
+      const auto i = firstPixelOfShape[s];
+      try {
+        shapes[s] = NexusShapeFactory::createFromOFFMesh(detFaceIndices[i], detWindingOrder[i], detFaceVerts[i]);
+      } catch (...) {
+        PARALLEL_CRITICAL(nexus_pixel_shapes) {
+          if (!shapeError)
+            shapeError = std::current_exception();
+        }
+      }
+    }
+    if (shapeError)
+      std::rethrow_exception(shapeError);
+
+    // The instrument is not thread safe so the detectors are added serially
+    for (size_t i = 0; i < numDets; ++i) {
+      builder.addDetectorToLastBank(name + "_" + std::to_string(i), detIds[i], centres[i], shapes[shapeIndices[i]]);
     }
   }
 
@@ -783,13 +884,7 @@ public:
         // in tube formation, so must continue to process non-tube detectors
         detectorIds = TubeHelpers::notInTubes(tubes, detectorIds);
       }
-      for (size_t i = 0; i < detectorIds.size(); ++i) {
-        auto index = static_cast<int>(i);
-        std::string name = bankName + "_" + std::to_string(index);
-
-        const Eigen::Vector3d &relativePos = detectorPixels.col(index);
-        builder.addDetectorToLastBank(name, detectorIds[index], relativePos, detShape);
-      }
+      builder.addDetectorsToLastBank(bankName, detectorIds, detectorPixels, detShape);
     }
     // Sort the detectors
     // Parse source and sample and add to instrument
@@ -54,6 +54,35 @@ public:
     TS_ASSERT_EQUALS(iDetInfo->position(1), this->testPos1);
   }
 
+  void testAddDetectorsToLastBank() {
+    InstrumentBuilder builder(this->iTestName);
+    builder.addSample("sample", {0, 0, 0});
+    builder.addSource("source", {-10, 0, 0});
+    builder.addBank("bank", this->testPos1, Eigen::Quaterniond::Identity());
+    Eigen::Matrix<double, 3, Eigen::Dynamic> offsets(3, 2);
+    offsets.col(0) = this->testPos2;
+    offsets.col(1) = Eigen::Vector3d(0.1, 0.2, 0.3);
+    builder.addDetectorsToLastBank("bank", {5, 3}, offsets, this->shape);
+    auto iVisitor = Geometry::InstrumentVisitor(builder.createInstrument());
+    iVisitor.walkInstrument();
+    auto iDetInfo = iVisitor.detectorInfo();
+    auto iCompInfo = iVisitor.componentInfo();
+    TS_ASSERT_EQUALS(iDetInfo->size(), 2);
+    // detectors are sorted by ID
+    TS_ASSERT(iDetInfo->position(0).isApprox(this->testPos1 + Eigen::Vector3d(0.1, 0.2, 0.3)));
+    TS_ASSERT(iDetInfo->position(1).isApprox(this->testPos1 + this->testPos2));
+    TS_ASSERT_EQUALS(iCompInfo->name(0), "bank_1");
+    TS_ASSERT_EQUALS(iCompInfo->name(1), "bank_0");
+  }
+
+  void testAddDetectorsToLastBank_throws_without_offsets() {
+    InstrumentBuilder builder(this->iTestName);
+    builder.addBank("bank", this->testPos1, Eigen::Quaterniond::Identity());
+    Eigen::Matrix<double, 3, Eigen::Dynamic> offsets(3, 1);
+    offsets.col(0) = this->testPos2;
+    TS_ASSERT_THROWS(builder.addDetectorsToLastBank("bank", {1, 2}, offsets, this->shape), const std::runtime_error &);
+  }
+
   void testAddSample_and_testAddSource() {
     InstrumentBuilder builder(this->iTestName);
     TS_ASSERT_THROWS_NOTHING(builder.addSample(this->sampleName, this->testPos1));
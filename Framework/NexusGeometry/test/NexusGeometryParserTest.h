@@ -8,21 +8,27 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "MantidFrameworkTestHelpers/ComponentCreationHelper.h"
+#include "MantidFrameworkTestHelpers/FileResource.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidGeometry/Instrument/ComponentInfo.h"
 #include "MantidGeometry/Instrument/DetectorInfo.h"
+#include "MantidGeometry/Instrument/InstrumentVisitor.h"
 #include "MantidGeometry/Objects/CSGObject.h"
 #include "MantidGeometry/Objects/MeshObject.h"
 #include "MantidGeometry/Objects/MeshObject2D.h"
 #include "MantidGeometry/Surfaces/Cylinder.h"
 #include "MantidKernel/ConfigService.h"
 #include "MantidKernel/EigenConversionHelpers.h"
+#include "MantidNexusGeometry/NexusGeometryDefinitions.h"
 #include "MantidNexusGeometry/NexusGeometryParser.h"
+#include "MantidNexusGeometry/NexusGeometrySave.h"
 
 #include "mockobjects.h"
 #include <H5Cpp.h>
 #include <Poco/Glob.h>
 #include <chrono>
+#include <filesystem>
 #include <gmock/gmock.h>
 #include <string>
 
@@ -245,6 +251,35 @@ public:
     TS_ASSERT_EQUALS(shape2Mesh->numberOfVertices(), 3);
   }
 
+  void test_detector_shape_as_mesh_shares_identical_pixels() {
+    // Rewrite the mesh of DETGEOM_example_3 so that pixels 0 and 1 are the
+    // same triangle at different positions, while pixels 2 and 3 differ
+    FileResource fileResource("detector_shape_shared_pixels.nxs");
+    std::filesystem::copy_file(instrument_path("unit_testing/DETGEOM_example_3.nxs"), fileResource.fullPath(),
+                               std::filesystem::copy_options::overwrite_existing);
+    {
+      const std::vector<float> vertices{0, 0, 0, 1, 0, 0, 0, 1, 0, 2, 0, 0, 3, 0, 0, 2, 1, 0};
+      // Pixel i is described by face 4 + i
+      const std::vector<int32_t> windingOrder{0, 1, 2, 3, 4, 5, 0, 1, 5, 1, 3, 5, 0, 1, 2, 3, 4, 5, 0, 1, 5, 1, 3, 5};
+      H5::H5File file(fileResource.fullPath(), H5F_ACC_RDWR);
+      const std::string shapePath = "/raw_data_1/instrument/detector_3/detector_shape/";
+      file.openDataSet(shapePath + "vertices").write(vertices.data(), H5::PredType::NATIVE_FLOAT);
+      file.openDataSet(shapePath + "winding_order").write(windingOrder.data(), H5::PredType::NATIVE_INT32);
+    }
+    auto instrument = NexusGeometryParser::createInstrument(fileResource.fullPath(),
+                                                            std::make_unique<testing::NiceMock<MockLogger>>());
+    auto beamline = extractBeamline(*instrument);
+    auto &compInfo = *beamline.first;
+    auto &detInfo = *beamline.second;
+    ETS_ASSERT_EQUALS(detInfo.size(), 4);
+
+    TSM_ASSERT_EQUALS("Identical pixels, same address", &compInfo.shape(0), &compInfo.shape(1));
+    TSM_ASSERT_DIFFERS("Different meshes, different addresses", &compInfo.shape(0), &compInfo.shape(2));
+    TSM_ASSERT_DIFFERS("Different meshes, different addresses", &compInfo.shape(0), &compInfo.shape(3));
+    TSM_ASSERT_DIFFERS("Different meshes, different addresses", &compInfo.shape(2), &compInfo.shape(3));
+    TS_ASSERT(Kernel::toVector3d(compInfo.position(1) - compInfo.position(0)).isApprox(Eigen::Vector3d(2.0, 0.0, 0.0)));
+  }
+
   void test_detector_shape_as_cylinders() {
     auto instrument = NexusGeometryParser::createInstrument(instrument_path("unit_testing/DETGEOM_example_4.nxs"),
                                                             std::make_unique<testing::NiceMock<MockLogger>>());
@@ -397,6 +432,28 @@ public:
     TS_ASSERT(match);
   }
 
+  void test_load_synthetic_5M_pixels() {
+    // 20 banks of 500 x 500 pixels
+    constexpr int nBanks = 20;
+    constexpr int nPixels = 500;
+    FileResource fileResource("synthetic_5M_pixels_geometry.hdf5");
+    {
+      auto instrument = ComponentCreationHelper::createTestInstrumentRectangular2(nBanks, nPixels);
+      auto wrappers = Geometry::InstrumentVisitor::makeWrappers(*instrument);
+      testing::NiceMock<MockLogger> logger;
+      NexusGeometrySave::saveInstrument(wrappers, fileResource.fullPath(), DEFAULT_ROOT_ENTRY_NAME, logger);
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    const auto filename = fileResource.fullPath();
+    auto syntheticInstrument =
+        NexusGeometryParser::createInstrument(filename, std::make_unique<testing::NiceMock<MockLogger>>());
+    auto stop = std::chrono::high_resolution_clock::now();
+    std::cout << "Creating synthetic 5M pixel instrument took: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count() << " ms" << std::endl;
+    auto detInfo = extractDetectorInfo(*syntheticInstrument);
+    TS_ASSERT_EQUALS(detInfo->size(), nBanks * nPixels * nPixels); // Sanity check
+  }
+
 private:
   std::string m_wishHDF5DefinitionPath;
   std::string m_sans2dHDF5DefinitionPath;